@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -17,6 +18,7 @@
 
 #include "common/Assertions.h"
 #include "common/Console.h"
+#include "common/Timer.h"
 #include "common/CrashHandler.h"
 #include "common/FileSystem.h"
 #include "common/MemorySettingsInterface.h"
@@ -53,6 +55,9 @@ namespace GSRunner
 	static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& params);
 	static void DumpStats();
 
+	static void RecordBenchmarkFrame();
+	static void WriteBenchmarkResults(const std::string& dump_filename);
+
 	static bool CreatePlatformWindow();
 	static void DestroyPlatformWindow();
 	static std::optional<WindowInfo> GetPlatformWindowInfo();
@@ -89,6 +94,28 @@ static u64 s_total_readbacks = 0;
 static u32 s_total_frames = 0;
 static u32 s_total_drawn_frames = 0;
 
+// Owned by the CPU thread.
+static double s_elapsed_time = 0;
+
+struct BenchmarkFrame
+{
+	double time; // in milliseconds
+	u64 draws;
+	u64 draw_calls;
+	u64 texture_uploads;
+	u64 readbacks;
+	u64 pixels;
+};
+
+static s32 s_benchmark_loops = 0;
+static s32 s_benchmark_warmup_loops = 1;
+static std::string s_benchmark_output;
+
+// Owned by the GS thread.
+static std::vector<BenchmarkFrame> s_benchmark_frames;
+static double s_benchmark_last_counters[GSPerfMon::CounterLast] = {};
+static Common::Timer::Value s_benchmark_last_time = 0;
+
 bool GSRunner::InitializeConfig()
 {
 	EmuFolders::SetAppRoot();
@@ -274,11 +301,14 @@ void Host::BeginPresentFrame()
 
 		if (!idle_frame)
 			s_total_drawn_frames++;
+	}
 
-		s_total_frames++;
+	if (s_benchmark_loops > 0)
+		GSRunner::RecordBenchmarkFrame();
 
-		std::atomic_thread_fence(std::memory_order_release);
-	}
+	s_total_frames++;
+
+	std::atomic_thread_fence(std::memory_order_release);
 }
 
 void Host::RequestResizeHostDisplay(s32 width, s32 height)
@@ -445,6 +475,13 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -dumpdir <dir>: Frame dump directory (will be dumped as filename_frameN.png).\n");
 	std::fprintf(stderr, "  -loop <count>: Loops dump playback N times. Defaults to 1. 0 will loop infinitely.\n");
 	std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Defaults to Auto.\n");
+	std::fprintf(stderr, "    'headless' runs the hardware renderer against system memory textures without a GPU.\n");
+	std::fprintf(stderr, "  -swthreads <count>: Sets the number of software rendering threads.\n");
+	std::fprintf(stderr, "  -swscheduler <bands|tiles>: Sets how software rendering work is split between threads.\n");
+	std::fprintf(stderr, "  -swsetup <serial|parallel>: Sets whether large software draws are set up on several threads.\n");
+	std::fprintf(stderr, "  -benchmark <count>: Records per-frame timings over N loops of the dump, after warming up.\n");
+	std::fprintf(stderr, "  -benchmarkwarmup <count>: Loops to play before recording timings. Defaults to 1.\n");
+	std::fprintf(stderr, "  -benchmarkout <filename>: Writes benchmark results to filename (.json or .csv).\n");
 	std::fprintf(stderr, "  -window: Forces a window to be displayed.\n");
 	std::fprintf(stderr, "  -surfaceless: Disables showing a window.\n");
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
@@ -533,6 +570,8 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 #endif
 				else if (StringUtil::Strcasecmp(rname, "sw") == 0)
 					type = GSRendererType::SW;
+				else if (StringUtil::Strcasecmp(rname, "headless") == 0)
+					type = GSRendererType::Headless;
 				else
 				{
 					Console.Error("Unknown renderer '%s'", rname);
@@ -543,6 +582,90 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 				s_settings_interface.SetIntValue("EmuCore/GS", "Renderer", static_cast<int>(type));
 				continue;
 			}
+			else if (CHECK_ARG_PARAM("-swthreads"))
+			{
+				const std::optional<s32> threads = StringUtil::FromChars<s32>(argv[++i]);
+				if (!threads.has_value() || threads.value() < 0)
+				{
+					Console.Error("Invalid software rendering thread count");
+					return false;
+				}
+
+				Console.WriteLn("Using %d software rendering threads.", threads.value());
+				s_settings_interface.SetIntValue("EmuCore/GS", "extrathreads", threads.value());
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-swscheduler"))
+			{
+				const char* sname = argv[++i];
+
+				bool tiles;
+				if (StringUtil::Strcasecmp(sname, "bands") == 0)
+					tiles = false;
+				else if (StringUtil::Strcasecmp(sname, "tiles") == 0)
+					tiles = true;
+				else
+				{
+					Console.Error("Unknown software rendering scheduler '%s'", sname);
+					return false;
+				}
+
+				Console.WriteLn("Using %s software rendering scheduler.", sname);
+				s_settings_interface.SetBoolValue("EmuCore/GS", "sw_tile_scheduling", tiles);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-swsetup"))
+			{
+				const char* sname = argv[++i];
+
+				bool parallel;
+				if (StringUtil::Strcasecmp(sname, "serial") == 0)
+					parallel = false;
+				else if (StringUtil::Strcasecmp(sname, "parallel") == 0)
+					parallel = true;
+				else
+				{
+					Console.Error("Unknown software draw setup mode '%s'", sname);
+					return false;
+				}
+
+				Console.WriteLn("Using %s software draw setup.", sname);
+				s_settings_interface.SetBoolValue("EmuCore/GS", "sw_parallel_draw_setup", parallel);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-benchmark"))
+			{
+				s_benchmark_loops = StringUtil::FromChars<s32>(argv[++i]).value_or(0);
+				if (s_benchmark_loops <= 0)
+				{
+					Console.Error("Invalid benchmark loop count");
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-benchmarkwarmup"))
+			{
+				s_benchmark_warmup_loops = StringUtil::FromChars<s32>(argv[++i]).value_or(-1);
+				if (s_benchmark_warmup_loops < 0)
+				{
+					Console.Error("Invalid benchmark warm-up loop count");
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-benchmarkout"))
+			{
+				s_benchmark_output = StringUtil::StripWhitespace(argv[++i]);
+				if (!StringUtil::EndsWithNoCase(s_benchmark_output, ".json") && !StringUtil::EndsWithNoCase(s_benchmark_output, ".csv"))
+				{
+					Console.Error("Benchmark output filename must end in .json or .csv");
+					return false;
+				}
+
+				continue;
+			}
 			else if (CHECK_ARG_PARAM("-renderhacks"))
 			{
 				std::string str(argv[++i]);
@@ -643,6 +766,28 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 		return false;
 	}
 
+	if (s_benchmark_loops > 0)
+	{
+		// Frame dumping and the OSD would both skew the timings.
+		if (!s_output_prefix.empty())
+		{
+			Console.Error("Frame dumping can't be used with benchmark mode.");
+			return false;
+		}
+
+		s_loop_count = s_benchmark_warmup_loops + s_benchmark_loops;
+		s_loop_number = static_cast<u32>(s_loop_count);
+		s_settings_interface.SetBoolValue("EmuCore/GS", "OsdShowFPS", false);
+		s_settings_interface.SetBoolValue("EmuCore/GS", "OsdShowResolution", false);
+		s_settings_interface.SetBoolValue("EmuCore/GS", "OsdShowGSStats", false);
+		Console.WriteLn("Benchmarking %d loops after %d warm-up loops.", s_benchmark_loops, s_benchmark_warmup_loops);
+	}
+	else if (!s_benchmark_output.empty())
+	{
+		Console.Error("Benchmark output requires -benchmark.");
+		return false;
+	}
+
 	// set up the frame dump directory
 	if (!s_output_prefix.empty())
 	{
@@ -668,9 +813,170 @@ void GSRunner::DumpStats()
 	Console.WriteLn(fmt::format("@HWSTAT@ Copies: {} (avg {})", s_total_copies, static_cast<u64>(std::ceil(s_total_copies / static_cast<double>(s_total_drawn_frames)))));
 	Console.WriteLn(fmt::format("@HWSTAT@ Uploads: {} (avg {})", s_total_uploads, static_cast<u64>(std::ceil(s_total_uploads / static_cast<double>(s_total_drawn_frames)))));
 	Console.WriteLn(fmt::format("@HWSTAT@ Readbacks: {} (avg {})", s_total_readbacks, static_cast<u64>(std::ceil(s_total_readbacks / static_cast<double>(s_total_drawn_frames)))));
+	Console.WriteLn(fmt::format("@HWSTAT@ Elapsed Time: {:.2f} ms ({:.2f} FPS)", s_elapsed_time, (s_elapsed_time > 0) ? (s_total_frames * 1000.0 / s_elapsed_time) : 0.0));
 	Console.WriteLn("============================================");
 }
 
+void GSRunner::RecordBenchmarkFrame()
+{
+	const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
+	const Common::Timer::Value last_time = std::exchange(s_benchmark_last_time, current_time);
+
+	static constexpr auto update_stat = [](GSPerfMon::counter_t counter) {
+		// perfmon resets every 30 frames to zero
+		const double val = g_perfmon.GetCounter(counter);
+		const double last = std::exchange(s_benchmark_last_counters[counter], val);
+		return static_cast<u64>((val < last) ? val : (val - last));
+	};
+
+	// TextureUploads and TextureCopies share counters with the SW renderer's stats.
+	const bool hw = GSIsHardwareRenderer();
+	BenchmarkFrame frame;
+	frame.draws = update_stat(GSPerfMon::Draw);
+	frame.draw_calls = update_stat(GSPerfMon::DrawCalls);
+	frame.texture_uploads = hw ? update_stat(GSPerfMon::TextureUploads) : 0;
+	frame.readbacks = update_stat(GSPerfMon::Readbacks);
+	frame.pixels = hw ? 0 : update_stat(GSPerfMon::Fillrate);
+
+	// Nothing to measure the first frame against, and skip the warm-up loops.
+	if (last_time == 0 || s_loop_number >= static_cast<u32>(s_benchmark_loops))
+		return;
+
+	frame.time = Common::Timer::ConvertValueToMilliseconds(current_time - last_time);
+	s_benchmark_frames.push_back(frame);
+}
+
+void GSRunner::WriteBenchmarkResults(const std::string& dump_filename)
+{
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (s_benchmark_frames.empty())
+	{
+		Console.Error("No frames were recorded for the benchmark.");
+		return;
+	}
+
+	struct Metric
+	{
+		const char* name;
+		double BenchmarkFrame::*time;
+		u64 BenchmarkFrame::*counter;
+	};
+	static constexpr Metric metrics[] = {
+		{"frame_time_ms", &BenchmarkFrame::time, nullptr},
+		{"draws", nullptr, &BenchmarkFrame::draws},
+		{"draw_calls", nullptr, &BenchmarkFrame::draw_calls},
+		{"texture_uploads", nullptr, &BenchmarkFrame::texture_uploads},
+		{"readbacks", nullptr, &BenchmarkFrame::readbacks},
+		{"pixels", nullptr, &BenchmarkFrame::pixels},
+	};
+
+	struct Summary
+	{
+		double min, mean, p50, p95, p99, max;
+	};
+	std::vector<Summary> summaries;
+	std::vector<double> values(s_benchmark_frames.size());
+	for (const Metric& metric : metrics)
+	{
+		for (size_t i = 0; i < s_benchmark_frames.size(); i++)
+		{
+			const BenchmarkFrame& frame = s_benchmark_frames[i];
+			values[i] = metric.time ? frame.*metric.time : static_cast<double>(frame.*metric.counter);
+		}
+		std::sort(values.begin(), values.end());
+
+		// Nearest-rank percentiles.
+		const auto percentile = [&values](double p) {
+			const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(values.size())));
+			return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+		};
+
+		double sum = 0.0;
+		for (const double value : values)
+			sum += value;
+
+		summaries.push_back(Summary{values.front(), sum / static_cast<double>(values.size()), percentile(50.0),
+			percentile(95.0), percentile(99.0), values.back()});
+	}
+
+	Console.WriteLn(fmt::format("======= BENCHMARK RESULTS FOR {} FRAMES ========", s_benchmark_frames.size()));
+	for (size_t i = 0; i < std::size(metrics); i++)
+	{
+		const Summary& s = summaries[i];
+		Console.WriteLn(fmt::format("@BENCH@ {}: min {:.3f} mean {:.3f} p50 {:.3f} p95 {:.3f} p99 {:.3f} max {:.3f}",
+			metrics[i].name, s.min, s.mean, s.p50, s.p95, s.p99, s.max));
+	}
+	Console.WriteLn("============================================");
+
+	if (s_benchmark_output.empty())
+		return;
+
+	std::string frames;
+	std::string summary;
+	if (StringUtil::EndsWithNoCase(s_benchmark_output, ".csv"))
+	{
+		// Per-frame data goes in the requested file, the statistics next to it.
+		frames = "frame,frame_time_ms,draws,draw_calls,texture_uploads,readbacks,pixels\n";
+		for (size_t i = 0; i < s_benchmark_frames.size(); i++)
+		{
+			const BenchmarkFrame& f = s_benchmark_frames[i];
+			fmt::format_to(std::back_inserter(frames), "{},{:.4f},{},{},{},{},{}\n", i, f.time, f.draws, f.draw_calls,
+				f.texture_uploads, f.readbacks, f.pixels);
+		}
+
+		summary = "metric,min,mean,p50,p95,p99,max\n";
+		for (size_t i = 0; i < std::size(metrics); i++)
+		{
+			const Summary& s = summaries[i];
+			fmt::format_to(std::back_inserter(summary), "{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f}\n", metrics[i].name,
+				s.min, s.mean, s.p50, s.p95, s.p99, s.max);
+		}
+
+		const std::string summary_path = Path::ReplaceExtension(s_benchmark_output, "summary.csv");
+		if (!FileSystem::WriteStringToFile(summary_path.c_str(), summary))
+			Console.Error(fmt::format("Failed to write benchmark summary to {}", summary_path));
+	}
+	else
+	{
+		std::string escaped_filename;
+		for (const char ch : dump_filename)
+		{
+			if (ch == '"' || ch == '\\')
+				escaped_filename += '\\';
+			escaped_filename += ch;
+		}
+
+		frames = fmt::format("{{\n  \"dump\": \"{}\",\n  \"renderer\": \"{}\",\n  \"version\": \"{}\",\n"
+							 "  \"warmup_loops\": {},\n  \"loops\": {},\n  \"summary\": {{\n",
+			escaped_filename, Pcsx2Config::GSOptions::GetRendererName(GSConfig.Renderer), GIT_REV, s_benchmark_warmup_loops,
+			s_benchmark_loops);
+		for (size_t i = 0; i < std::size(metrics); i++)
+		{
+			const Summary& s = summaries[i];
+			fmt::format_to(std::back_inserter(frames),
+				"    \"{}\": {{\"min\": {:.4f}, \"mean\": {:.4f}, \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}, \"max\": {:.4f}}}{}\n",
+				metrics[i].name, s.min, s.mean, s.p50, s.p95, s.p99, s.max, (i + 1) < std::size(metrics) ? "," : "");
+		}
+
+		frames += "  },\n  \"frames\": [\n";
+		for (size_t i = 0; i < s_benchmark_frames.size(); i++)
+		{
+			const BenchmarkFrame& f = s_benchmark_frames[i];
+			fmt::format_to(std::back_inserter(frames),
+				"    {{\"frame_time_ms\": {:.4f}, \"draws\": {}, \"draw_calls\": {}, \"texture_uploads\": {}, "
+				"\"readbacks\": {}, \"pixels\": {}}}{}\n",
+				f.time, f.draws, f.draw_calls, f.texture_uploads, f.readbacks, f.pixels,
+				(i + 1) < s_benchmark_frames.size() ? "," : "");
+		}
+		frames += "  ]\n}\n";
+	}
+
+	if (!FileSystem::WriteStringToFile(s_benchmark_output.c_str(), frames))
+		Console.Error(fmt::format("Failed to write benchmark results to {}", s_benchmark_output));
+	else
+		Console.WriteLn(fmt::format("Wrote benchmark results to {}", s_benchmark_output));
+}
+
 #ifdef _WIN32
 // We can't handle unicode in filenames if we don't use wmain on Win32.
 #define main real_main
@@ -709,10 +1015,15 @@ int main(int argc, char* argv[])
 		// run until end
 		GSDumpReplayer::SetLoopCount(s_loop_count);
 		VMManager::SetState(VMState::Running);
+		Common::Timer timer;
 		while (VMManager::GetState() == VMState::Running)
 			VMManager::Execute();
+		MTGS::WaitGS(false, false, false);
+		s_elapsed_time = timer.GetTimeMilliseconds();
 		VMManager::Shutdown(false);
 		GSRunner::DumpStats();
+		if (s_benchmark_loops > 0)
+			GSRunner::WriteBenchmarkResults(params.filename);
 	}
 
 	VMManager::Internal::CPUThreadShutdown();
@@ -0,0 +1,100 @@
+import argparse
+import glob
+import sys
+import os
+import re
+import subprocess
+
+ELAPSED_RE = re.compile(r"@HWSTAT@ Elapsed Time: ([0-9.]+) ms \(([0-9.]+) FPS\)")
+
+
+def get_gs_name(path):
+    lpath = path.lower()
+
+    for extension in [".gs", ".gs.xz", ".gs.zst"]:
+        if lpath.endswith(extension):
+            return os.path.basename(path)[:-len(extension)]
+
+    return None
+
+
+# Runner option and the two modes to compare, for each -compare choice.
+COMPARISONS = {
+    "scheduler": ("-swscheduler", "bands", "tiles"),
+    "setup": ("-swsetup", "serial", "parallel"),
+}
+
+
+def run_benchmark(runner, gspath, option, mode, threads, loops):
+    args = [runner]
+    args.extend(["-renderer", "sw"])
+    args.extend(["-swthreads", str(threads)])
+    args.extend([option, mode])
+    args.extend(["-loop", str(loops)])
+    args.append("-surfaceless")
+    args.append("--")
+    args.append(gspath)
+
+    result = subprocess.run(args, stdin=subprocess.DEVNULL, stderr=subprocess.STDOUT, stdout=subprocess.PIPE, text=True,
+                            errors="replace")
+    match = ELAPSED_RE.search(result.stdout)
+    if match is None:
+        return None
+
+    return float(match.group(1))
+
+
+def run_benchmarks(runner, gsdir, compare, threads, loops, runs):
+    paths = glob.glob(gsdir + "/*.*", recursive=True)
+    gamepaths = sorted(filter(lambda x: get_gs_name(x) is not None, paths))
+    option, base, test = COMPARISONS[compare]
+
+    print("Found %u GS dumps" % len(gamepaths))
+    print("%-40s %8s %12s %12s %8s" % ("Dump", "Threads", base.capitalize() + " (ms)", test.capitalize() + " (ms)",
+                                       "Speedup"))
+
+    totals = {base: 0.0, test: 0.0}
+    for game in gamepaths:
+        for thread_count in threads:
+            times = {}
+            for mode in [base, test]:
+                # Take the best of a few runs, to filter out noise from whatever else is running.
+                results = [run_benchmark(runner, game, option, mode, thread_count, loops) for _ in range(runs)]
+                results = [r for r in results if r is not None]
+                if not results:
+                    print("%-40s: failed to run with %s %s" % (get_gs_name(game), mode, compare))
+                    break
+
+                times[mode] = min(results)
+
+            if len(times) != 2:
+                continue
+
+            totals[base] += times[base]
+            totals[test] += times[test]
+            print("%-40s %8u %12.2f %12.2f %7.2fx" % (get_gs_name(game)[:40], thread_count, times[base], times[test],
+                                                    times[base] / times[test]))
+
+    if totals[test] > 0:
+        print("%-40s %8s %12.2f %12.2f %7.2fx" % ("Total", "", totals[base], totals[test], totals[base] / totals[test]))
+
+    return True
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Compare software renderer threading modes on GS dumps")
+    parser.add_argument("-runner", action="store", required=True, help="Path to PCSX2 GS runner")
+    parser.add_argument("-gsdir", action="store", required=True, help="Directory containing GS dumps")
+    parser.add_argument("-compare", action="store", choices=COMPARISONS.keys(), default="scheduler",
+                        help="Compare band/tile scheduling, or serial/parallel draw setup")
+    parser.add_argument("-threads", action="store", type=int, nargs="+", default=[4, 8, 16],
+                        help="Software rendering thread counts to test")
+    parser.add_argument("-loop", action="store", type=int, default=4, help="Number of times to loop each dump")
+    parser.add_argument("-runs", action="store", type=int, default=3, help="Number of runs to take the best time from")
+
+    args = parser.parse_args()
+
+    if not run_benchmarks(args.runner, os.path.realpath(args.gsdir), args.compare, args.threads, args.loop, args.runs):
+        sys.exit(1)
+    else:
+        sys.exit(0)
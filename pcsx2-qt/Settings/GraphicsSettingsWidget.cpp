@@ -219,6 +219,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
 	SettingWidgetBinder::BindWidgetToBoolSetting(
 		sif, m_ui.loadTextureReplacementsAsync, "EmuCore/GS", "LoadTextureReplacementsAsync", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.precacheTextureReplacements, "EmuCore/GS", "PrecacheTextureReplacements", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.textureDiskCache, "EmuCore/GS", "TextureDiskCache", false);
 	SettingWidgetBinder::BindWidgetToFolderSetting(sif, m_ui.texturesDirectory, m_ui.texturesBrowse, m_ui.texturesOpen, m_ui.texturesReset,
 		"Folders", "Textures", Path::Combine(EmuFolders::DataRoot, "textures"));
 	connect(m_ui.dumpReplaceableTextures, &QCheckBox::checkStateChanged, this, &GraphicsSettingsWidget::onTextureDumpChanged);
@@ -262,6 +263,8 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.swTextureFiltering, "EmuCore/GS", "filter", static_cast<int>(BiFiltering::PS2));
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.extraSWThreads, "EmuCore/GS", "extrathreads", 2);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.swAutoFlush, "EmuCore/GS", "autoflush_sw", true);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.swTileScheduling, "EmuCore/GS", "sw_tile_scheduling", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.swParallelDrawSetup, "EmuCore/GS", "sw_parallel_draw_setup", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.swMipmap, "EmuCore/GS", "mipmap", true);
 
 	//////////////////////////////////////////////////////////////////////////
@@ -571,6 +574,14 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
 
 		dialog->registerWidgetHelp(
 			m_ui.swMipmap, tr("Mipmapping"), tr("Checked"), tr("Enables mipmapping, which some games require to render correctly."));
+
+		dialog->registerWidgetHelp(m_ui.swTileScheduling, tr("Tile Scheduling"), tr("Unchecked"),
+			tr("Splits the screen into bands which idle threads can steal from busy ones, instead of giving each thread "
+			   "fixed scanlines. May scale better with many rendering threads, or when draws only cover part of the screen."));
+
+		dialog->registerWidgetHelp(m_ui.swParallelDrawSetup, tr("Parallel Draw Setup"), tr("Unchecked"),
+			tr("Converts the vertices of large draws on several threads, while the texture for the draw is being looked up. "
+			   "Can help games with huge particle effects when the main GS thread is the bottleneck."));
 	}
 
 	// Hardware Fixes tab
@@ -680,6 +691,8 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
 		dialog->registerWidgetHelp(m_ui.loadTextureReplacements, tr("Load Textures"), tr("Unchecked"), tr("Loads replacement textures where available and user-provided."));
 
 		dialog->registerWidgetHelp(m_ui.precacheTextureReplacements, tr("Precache Textures"), tr("Unchecked"), tr("Preloads all replacement textures to memory. Not necessary with asynchronous loading."));
+
+		dialog->registerWidgetHelp(m_ui.textureDiskCache, tr("Persistent Texture Cache"), tr("Unchecked"), tr("Keeps decoded textures in the cache directory between sessions, so they don't have to be decoded again the next time they are used. Requires full texture preloading."));
 	}
 
 	// Post Processing tab
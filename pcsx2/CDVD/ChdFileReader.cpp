@@ -11,6 +11,7 @@
 #include "common/ProgressCallback.h"
 #include "common/SmallString.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 #include "libchdr/chd.h"
 #include "fmt/format.h"
@@ -187,6 +188,8 @@ bool ChdFileReader::Open2(std::string filename, Error* error)
 		file_size = static_cast<u64>(chd_header->unitbytes) * chd_header->unitcount;
 	}
 
+	hunk_count = chd_header->totalhunks;
+	StartDecodeThreads();
 	return true;
 }
 
@@ -213,6 +216,8 @@ bool ChdFileReader::Precache2(ProgressCallback* progress, Error* error)
 		return false;
 	}
 
+	// The decode threads read through their own file handles, which would bypass the precached data.
+	StopDecodeThreads();
 	return true;
 }
 
@@ -237,7 +242,62 @@ int ChdFileReader::ReadChunk(void* dst, s64 chunkID)
 	if (chunkID < 0)
 		return -1;
 
-	chd_error error = chd_read(ChdFile, chunkID, dst);
+	const u32 hunk = static_cast<u32>(chunkID);
+	if (m_decode_threads.empty() || hunk >= hunk_count)
+		return ReadHunkDirect(dst, hunk);
+
+	std::unique_lock lock(m_hunk_mutex);
+
+	CachedHunk* ch;
+	if (const auto it = m_hunk_lookup.find(hunk); it != m_hunk_lookup.end())
+		ch = &m_hunk_cache[it->second];
+	else
+		ch = AllocateHunk(hunk, nullptr);
+
+	if (ch)
+		ch->last_used = ++m_hunk_clock;
+
+	UpdatePrefetch(hunk, ch);
+
+	if (!ch)
+	{
+		lock.unlock();
+		return ReadHunkDirect(dst, hunk);
+	}
+
+	if (ch->state == HunkState::Decoding)
+	{
+		m_hunk_ready_cv.wait(lock, [ch]() { return ch->state != HunkState::Decoding; });
+	}
+	else if (ch->state != HunkState::Ready)
+	{
+		// Nobody has picked this hunk up yet (or a prefetch failed), so decode it here instead of waiting in line.
+		if (ch->state == HunkState::Queued)
+			m_decode_queue.erase(std::find(m_decode_queue.begin(), m_decode_queue.end(), static_cast<u32>(ch - m_hunk_cache.data())));
+
+		ch->state = HunkState::Decoding;
+		lock.unlock();
+		const chd_error error = chd_read(ChdFile, hunk, ch->data.get());
+		lock.lock();
+		ch->state = (error == CHDERR_NONE) ? HunkState::Ready : HunkState::Failed;
+	}
+
+	if (ch->state != HunkState::Ready)
+	{
+		// Don't keep failed hunks around, the next read should try again.
+		m_hunk_lookup.erase(hunk);
+		ch->state = HunkState::Empty;
+		lock.unlock();
+		return ReadHunkDirect(dst, hunk);
+	}
+
+	std::memcpy(dst, ch->data.get(), hunk_size);
+	return hunk_size;
+}
+
+int ChdFileReader::ReadHunkDirect(void* dst, u32 hunk)
+{
+	chd_error error = chd_read(ChdFile, hunk, dst);
 	if (error != CHDERR_NONE)
 	{
 		Console.Error("CDVD: chd_read returned error: %s", chd_error_string(error));
@@ -247,8 +307,176 @@ int ChdFileReader::ReadChunk(void* dst, s64 chunkID)
 	return hunk_size;
 }
 
+ChdFileReader::CachedHunk* ChdFileReader::AllocateHunk(u32 hunk, const CachedHunk* pinned)
+{
+	CachedHunk* victim = nullptr;
+	for (CachedHunk& ch : m_hunk_cache)
+	{
+		if (&ch == pinned)
+			continue;
+
+		if (ch.state == HunkState::Empty)
+		{
+			victim = &ch;
+			break;
+		}
+
+		if ((ch.state == HunkState::Ready || ch.state == HunkState::Failed) && (!victim || ch.last_used < victim->last_used))
+			victim = &ch;
+	}
+	if (!victim)
+		return nullptr;
+
+	if (victim->state != HunkState::Empty)
+		m_hunk_lookup.erase(victim->index);
+	if (!victim->data)
+		victim->data = std::make_unique<u8[]>(hunk_size);
+
+	victim->index = hunk;
+	victim->state = HunkState::Empty;
+	victim->last_used = ++m_hunk_clock;
+	m_hunk_lookup.emplace(hunk, static_cast<u32>(victim - m_hunk_cache.data()));
+	return victim;
+}
+
+void ChdFileReader::UpdatePrefetch(u32 hunk, const CachedHunk* pinned)
+{
+	// Sequential reads double the window, anything else shuts it off until the stream settles again.
+	if (m_last_hunk >= 0 && hunk == static_cast<u64>(m_last_hunk) + 1)
+	{
+		m_prefetch_depth = std::min(std::max(m_prefetch_depth * 2, 2u), m_max_prefetch);
+	}
+	else if (static_cast<s64>(hunk) != m_last_hunk)
+	{
+		m_prefetch_depth = 0;
+
+		// Anything still waiting for a thread belongs to the old position.
+		std::erase_if(m_decode_queue, [this, pinned](u32 slot) {
+			CachedHunk& ch = m_hunk_cache[slot];
+			if (&ch == pinned)
+				return false;
+
+			m_hunk_lookup.erase(ch.index);
+			ch.state = HunkState::Empty;
+			return true;
+		});
+	}
+	m_last_hunk = hunk;
+
+	bool queued = false;
+	const u32 end = std::min(hunk + 1 + m_prefetch_depth, hunk_count);
+	for (u32 next = hunk + 1; next < end; next++)
+	{
+		if (m_hunk_lookup.contains(next))
+			continue;
+
+		CachedHunk* ch = AllocateHunk(next, pinned);
+		if (!ch)
+			break;
+
+		ch->state = HunkState::Queued;
+		m_decode_queue.push_back(static_cast<u32>(ch - m_hunk_cache.data()));
+		queued = true;
+	}
+
+	if (queued)
+		m_decode_cv.notify_all();
+}
+
+void ChdFileReader::DecodeThread(chd_file* chd)
+{
+	Threading::SetNameOfCurrentThread("CHD Decode");
+
+	std::unique_lock lock(m_hunk_mutex);
+	for (;;)
+	{
+		m_decode_cv.wait(lock, [this]() { return m_decode_quit || !m_decode_queue.empty(); });
+		if (m_decode_quit)
+			break;
+
+		CachedHunk& ch = m_hunk_cache[m_decode_queue.front()];
+		m_decode_queue.pop_front();
+		ch.state = HunkState::Decoding;
+
+		lock.unlock();
+		const chd_error error = chd_read(chd, ch.index, ch.data.get());
+		lock.lock();
+
+		if (error != CHDERR_NONE)
+			DevCon.Warning("CDVD: Prefetch of CHD hunk %u failed: %s", ch.index, chd_error_string(error));
+
+		ch.state = (error == CHDERR_NONE) ? HunkState::Ready : HunkState::Failed;
+		m_hunk_ready_cv.notify_all();
+	}
+}
+
+void ChdFileReader::StartDecodeThreads()
+{
+	// With only a couple of cores the decode threads just compete with the emulator, keep the old behaviour there.
+	const u32 num_cpus = std::thread::hardware_concurrency();
+	if (num_cpus <= 2)
+		return;
+
+	const u32 num_threads = std::clamp(num_cpus / 4, 1u, MAX_DECODE_THREADS);
+	for (u32 i = 0; i < num_threads; i++)
+	{
+		auto fp = FileSystem::OpenManagedSharedCFile(m_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite);
+		chd_file* chd = fp ? OpenCHD(m_filename, std::move(fp), nullptr, 0) : nullptr;
+		if (!chd)
+			break;
+
+		m_decode_chds.push_back(chd);
+	}
+
+	if (m_decode_chds.empty())
+	{
+		Console.Warning("CDVD: Failed to open CHD for decode threads, decompressing on the read thread.");
+		return;
+	}
+
+	const u32 num_hunks = std::clamp(HUNK_CACHE_BYTES / hunk_size, MIN_CACHED_HUNKS, MAX_CACHED_HUNKS);
+	m_hunk_cache.resize(num_hunks);
+	m_hunk_lookup.reserve(num_hunks);
+	m_max_prefetch = num_hunks / 4;
+	m_prefetch_depth = 0;
+	m_last_hunk = -1;
+	m_decode_quit = false;
+
+	for (chd_file* chd : m_decode_chds)
+		m_decode_threads.emplace_back(&ChdFileReader::DecodeThread, this, chd);
+
+	DevCon.WriteLn("CDVD: Decoding CHD with %zu threads, %u hunk cache (%u bytes per hunk).", m_decode_threads.size(), num_hunks,
+		hunk_size);
+}
+
+void ChdFileReader::StopDecodeThreads()
+{
+	{
+		std::unique_lock lock(m_hunk_mutex);
+		m_decode_quit = true;
+	}
+	m_decode_cv.notify_all();
+
+	for (std::thread& thread : m_decode_threads)
+		thread.join();
+	m_decode_threads.clear();
+
+	for (chd_file* chd : m_decode_chds)
+		chd_close(chd);
+	m_decode_chds.clear();
+
+	m_hunk_cache.clear();
+	m_hunk_lookup.clear();
+	m_decode_queue.clear();
+	m_max_prefetch = 0;
+	m_prefetch_depth = 0;
+	m_last_hunk = -1;
+}
+
 void ChdFileReader::Close2()
 {
+	StopDecodeThreads();
+
 	if (ChdFile)
 	{
 		chd_close(ChdFile);
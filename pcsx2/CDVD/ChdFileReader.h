@@ -3,6 +3,9 @@
 
 #pragma once
 #include "ThreadedFileReader.h"
+#include <deque>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 typedef struct _chd_file chd_file;
@@ -26,9 +29,60 @@ public:
 	uint GetBlockCount(void) const override;
 
 private:
+	/// Memory budget for decompressed hunks, shared between recently read and prefetched hunks.
+	static constexpr u32 HUNK_CACHE_BYTES = static_cast<u32>(_8mb);
+	static constexpr u32 MIN_CACHED_HUNKS = 16;
+	static constexpr u32 MAX_CACHED_HUNKS = 1024;
+	static constexpr u32 MAX_DECODE_THREADS = 4;
+
+	enum class HunkState : u8
+	{
+		Empty,
+		Queued,
+		Decoding,
+		Ready,
+		Failed,
+	};
+
+	struct CachedHunk
+	{
+		std::unique_ptr<u8[]> data;
+		u64 last_used = 0;
+		u32 index = 0;
+		HunkState state = HunkState::Empty;
+	};
+
 	bool ParseTOC(u64* out_frame_count);
 
+	void StartDecodeThreads();
+	void StopDecodeThreads();
+	void DecodeThread(chd_file* chd);
+
+	/// Picks a cache slot for the given hunk, evicting the least recently used decoded hunk if needed.
+	/// Returns nullptr if every slot is busy. Requires m_hunk_mutex.
+	CachedHunk* AllocateHunk(u32 hunk, const CachedHunk* pinned);
+	/// Queues decodes for the hunks following the one being read, and drops stale ones after a seek.
+	/// Requires m_hunk_mutex.
+	void UpdatePrefetch(u32 hunk, const CachedHunk* pinned);
+	int ReadHunkDirect(void* dst, u32 hunk);
+
 	chd_file* ChdFile = nullptr;
 	u64 file_size = 0;
 	u32 hunk_size = 0;
+	u32 hunk_count = 0;
+
+	/// Each decode thread owns a separate handle, libchdr keeps per-file decompression state.
+	std::vector<chd_file*> m_decode_chds;
+	std::vector<std::thread> m_decode_threads;
+	std::vector<CachedHunk> m_hunk_cache;
+	std::unordered_map<u32, u32> m_hunk_lookup;
+	std::deque<u32> m_decode_queue;
+	std::mutex m_hunk_mutex;
+	std::condition_variable m_decode_cv;
+	std::condition_variable m_hunk_ready_cv;
+	u64 m_hunk_clock = 0;
+	s64 m_last_hunk = -1;
+	u32 m_prefetch_depth = 0;
+	u32 m_max_prefetch = 0;
+	bool m_decode_quit = false;
 };
@@ -8,6 +8,7 @@
 #include "common/FileSystem.h"
 #include "common/Error.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 #include "fmt/format.h"
 #include "lz4.h"
@@ -143,19 +144,21 @@ bool CsoFileReader::ReadFileHeader(Error* error)
 bool CsoFileReader::InitializeBuffers(Error* error)
 {
 	// Round up, since part of a frame requires a full frame.
-	u32 numFrames = (u32)((m_totalSize + m_frameSize - 1) / m_frameSize);
+	m_numFrames = (u32)((m_totalSize + m_frameSize - 1) / m_frameSize);
+
+	m_minBatchFrames = std::max<u32>(MIN_BATCH_BYTES >> m_frameShift, 1);
+	m_maxBatchFrames = std::max<u32>(MAX_BATCH_BYTES >> m_frameShift, 1);
+	m_batchFrames = m_minBatchFrames;
+	m_batchStart = 0;
+	m_batchCount = 0;
 
 	// We might read a bit of alignment too, so be prepared.
-	if (m_frameSize + (1 << m_indexShift) < CSO_READ_BUFFER_SIZE)
-	{
-		m_readBuffer = std::make_unique<u8[]>(CSO_READ_BUFFER_SIZE);
-	}
-	else
-	{
-		m_readBuffer = std::make_unique<u8[]>(m_frameSize + (1 << m_indexShift));
-	}
+	m_readBufferSize = std::max<u32>(m_maxBatchFrames * (m_frameSize + (1 << m_indexShift)), CSO_READ_BUFFER_SIZE);
+	m_readBuffer = std::make_unique<u8[]>(m_readBufferSize);
+	m_batchBuffer = std::make_unique_for_overwrite<u8[]>(static_cast<size_t>(m_maxBatchFrames) << m_frameShift);
+	m_batchFrameBytes.resize(m_maxBatchFrames);
 
-	const u32 indexSize = numFrames + 1;
+	const u32 indexSize = m_numFrames + 1;
 	m_index = std::make_unique<u32[]>(indexSize);
 	if (fread(m_index.get(), sizeof(u32), indexSize, m_src) != indexSize)
 	{
@@ -173,13 +176,81 @@ bool CsoFileReader::InitializeBuffers(Error* error)
 		}
 	}
 
+	StartDecodeThreads();
 	return true;
 }
 
+void CsoFileReader::StartDecodeThreads()
+{
+	// With only a couple of cores the decode threads just compete with the emulator, so the read thread does it all.
+	const u32 num_cpus = std::thread::hardware_concurrency();
+	if (num_cpus <= 2 || m_maxBatchFrames == 1)
+		return;
+
+	const u32 num_threads = std::clamp(num_cpus / 4, 1u, MAX_DECODE_THREADS);
+	m_decodeStreams = std::make_unique<z_stream[]>(num_threads);
+	m_decodeQuit = false;
+
+	for (u32 i = 0; i < num_threads; i++)
+	{
+		if (!m_uselz4 && inflateInit2(&m_decodeStreams[i], -15) != Z_OK)
+			break;
+
+		m_decodeThreads.emplace_back(&CsoFileReader::DecodeThread, this, &m_decodeStreams[i], m_decodeGeneration);
+	}
+
+	DevCon.WriteLn("CSO: Decompressing with %zu additional threads, up to %u frames per read.", m_decodeThreads.size(),
+		m_maxBatchFrames);
+}
+
+void CsoFileReader::StopDecodeThreads()
+{
+	{
+		std::unique_lock lock(m_decodeMutex);
+		m_decodeQuit = true;
+	}
+	m_decodeCV.notify_all();
+
+	for (std::thread& thread : m_decodeThreads)
+		thread.join();
+
+	if (!m_uselz4)
+	{
+		for (size_t i = 0; i < m_decodeThreads.size(); i++)
+			inflateEnd(&m_decodeStreams[i]);
+	}
+
+	m_decodeThreads.clear();
+	m_decodeStreams.reset();
+}
+
+void CsoFileReader::DecodeThread(z_stream* zs, u32 generation)
+{
+	Threading::SetNameOfCurrentThread("CSO Decode");
+
+	std::unique_lock lock(m_decodeMutex);
+	for (;;)
+	{
+		m_decodeCV.wait(lock, [this, generation]() { return m_decodeQuit || m_decodeGeneration != generation; });
+		if (m_decodeQuit)
+			break;
+
+		generation = m_decodeGeneration;
+		lock.unlock();
+		DecodeBatch(zs);
+		lock.lock();
+
+		if (--m_decodeActive == 0)
+			m_decodeDoneCV.notify_one();
+	}
+}
+
 void CsoFileReader::Close2()
 {
 	m_filename.clear();
 
+	StopDecodeThreads();
+
 	if (m_src)
 	{
 		fclose(m_src);
@@ -191,6 +262,9 @@ void CsoFileReader::Close2()
 		inflateEnd(&m_z_stream);
 
 	m_readBuffer.reset();
+	m_batchBuffer.reset();
+	m_batchFrameBytes.clear();
+	m_batchCount = 0;
 	m_index.reset();
 }
 
@@ -221,90 +295,153 @@ int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
 		return -1;
 
 	const u32 frame = chunkID;
+	if (frame < m_batchStart || frame >= m_batchStart + m_batchCount)
+	{
+		if (m_batchCount > 0 && frame == m_batchStart + m_batchCount)
+			m_batchFrames = std::min(m_batchFrames * 2, m_maxBatchFrames);
+		else
+			m_batchFrames = m_minBatchFrames;
 
-	// Grab the index data for the frame we're about to read.
-	const bool compressed = (m_index[frame + 0] & 0x80000000) == 0;
-	const u32 index0 = m_index[frame + 0] & 0x7FFFFFFF;
-	const u32 index1 = m_index[frame + 1] & 0x7FFFFFFF;
+		if (!ReadBatch(frame))
+			return 0;
+	}
 
-	// Calculate where the compressed payload is (if compressed.)
-	const u64 frameRawPos = (u64)index0 << m_indexShift;
-	const u64 frameRawSize = (u64)(index1 - index0) << m_indexShift;
+	const u32 slot = frame - m_batchStart;
+	const int bytes = m_batchFrameBytes[slot];
+	if (bytes > 0)
+		std::memcpy(dst, &m_batchBuffer[static_cast<size_t>(slot) << m_frameShift], bytes);
+	else
+		m_batchCount = 0; // Try again next time rather than serving the failure from the batch.
 
-	if (!compressed)
-	{
-		if (m_file_cache)
-		{
-			if (frameRawPos >= m_file_cache_size)
-				return 0;
+	return bytes;
+}
 
-			const size_t read_count = std::min<size_t>(m_file_cache_size - frameRawPos, frameRawSize);
-			std::memcpy(dst, &m_file_cache[frameRawPos], read_count);
-			return static_cast<int>(read_count);
-		}
+bool CsoFileReader::ReadBatch(u32 frame)
+{
+	if (frame >= m_numFrames)
+		return false;
 
-		// Just read directly, easy.
-		if (FileSystem::FSeek64(m_src, frameRawPos, SEEK_SET) != 0)
-		{
-			Console.Error("Unable to seek to uncompressed CSO data.");
-			return 0;
-		}
-		return fread(dst, 1, m_frameSize, m_src);
+	// Adjacent frames are stored back to back, so the whole run is one contiguous read.
+	u32 count = std::min(m_batchFrames, m_numFrames - frame);
+	const u64 start = static_cast<u64>(m_index[frame] & 0x7FFFFFFF) << m_indexShift;
+	u64 end = static_cast<u64>(m_index[frame + count] & 0x7FFFFFFF) << m_indexShift;
+	while (count > 1 && (end - start) > m_readBufferSize)
+		end = static_cast<u64>(m_index[frame + --count] & 0x7FFFFFFF) << m_indexShift;
+
+	m_batchStart = frame;
+	m_batchCount = 0;
+
+	if (m_file_cache)
+	{
+		if (start >= m_file_cache_size)
+			return false;
+
+		m_batchSource = &m_file_cache[start];
+		m_batchSourceSize = std::min<size_t>(m_file_cache_size - start, end - start);
 	}
 	else
 	{
-		// This might be less bytes than frameRawSize in case of padding on the last frame.
-		// This is because the index positions must be aligned.
-		u32 readRawBytes;
-		u8* readBuffer;
-		if (m_file_cache)
+		if (FileSystem::FSeek64(m_src, start, SEEK_SET) != 0)
 		{
-			if (frameRawPos >= m_file_cache_size)
-				return 0;
-
-			readRawBytes = static_cast<u32>(std::min<size_t>(m_file_cache_size - frameRawPos, frameRawSize));
-			readBuffer = &m_file_cache[frameRawPos];
+			Console.Error("Unable to seek to CSO data.");
+			return false;
 		}
-		else
+
+		// This might be less bytes than requested in case of padding on the last frame.
+		// This is because the index positions must be aligned.
+		m_batchSource = m_readBuffer.get();
+		m_batchSourceSize = std::fread(m_readBuffer.get(), 1, std::min<u64>(end - start, m_readBufferSize), m_src);
+	}
+
+	m_batchCount = count;
+	m_batchNext.store(0, std::memory_order_relaxed);
+
+	if (m_decodeThreads.empty() || count == 1)
+	{
+		DecodeBatch(&m_z_stream);
+		return true;
+	}
+
+	{
+		std::unique_lock lock(m_decodeMutex);
+		m_decodeActive = static_cast<u32>(m_decodeThreads.size());
+		m_decodeGeneration++;
+	}
+	m_decodeCV.notify_all();
+
+	// The read thread would only be waiting otherwise, so it takes frames too.
+	DecodeBatch(&m_z_stream);
+
+	std::unique_lock lock(m_decodeMutex);
+	m_decodeDoneCV.wait(lock, [this]() { return m_decodeActive == 0; });
+	return true;
+}
+
+void CsoFileReader::DecodeBatch(z_stream* zs)
+{
+	const u32 base = m_index[m_batchStart] & 0x7FFFFFFF;
+	for (;;)
+	{
+		const u32 slot = m_batchNext.fetch_add(1, std::memory_order_relaxed);
+		if (slot >= m_batchCount)
+			break;
+
+		// Grab the index data for the frame we're about to decompress.
+		const u32 frame = m_batchStart + slot;
+		const bool compressed = (m_index[frame + 0] & 0x80000000) == 0;
+		const u32 index0 = m_index[frame + 0] & 0x7FFFFFFF;
+		const u32 index1 = m_index[frame + 1] & 0x7FFFFFFF;
+		const u64 frameOffset = static_cast<u64>(index0 - base) << m_indexShift;
+		const u64 frameRawSize = static_cast<u64>(index1 - index0) << m_indexShift;
+		u8* dst = &m_batchBuffer[static_cast<size_t>(slot) << m_frameShift];
+
+		int bytes = 0;
+		if (frameOffset < m_batchSourceSize)
 		{
-			if (FileSystem::FSeek64(m_src, frameRawPos, SEEK_SET) != 0)
+			const u32 available = static_cast<u32>(std::min<u64>(m_batchSourceSize - frameOffset, frameRawSize));
+			if (compressed)
+			{
+				bytes = DecompressFrame(zs, m_batchSource + frameOffset, available, dst);
+			}
+			else
 			{
-				Console.Error("Unable to seek to compressed CSO data.");
-				return 0;
+				bytes = static_cast<int>(std::min(available, m_frameSize));
+				std::memcpy(dst, m_batchSource + frameOffset, bytes);
 			}
-			readBuffer = m_readBuffer.get();
-			readRawBytes = fread(m_readBuffer.get(), 1, frameRawSize, m_src);
 		}
 
-		bool success = false;
-
-		if (m_uselz4)
-		{
-			const int src_size = static_cast<int>(readRawBytes);
-			const int dst_size = static_cast<int>(m_frameSize);
-			const char* src_buf = reinterpret_cast<const char*>(readBuffer);
-			char* dst_buf = static_cast<char*>(dst);
-			
-			const int res = LZ4_decompress_safe_partial(src_buf, dst_buf, src_size, dst_size, dst_size);
-			success = (res > 0);
-		}
-		else
-		{
-			m_z_stream.next_in = readBuffer;
-			m_z_stream.avail_in = readRawBytes;
-			m_z_stream.next_out = static_cast<Bytef*>(dst);
-			m_z_stream.avail_out = m_frameSize;
+		m_batchFrameBytes[slot] = bytes;
+	}
+}
 
-			const int status = inflate(&m_z_stream, Z_FINISH);
-			success = (status == Z_STREAM_END && m_z_stream.total_out == m_frameSize);
-		}
+int CsoFileReader::DecompressFrame(z_stream* zs, const u8* src, u32 srcSize, u8* dst)
+{
+	bool success = false;
 
-		if (!success)
-			Console.Error(fmt::format("Unable to decompress CSO frame using {}", (m_uselz4)? "lz4":"zlib"));
-		
-		if (!m_uselz4)
-			inflateReset(&m_z_stream);
+	if (m_uselz4)
+	{
+		const int src_size = static_cast<int>(srcSize);
+		const int dst_size = static_cast<int>(m_frameSize);
+		const char* src_buf = reinterpret_cast<const char*>(src);
+		char* dst_buf = reinterpret_cast<char*>(dst);
 
-		return success ? m_frameSize : 0;
+		const int res = LZ4_decompress_safe_partial(src_buf, dst_buf, src_size, dst_size, dst_size);
+		success = (res > 0);
 	}
+	else
+	{
+		zs->next_in = const_cast<Bytef*>(src);
+		zs->avail_in = srcSize;
+		zs->next_out = dst;
+		zs->avail_out = m_frameSize;
+
+		const int status = inflate(zs, Z_FINISH);
+		success = (status == Z_STREAM_END && zs->total_out == m_frameSize);
+		inflateReset(zs);
+	}
+
+	if (!success)
+		Console.Error(fmt::format("Unable to decompress CSO frame using {}", (m_uselz4)? "lz4":"zlib"));
+
+	return success ? m_frameSize : 0;
 }
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "ThreadedFileReader.h"
+#include <memory>
+#include <vector>
 #include <zlib.h>
 
 struct CsoHeader;
@@ -31,15 +33,28 @@ private:
 	static bool ValidateHeader(const CsoHeader& hdr, Error* error);
 	bool ReadFileHeader(Error* error);
 	bool InitializeBuffers(Error* error);
-	int ReadFromFrame(u8* dest, u64 pos, int maxBytes);
-	bool DecompressFrame(Bytef* dst, u32 frame, u32 readBufferSize);
-	bool DecompressFrame(u32 frame, u32 readBufferSize);
+	int DecompressFrame(z_stream* zs, const u8* src, u32 srcSize, u8* dst);
+
+	/// Reads the compressed data for a run of frames starting at `frame` in one go, and decompresses all of them.
+	bool ReadBatch(u32 frame);
+	/// Decompresses frames from the current batch until none are left, may run on several threads at once.
+	void DecodeBatch(z_stream* zs);
+	void DecodeThread(z_stream* zs, u32 generation);
+	void StartDecodeThreads();
+	void StopDecodeThreads();
+
+	/// Batches start small so seeks stay cheap, and double while the reads remain sequential.
+	static constexpr u32 MIN_BATCH_BYTES = 16 * 1024;
+	static constexpr u32 MAX_BATCH_BYTES = 1024 * 1024;
+	static constexpr u32 MAX_DECODE_THREADS = 4;
 
 	u32 m_frameSize = 0;
 	u8 m_frameShift = 0;
 	u8 m_indexShift = 0;
 	bool m_uselz4 = false; // flag to enable LZ4 decompression (ZSO files)
 	std::unique_ptr<u8[]> m_readBuffer;
+	u32 m_readBufferSize = 0;
+	u32 m_numFrames = 0;
 
 	std::unique_ptr<u32[]> m_index;
 	u64 m_totalSize = 0;
@@ -48,4 +63,25 @@ private:
 	std::unique_ptr<u8[]> m_file_cache;
 	size_t m_file_cache_size = 0;
 	z_stream m_z_stream = {};
+
+	// Decompressed frames from the most recent batch.
+	std::unique_ptr<u8[]> m_batchBuffer;
+	std::vector<int> m_batchFrameBytes;
+	const u8* m_batchSource = nullptr;
+	size_t m_batchSourceSize = 0;
+	u32 m_batchStart = 0;
+	u32 m_batchCount = 0;
+	u32 m_batchFrames = 0;
+	u32 m_minBatchFrames = 0;
+	u32 m_maxBatchFrames = 0;
+	std::atomic<u32> m_batchNext{0};
+
+	std::vector<std::thread> m_decodeThreads;
+	std::unique_ptr<z_stream[]> m_decodeStreams;
+	std::mutex m_decodeMutex;
+	std::condition_variable m_decodeCV;
+	std::condition_variable m_decodeDoneCV;
+	u32 m_decodeGeneration = 0;
+	u32 m_decodeActive = 0;
+	bool m_decodeQuit = false;
 };
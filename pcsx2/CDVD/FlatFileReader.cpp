@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "FlatFileReader.h"
+#include "Config.h"
 
 #include "common/Assertions.h"
 #include "common/Console.h"
@@ -11,8 +12,21 @@
 #include <cerrno>
 #include <cstring>
 
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
 static constexpr size_t CHUNK_SIZE = 128 * 1024;
 
+// Number of back-to-back reads before we consider the game to be streaming.
+static constexpr u32 SEQUENTIAL_READ_THRESHOLD = 4;
+
+// How far ahead of a sequential read to ask the OS to page in.
+static constexpr u64 READAHEAD_SIZE = 2 * _1mb;
+
 FlatFileReader::FlatFileReader() = default;
 
 FlatFileReader::~FlatFileReader()
@@ -35,9 +49,97 @@ bool FlatFileReader::Open2(std::string filename, Error* error)
 	}
 
 	m_file_size = static_cast<u64>(filesize);
+
+	// Page faults on the mapping happen on whichever thread reads the sector, usually the EE thread, and
+	// an I/O error is a SIGBUS/EXCEPTION_IN_PAGE_ERROR instead of a failed read. So it's opt-in.
+	if (EmuConfig.CdvdMapImages && !MapFile())
+		DEV_LOG("Failed to map '{}', falling back to buffered reads.", m_filename);
+
 	return true;
 }
 
+bool FlatFileReader::MapFile()
+{
+#ifdef _WIN32
+	const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+	const HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_handle)
+		return false;
+
+	m_mapping = static_cast<u8*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+	if (!m_mapping)
+	{
+		CloseHandle(mapping_handle);
+		return false;
+	}
+
+	m_mapping_handle = mapping_handle;
+#else
+	void* mapping = mmap(nullptr, m_file_size, PROT_READ, MAP_SHARED, fileno(m_file), 0);
+	if (mapping == MAP_FAILED)
+		return false;
+
+	// Games seek all over the place, so don't let the kernel read around every fault.
+	// We ask for readahead ourselves when reads are sequential.
+	madvise(mapping, m_file_size, MADV_RANDOM);
+	m_mapping = static_cast<u8*>(mapping);
+#endif
+
+	m_last_read_end = 0;
+	m_readahead_end = 0;
+	m_sequential_reads = 0;
+	return true;
+}
+
+void FlatFileReader::UnmapFile()
+{
+	if (!m_mapping)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_mapping);
+	CloseHandle(static_cast<HANDLE>(m_mapping_handle));
+	m_mapping_handle = nullptr;
+#else
+	munmap(m_mapping, m_file_size);
+#endif
+
+	m_mapping = nullptr;
+}
+
+void FlatFileReader::AdviseReadahead(u64 offset, u32 size)
+{
+	if (offset == m_last_read_end)
+	{
+		m_sequential_reads++;
+	}
+	else
+	{
+		m_sequential_reads = 0;
+		m_readahead_end = 0;
+	}
+
+	m_last_read_end = offset + size;
+
+	// Top up once we're halfway through the previous hint.
+	if (m_sequential_reads < SEQUENTIAL_READ_THRESHOLD || m_last_read_end + (READAHEAD_SIZE / 2) < m_readahead_end)
+		return;
+
+	const u64 start = std::max(m_readahead_end, m_last_read_end) & ~static_cast<u64>(__pagemask);
+	const u64 end = std::min(m_last_read_end + READAHEAD_SIZE, m_file_size);
+	if (start >= end)
+		return;
+
+#ifdef _WIN32
+	WIN32_MEMORY_RANGE_ENTRY range = {m_mapping + start, static_cast<SIZE_T>(end - start)};
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+	madvise(m_mapping + start, end - start, MADV_WILLNEED);
+#endif
+
+	m_readahead_end = end;
+}
+
 bool FlatFileReader::Precache2(ProgressCallback* progress, Error* error)
 {
 	if (!m_file || !CheckAvailableMemoryForPrecaching(m_file_size, error))
@@ -52,6 +154,8 @@ bool FlatFileReader::Precache2(ProgressCallback* progress, Error* error)
 		return false;
 	}
 
+	// Everything's in memory now, no need for the mapping.
+	UnmapFile();
 	std::fclose(m_file);
 	m_file = nullptr;
 	return true;
@@ -80,13 +184,13 @@ int FlatFileReader::ReadChunk(void* dst, s64 blockID)
 		return -1;
 
 	const u64 file_offset = static_cast<u64>(blockID) * CHUNK_SIZE;
-	if (m_file_cache)
+	if (const u8* data = m_file_cache ? m_file_cache.get() : m_mapping)
 	{
 		if (file_offset >= m_file_size)
 			return -1;
 
 		const u64 read_size = std::min<u64>(m_file_size - file_offset, CHUNK_SIZE);
-		std::memcpy(dst, &m_file_cache[file_offset], read_size);
+		std::memcpy(dst, &data[file_offset], read_size);
 		return static_cast<int>(read_size);
 	}
 
@@ -103,6 +207,7 @@ void FlatFileReader::Close2()
 	if (!m_file)
 		return;
 
+	UnmapFile();
 	std::fclose(m_file);
 	m_file = nullptr;
 	m_file_size = 0;
@@ -112,3 +217,19 @@ u32 FlatFileReader::GetBlockCount() const
 {
 	return static_cast<u32>(m_file_size / m_blocksize);
 }
+
+const u8* FlatFileReader::GetSectorPointer(u32 sector)
+{
+	const u8* data = m_file_cache ? m_file_cache.get() : m_mapping;
+	if (!data)
+		return nullptr;
+
+	const u64 offset = static_cast<u64>(sector) * m_blocksize + m_dataoffset;
+	if ((offset + m_blocksize) > m_file_size)
+		return nullptr;
+
+	if (!m_file_cache)
+		AdviseReadahead(offset, m_blocksize);
+
+	return data + offset;
+}
@@ -15,6 +15,21 @@ class FlatFileReader final : public ThreadedFileReader
 	std::unique_ptr<u8[]> m_file_cache;
 	u64 m_file_size = 0;
 
+	// Read-only mapping of the whole file, if enabled (CdvdMapImages) and the OS let us create one.
+	u8* m_mapping = nullptr;
+#ifdef _WIN32
+	void* m_mapping_handle = nullptr;
+#endif
+
+	// Access pattern tracking, for readahead hints.
+	u64 m_last_read_end = 0;
+	u64 m_readahead_end = 0;
+	u32 m_sequential_reads = 0;
+
+	bool MapFile();
+	void UnmapFile();
+	void AdviseReadahead(u64 offset, u32 size);
+
 public:
 	FlatFileReader();
 	~FlatFileReader() override;
@@ -29,4 +44,6 @@ public:
 	void Close2() override;
 
 	u32 GetBlockCount() const override;
+
+	const u8* GetSectorPointer(u32 sector) override;
 };
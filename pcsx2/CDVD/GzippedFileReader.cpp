@@ -11,6 +11,7 @@
 #include "common/Error.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 #include "common/Timer.h"
 
 #include "fmt/format.h"
@@ -150,22 +151,58 @@ bool GzippedFileReader::LoadOrCreateIndex(Error* error)
 
 	if ((m_index = ReadIndexFromFile(indexfile.c_str())) != nullptr)
 	{
+		// Indexes built with a different span are still fine, the span only decides where the access points are.
 		INFO_LOG("Gzip quick access index read from disk: '{}'", indexfile);
+		m_span = m_index->span;
+		m_uncompressed_size.store(m_index->uncompressed_size, std::memory_order_relaxed);
 		return true;
 	}
 
+	const s32 span = std::clamp(EmuConfig.GzipIsoIndexSpan, GZFILE_SPAN_MIN / 1024, GZFILE_SPAN_MAX / 1024) * 1024;
+
+	s64 size;
+	if (GuessUncompressedSize(&size))
+	{
+		Access* const index = static_cast<Access*>(std::calloc(1, sizeof(Access)));
+		Point* const list = static_cast<Point*>(std::malloc(sizeof(Point) * 8));
+		if (index && list)
+		{
+			Console.Warning("Scanning compressed file in the background to generate a quick access index, seeking may be slow until it completes.");
+
+			index->list = list;
+			index->size = 8;
+			index->span = span;
+			index->uncompressed_size = size;
+			m_index = index;
+			m_span = span;
+			m_uncompressed_size.store(size, std::memory_order_relaxed);
+
+			m_index_cancel.store(false, std::memory_order_relaxed);
+			m_index_building = true;
+			m_index_thread = std::thread(&GzippedFileReader::BuildIndexThread, this, indexfile, span);
+			return true;
+		}
+
+		std::free(list);
+		std::free(index);
+	}
+
 	// No valid index file. Generate an index
 	Console.Warning("This may take a while (but only once). Scanning compressed file to generate a quick access index...");
 
+	Common::Timer timer;
 	const s64 prevoffset = FileSystem::FTell64(m_src);
 	Access* index = nullptr;
-	int len = build_index(m_src, GZFILE_SPAN_DEFAULT, &index);
+	int len = build_index(m_src, span, &index);
 	printf("\n"); // build_index prints progress without \n's
 	FileSystem::FSeek64(m_src, prevoffset, SEEK_SET);
 
 	if (len >= 0)
 	{
+		INFO_LOG("Gzip quick access index built in {:.1f} seconds ({} access points).", timer.GetTimeSeconds(), static_cast<int>(index->have));
 		m_index = index;
+		m_span = m_index->span;
+		m_uncompressed_size.store(m_index->uncompressed_size, std::memory_order_relaxed);
 		WriteIndexToFile(m_index, indexfile.c_str());
 	}
 	else
@@ -178,6 +215,207 @@ bool GzippedFileReader::LoadOrCreateIndex(Error* error)
 	return true;
 }
 
+bool GzippedFileReader::GuessUncompressedSize(s64* size)
+{
+	// The gzip trailer only has the size modulo 4GB, so the ISO9660 volume descriptor is used to pick the multiple.
+	static constexpr u32 HEADER_SIZE = 48 * 1024;
+
+	const s64 prevoffset = FileSystem::FTell64(m_src);
+	u8 trailer[4];
+	if (FileSystem::FSeek64(m_src, -4, SEEK_END) != 0 || std::fread(trailer, sizeof(trailer), 1, m_src) != 1)
+	{
+		FileSystem::FSeek64(m_src, prevoffset, SEEK_SET);
+		return false;
+	}
+	const u32 size_mod = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (static_cast<u32>(trailer[3]) << 24);
+
+	std::unique_ptr<u8[]> header = std::make_unique<u8[]>(HEADER_SIZE);
+	std::unique_ptr<u8[]> input = std::make_unique<u8[]>(CHUNK);
+	u32 header_len = 0;
+	z_stream strm = {};
+	if (FileSystem::FSeek64(m_src, 0, SEEK_SET) == 0 && inflateInit2(&strm, 47) == Z_OK)
+	{
+		strm.next_out = header.get();
+		strm.avail_out = HEADER_SIZE;
+		while (strm.avail_out > 0)
+		{
+			if (strm.avail_in == 0)
+			{
+				strm.avail_in = static_cast<uInt>(std::fread(input.get(), 1, CHUNK, m_src));
+				strm.next_in = input.get();
+				if (strm.avail_in == 0)
+					break;
+			}
+
+			if (inflate(&strm, Z_NO_FLUSH) != Z_OK)
+				break;
+		}
+
+		header_len = HEADER_SIZE - strm.avail_out;
+		inflateEnd(&strm);
+	}
+	FileSystem::FSeek64(m_src, prevoffset, SEEK_SET);
+
+	static constexpr struct
+	{
+		u32 sector_size;
+		u32 data_offset;
+	} layouts[] = {{2048, 0}, {2352, 24}, {2352, 16}, {2448, 24}, {2448, 16}};
+
+	u64 min_size = 0;
+	for (const auto& layout : layouts)
+	{
+		const u32 pvd = 16 * layout.sector_size + layout.data_offset;
+		if ((pvd + 84) <= header_len && header[pvd] == 1 && std::memcmp(&header[pvd + 1], "CD001", 5) == 0)
+		{
+			u32 blocks;
+			std::memcpy(&blocks, &header[pvd + 80], sizeof(blocks));
+			min_size = static_cast<u64>(blocks) * layout.sector_size;
+			break;
+		}
+	}
+	if (min_size == 0)
+		return false;
+
+	u64 guess = size_mod;
+	while (guess < min_size)
+		guess += 0x100000000ULL;
+
+	// The descriptor only covers the first layer of dual layer discs, but the second can't be any bigger.
+	// Anything else is probably a truncated image, where it's safer to scan the whole thing first.
+	if (guess > min_size * 2)
+		return false;
+
+	DEV_LOG("Gzip: Assuming uncompressed size of {} bytes ({} in volume descriptor).", guess, min_size);
+	*size = static_cast<s64>(guess);
+	return true;
+}
+
+void GzippedFileReader::BuildIndexThread(std::string indexfile, s32 span)
+{
+	Threading::SetNameOfCurrentThread("Gzip Indexer");
+
+	// Same walk as build_index(), except access points go straight into the shared index so reads can use them.
+	Common::Timer timer;
+	auto fp = FileSystem::OpenManagedCFile(m_filename.c_str(), "rb");
+	std::unique_ptr<u8[]> input = std::make_unique<u8[]>(CHUNK);
+	std::unique_ptr<u8[]> window = std::make_unique<u8[]>(WINSIZE);
+	s64 totin = 0, totout = 0, last = 0;
+	int ret = Z_ERRNO;
+	z_stream strm = {};
+	if (fp && (ret = inflateInit2(&strm, 47)) == Z_OK)
+	{
+		strm.avail_out = 0;
+		while (ret != Z_STREAM_END)
+		{
+			if (m_index_cancel.load(std::memory_order_relaxed))
+			{
+				ret = Z_ERRNO;
+				break;
+			}
+
+			strm.avail_in = static_cast<uInt>(std::fread(input.get(), 1, CHUNK, fp.get()));
+			if (std::ferror(fp.get()))
+			{
+				ret = Z_ERRNO;
+				break;
+			}
+			if (strm.avail_in == 0)
+			{
+				ret = Z_DATA_ERROR;
+				break;
+			}
+			strm.next_in = input.get();
+
+			do
+			{
+				if (strm.avail_out == 0)
+				{
+					strm.avail_out = WINSIZE;
+					strm.next_out = window.get();
+				}
+
+				totin += strm.avail_in;
+				totout += strm.avail_out;
+				ret = inflate(&strm, Z_BLOCK);
+				totin -= strm.avail_in;
+				totout -= strm.avail_out;
+				if (ret == Z_NEED_DICT)
+					ret = Z_DATA_ERROR;
+				if (ret == Z_MEM_ERROR || ret == Z_DATA_ERROR || ret == Z_STREAM_END)
+					break;
+
+				if ((strm.data_type & 128) && !(strm.data_type & 64) && (totout == 0 || totout - last > span))
+				{
+					std::unique_lock lock(m_index_mutex);
+
+					// Grow the list here, addpoint() frees the whole index if it can't.
+					if (m_index->have == m_index->size)
+					{
+						Point* list = static_cast<Point*>(std::realloc(m_index->list, sizeof(Point) * m_index->size * 2));
+						if (!list)
+						{
+							ret = Z_MEM_ERROR;
+							break;
+						}
+						m_index->list = list;
+						m_index->size *= 2;
+					}
+
+					addpoint(m_index, strm.data_type & 7, totin, totout, strm.avail_out, window.get());
+					last = totout;
+
+					lock.unlock();
+					m_index_cv.notify_all();
+				}
+			} while (strm.avail_in != 0);
+
+			if (ret == Z_MEM_ERROR || ret == Z_DATA_ERROR)
+				break;
+		}
+
+		inflateEnd(&strm);
+	}
+
+	std::unique_lock lock(m_index_mutex);
+	m_index_building = false;
+
+	if (ret == Z_STREAM_END && m_index->have > 0)
+	{
+		if (totout != m_index->uncompressed_size)
+		{
+			Console.Error(fmt::format("Gzip image is {} bytes, but {} bytes was assumed while indexing. Reopen the image to use the correct size.",
+				totout, static_cast<s64>(m_index->uncompressed_size)));
+		}
+
+		m_index->list = static_cast<Point*>(std::realloc(m_index->list, sizeof(Point) * m_index->have));
+		m_index->size = m_index->have;
+		m_index->uncompressed_size = totout;
+		m_uncompressed_size.store(totout, std::memory_order_relaxed);
+		WriteIndexToFile(m_index, indexfile.c_str());
+
+		const double seconds = timer.GetTimeSeconds();
+		INFO_LOG("Gzip quick access index built in {:.1f} seconds ({} access points, {:.1f} MB/s).", seconds, static_cast<int>(m_index->have),
+			static_cast<double>(totin) / static_cast<double>(_1mb) / std::max(seconds, 0.001));
+	}
+	else if (!m_index_cancel.load(std::memory_order_relaxed))
+	{
+		ERROR_LOG("Failed to build gzip quick access index ({}), seeking will stay slow.", ret);
+	}
+
+	lock.unlock();
+	m_index_cv.notify_all();
+}
+
+void GzippedFileReader::StopIndexThread()
+{
+	if (!m_index_thread.joinable())
+		return;
+
+	m_index_cancel.store(true, std::memory_order_relaxed);
+	m_index_thread.join();
+}
+
 bool GzippedFileReader::Open2(std::string filename, Error* error)
 {
 	Close();
@@ -194,6 +432,17 @@ bool GzippedFileReader::Open2(std::string filename, Error* error)
 
 void GzippedFileReader::Close2()
 {
+	StopIndexThread();
+
+	if (m_seek_count > 0)
+	{
+		DEV_LOG("Gzip: {} seeks, {:.2f} ms average, {:.2f} ms worst.", m_seek_count, m_seek_time_total / m_seek_count,
+			m_seek_time_max);
+		m_seek_count = 0;
+		m_seek_time_total = 0.0;
+		m_seek_time_max = 0.0;
+	}
+
 	if (m_z_state.isValid)
 	{
 		inflateEnd(&m_z_state.strm);
@@ -216,15 +465,15 @@ void GzippedFileReader::Close2()
 ThreadedFileReader::Chunk GzippedFileReader::ChunkForOffset(u64 offset)
 {
 	ThreadedFileReader::Chunk chunk = {};
-	if (static_cast<s64>(offset) >= m_index->uncompressed_size)
+	if (static_cast<s64>(offset) >= m_uncompressed_size.load(std::memory_order_relaxed))
 	{
 		chunk.chunkID = -1;
 	}
 	else
 	{
-		chunk.chunkID = static_cast<s64>(offset) / m_index->span;
-		chunk.length = m_index->span;
-		chunk.offset = static_cast<u64>(chunk.chunkID) * m_index->span;
+		chunk.chunkID = static_cast<s64>(offset) / m_span;
+		chunk.length = m_span;
+		chunk.offset = static_cast<u64>(chunk.chunkID) * m_span;
 	}
 
 	return chunk;
@@ -235,12 +484,48 @@ int GzippedFileReader::ReadChunk(void* dst, s64 chunkID)
 	if (chunkID < 0)
 		return -1;
 
-	const s64 file_offset = chunkID * m_index->span;
-	const u32 read_len = static_cast<u32>(std::min<s64>(m_index->uncompressed_size - file_offset, m_index->span));
-	return extract(m_src, m_index, file_offset, static_cast<unsigned char*>(dst), read_len, &m_z_state);
+	const s64 file_offset = chunkID * m_span;
+	const u32 read_len = static_cast<u32>(std::min<s64>(m_uncompressed_size.load(std::memory_order_relaxed) - file_offset, m_span));
+	const bool seek = !m_z_state.isValid || m_z_state.out_offset != file_offset;
+	Common::Timer timer;
+
+	{
+		std::unique_lock lock(m_index_mutex);
+
+		// The first access point shows up as soon as the build thread is past the gzip header.
+		m_index_cv.wait(lock, [this]() { return m_index->have > 0 || !m_index_building; });
+		if (m_index->have == 0)
+			return -1;
+
+		// extract() only looks at the index to find the point to start a seek from, copy it so the build thread
+		// isn't blocked while we decompress. Past the end of a partial index that's the last point, and this
+		// decompresses forward from there the same as the builder does.
+		if (seek)
+		{
+			const Point* here = m_index->list;
+			for (int remaining = m_index->have; --remaining && here[1].out <= file_offset;)
+				here++;
+			m_seek_point = *here;
+		}
+	}
+
+	Access seek_index = {};
+	seek_index.have = 1;
+	seek_index.list = &m_seek_point;
+	const int ret = extract(m_src, &seek_index, file_offset, static_cast<unsigned char*>(dst), read_len, &m_z_state);
+
+	if (seek)
+	{
+		const double ms = timer.GetTimeMilliseconds();
+		m_seek_count++;
+		m_seek_time_total += ms;
+		m_seek_time_max = std::max(m_seek_time_max, ms);
+	}
+
+	return ret;
 }
 
 u32 GzippedFileReader::GetBlockCount() const
 {
-	return (m_index->uncompressed_size + (m_blocksize - 1)) / m_blocksize;
+	return (m_uncompressed_size.load(std::memory_order_relaxed) + (m_blocksize - 1)) / m_blocksize;
 }
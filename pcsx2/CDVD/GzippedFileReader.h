@@ -24,16 +24,39 @@ public:
 	u32 GetBlockCount() const override;
 
 private:
-	static constexpr int GZFILE_SPAN_DEFAULT = (1048576 * 4); /* distance between direct access points when creating a new index */
+	static constexpr int GZFILE_SPAN_DEFAULT = (1048576 * 2); /* distance between direct access points when creating a new index */
+	static constexpr int GZFILE_SPAN_MIN = (256 * 1024);
+	static constexpr int GZFILE_SPAN_MAX = (1048576 * 16);
 	static constexpr int GZFILE_READ_CHUNK_SIZE = (256 * 1024); /* zlib extraction chunks size (at 0-based boundaries) */
 	static constexpr int GZFILE_CACHE_SIZE_MB = 200; /* cache size for extracted data. must be at least GZFILE_READ_CHUNK_SIZE (in MB)*/
 
 	// Verifies that we have an index, or try to create one
 	bool LoadOrCreateIndex(Error* error);
 
+	// Works out the uncompressed size without decompressing the whole file, so the index can be built in the background.
+	bool GuessUncompressedSize(s64* size);
+
+	// Builds the index on a separate file handle, publishing access points to m_index as they're found.
+	void BuildIndexThread(std::string indexfile, s32 span);
+	void StopIndexThread();
+
 	Access* m_index = nullptr; // Quick access index
+	std::atomic<s64> m_uncompressed_size{0};
+	s32 m_span = 0;
 
 	std::FILE* m_src = nullptr;
 
 	zstate m_z_state = {};
+	Point m_seek_point = {}; // Copy of the access point a seek starts from, so extract() can run unlocked
+
+	// m_index is shared with the build thread while it's running, and may be reallocated when points are added.
+	std::mutex m_index_mutex;
+	std::condition_variable m_index_cv;
+	std::thread m_index_thread;
+	std::atomic_bool m_index_cancel{false};
+	bool m_index_building = false;
+
+	u32 m_seek_count = 0;
+	double m_seek_time_total = 0.0;
+	double m_seek_time_max = 0.0;
 };
@@ -64,6 +64,12 @@ int InputIsoFile::ReadSync(u8* dst, uint lsn)
 		return -1;
 	}
 
+	if (const u8* sector = m_reader->GetSectorPointer(lsn))
+	{
+		std::memcpy(dst + m_blockofs, sector, m_blocksize);
+		return static_cast<int>(m_blocksize);
+	}
+
 	return m_reader->ReadSync(dst + m_blockofs, lsn, 1);
 }
 
@@ -85,6 +91,11 @@ void InputIsoFile::BeginRead2(uint lsn)
 
 	m_read_lsn = lsn;
 
+	// No need to go through the read thread if the data's already in memory.
+	m_read_sector = m_reader->GetSectorPointer(m_read_lsn);
+	if (m_read_sector)
+		return;
+
 	m_reader->BeginRead(m_readbuffer, m_read_lsn, 1);
 	m_read_inprogress = true;
 }
@@ -152,7 +163,7 @@ int InputIsoFile::FinishRead3(u8* dst, uint mode)
 
 	length = end - _offset;
 
-	std::memcpy(dst + diff, m_readbuffer + ndiff, length);
+	std::memcpy(dst + diff, (m_read_sector ? m_read_sector : m_readbuffer) + ndiff, length);
 
 	if (m_type == ISOTYPE_CD && diff >= 12)
 	{
@@ -186,6 +197,7 @@ void InputIsoFile::_init()
 	m_read_inprogress = false;
 	m_current_lsn = -1;
 	m_read_lsn = -1;
+	m_read_sector = nullptr;
 	m_reader.reset();
 }
 
@@ -223,6 +235,10 @@ bool InputIsoFile::Open(std::string srcfile, Error* error)
 
 bool InputIsoFile::Precache(ProgressCallback* progress, Error* error)
 {
+	// The reader may move the image into its own buffer.
+	m_read_lsn = -1;
+	m_read_sector = nullptr;
+
 	return m_reader->Precache(progress, error);
 }
 
@@ -230,6 +246,14 @@ void InputIsoFile::Close()
 {
 	if (m_reader)
 	{
+		const ThreadedFileReader::ReadStats stats = m_reader->GetReadStats();
+		if (stats.requests > 0)
+		{
+			DEV_LOG("isoFile reads: {} requests, {:.1f}% cached, {} prefetched ({} used, {} wasted)", stats.requests,
+				static_cast<double>(stats.hits) * 100.0 / static_cast<double>(stats.requests), stats.prefetched,
+				stats.prefetchHits, stats.prefetchWasted);
+		}
+
 		m_reader->Close();
 		m_reader.reset();
 	}
@@ -50,6 +50,9 @@ protected:
 	uint m_read_lsn;
 	u8 m_readbuffer[CD_FRAMESIZE_RAW];
 
+	// Points into the reader's memory instead of m_readbuffer, when it has the whole image mapped.
+	const u8* m_read_sector;
+
 public:
 	InputIsoFile();
 	~InputIsoFile();
@@ -11,6 +11,7 @@
 #include "common/SmallString.h"
 #include "common/Threading.h"
 
+#include <algorithm>
 #include <cstring>
 
 // Make sure buffer size is bigger than the cutoff where PCSX2 emulates a seek
@@ -100,7 +101,14 @@ void ThreadedFileReader::Loop()
 		{
 			// Readahead
 			Chunk chunk = ChunkForOffset(requestOffset + requestSize);
+			bool streamed = false;
 			if (chunk.chunkID >= 0)
+			{
+				// Leave the readahead buffers to other streams if the prefetcher is already handling this one
+				std::lock_guard<std::mutex> l(m_mtx);
+				streamed = StreamCacheEnd(chunk.offset) || IsPrefetchQueued(chunk.offset);
+			}
+			if (chunk.chunkID >= 0 && !streamed)
 			{
 				int buffersFilled = 0;
 				Buffer* buf = GetBlockPtr(chunk);
@@ -120,6 +128,12 @@ void ThreadedFileReader::Loop()
 					}
 					else
 					{
+						{
+							// Don't read it twice if the prefetcher already has it
+							std::lock_guard<std::mutex> l(m_mtx);
+							if (StreamCacheEnd(chunk.offset))
+								break;
+						}
 						int amt = ReadChunk(static_cast<char*>(buf->ptr) + bufsize, chunk.chunkID);
 						if (amt <= 0)
 							break;
@@ -129,6 +143,8 @@ void ThreadedFileReader::Loop()
 			}
 		}
 
+		PrefetchStreams();
+
 		lock.lock();
 		if (requestSize == m_requestSize && requestOffset == m_requestOffset && !m_requestPtr)
 		{
@@ -169,6 +185,18 @@ ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
 			buf.cap = size;
 		}
 		buf.size.store(0, std::memory_order_relaxed);
+
+		// Copy rather than read again if the prefetcher already has it
+		StreamSlot* slot = FindStreamSlot(block.offset);
+		if (slot && slot->offset + slot->size >= block.offset + block.length)
+		{
+			std::memcpy(buf.ptr, slot->ptr.get() + (block.offset - slot->offset), block.length);
+			TouchStreamSlot(*slot);
+			buf.offset = block.offset;
+			buf.size.store(block.length, std::memory_order_release);
+			m_nextBuffer = (m_nextBuffer + 1) % std::size(m_buffer);
+			return &buf;
+		}
 	}
 	int size = ReadChunk(buf.ptr, block.chunkID);
 	if (size > 0)
@@ -248,9 +276,269 @@ bool ThreadedFileReader::TryCachedRead(void*& buffer, u64& offset, u32& size, co
 		if (end > 0 && buf.offset == end)
 			allDone = true;
 	}
+
+	// Whatever's left may have been prefetched for one of the other streams
+	bool fromStream = false;
+	while (size > 0)
+	{
+		StreamSlot* slot = FindStreamSlot(offset);
+		if (!slot)
+			break;
+		u32 off = offset - slot->offset;
+		u32 cpysize = std::min(size, slot->size - off);
+		size_t read = CopyBlocks(buffer, slot->ptr.get() + off, cpysize);
+		m_amtRead += read;
+		size -= cpysize;
+		offset += cpysize;
+		buffer = static_cast<char*>(buffer) + read;
+		TouchStreamSlot(*slot);
+		fromStream = true;
+	}
+	// The stream tracker queues anything we'll need next, so no need to wake the read thread
+	if (fromStream && size == 0)
+		allDone = true;
 	return allDone;
 }
 
+void ThreadedFileReader::UpdateReadStreams(u64 offset, u32 size)
+{
+	m_streamClock++;
+
+	// Either continues where a stream left off, or repeats its stride
+	ReadStream* match = nullptr;
+	bool sequential = false;
+	for (ReadStream& stream : m_streams)
+	{
+		const s64 delta = static_cast<s64>(offset - stream.offset);
+		if (stream.size && (delta == static_cast<s64>(stream.size) || (stream.stride && delta == stream.stride)))
+		{
+			match = &stream;
+			match->confidence++;
+			sequential = delta == static_cast<s64>(stream.size);
+			break;
+		}
+	}
+	if (!match)
+	{
+		// Close to a stream that hasn't settled yet, guess that this is its stride
+		for (ReadStream& stream : m_streams)
+		{
+			const s64 delta = static_cast<s64>(offset - stream.offset);
+			if (stream.size && stream.confidence < STREAM_CONFIDENCE && delta != 0 && std::abs(delta) <= MAX_STREAM_STRIDE)
+			{
+				match = &stream;
+				match->confidence = 1;
+				break;
+			}
+		}
+	}
+	if (match)
+	{
+		match->stride = static_cast<s64>(offset - match->offset);
+	}
+	else
+	{
+		match = std::min_element(std::begin(m_streams), std::end(m_streams),
+			[](const ReadStream& a, const ReadStream& b) { return a.lastUsed < b.lastUsed; });
+		*match = {};
+	}
+	match->offset = offset;
+	match->size = size;
+	match->lastUsed = m_streamClock;
+
+	if (match->confidence < STREAM_CONFIDENCE || !size)
+		return;
+
+	const auto queue = [this](u64 next, u64 end, u32 length) {
+		// Skip over anything we already have
+		while (next < end)
+		{
+			const u64 cached = std::max(BufferEnd(next), StreamCacheEnd(next));
+			if (!cached)
+				break;
+			next = cached;
+		}
+		if (next >= end || IsPrefetchQueued(next))
+			return;
+		if (m_prefetchQueue.size() >= MAX_PREFETCH_QUEUE)
+			m_prefetchQueue.erase(m_prefetchQueue.begin());
+		m_prefetchQueue.push_back({next, length});
+	};
+
+	if (sequential)
+	{
+		// Once we're less than a buffer away from running out, fetch another buffer's worth
+		const u64 next = offset + size;
+		const u32 length = std::max(size, MINIMUM_SIZE);
+		queue(next, next + length, length);
+		return;
+	}
+
+	const u32 depth = std::min(match->confidence - STREAM_CONFIDENCE + 1, MAX_PREFETCH_DEPTH);
+	for (u32 i = 1; i <= depth; i++)
+	{
+		const s64 distance = match->stride * static_cast<s64>(i);
+		if (distance < 0 && static_cast<u64>(-distance) > offset)
+			break;
+		queue(offset + distance, offset + distance + size, size);
+	}
+}
+
+void ThreadedFileReader::PrefetchStreams()
+{
+	std::unique_lock<std::mutex> lock(m_mtx);
+	while (!m_prefetchQueue.empty())
+	{
+		const PrefetchRange range = m_prefetchQueue.front();
+		m_prefetchQueue.erase(m_prefetchQueue.begin());
+
+		const u64 end = range.offset + range.size;
+		u64 offset = range.offset;
+		while (offset < end)
+		{
+			// Real requests always take priority
+			if (m_requestPtr.load(std::memory_order_acquire) || m_requestCancelled.load(std::memory_order_relaxed))
+				return;
+
+			if (const u64 cached = std::max(BufferEnd(offset), StreamCacheEnd(offset)))
+			{
+				offset = cached;
+				continue;
+			}
+
+			Chunk chunk = ChunkForOffset(offset);
+			if (chunk.chunkID < 0)
+				break;
+
+			StreamSlot* slot = AllocateStreamSlot(chunk.length);
+			slot->offset = chunk.offset;
+			slot->size = 0;
+			slot->used = false;
+			slot->filling = true;
+			lock.unlock();
+
+			u32 filled = 0;
+			for (;;)
+			{
+				int amt = ReadChunk(slot->ptr.get() + filled, chunk.chunkID);
+				if (amt <= 0)
+					break;
+				filled += amt;
+				if (chunk.offset + chunk.length >= end || m_requestPtr.load(std::memory_order_acquire))
+					break;
+				chunk = ChunkForOffset(slot->offset + filled);
+				if (chunk.chunkID < 0 || chunk.offset != slot->offset + filled || filled + chunk.length > slot->cap)
+					break;
+			}
+
+			lock.lock();
+			slot->filling = false;
+			slot->size = filled;
+			if (!filled)
+				break;
+			m_stats.prefetched++;
+			offset = slot->offset + filled;
+		}
+	}
+}
+
+ThreadedFileReader::StreamSlot* ThreadedFileReader::FindStreamSlot(u64 offset)
+{
+	for (StreamSlot& slot : m_streamSlots)
+	{
+		if (!slot.filling && slot.size && slot.offset <= offset && slot.offset + slot.size > offset)
+			return &slot;
+	}
+	return nullptr;
+}
+
+u64 ThreadedFileReader::BufferEnd(u64 offset)
+{
+	for (const Buffer& buf : m_buffer)
+	{
+		u32 size = buf.size.load(std::memory_order_acquire);
+		if (size && buf.offset <= offset && buf.offset + size > offset)
+			return buf.offset + size;
+	}
+	return 0;
+}
+
+u64 ThreadedFileReader::StreamCacheEnd(u64 offset)
+{
+	for (const StreamSlot& slot : m_streamSlots)
+	{
+		// Assume a slot that's being filled will be filled completely
+		u32 size = slot.filling ? slot.cap : slot.size;
+		if (size && slot.offset <= offset && slot.offset + size > offset)
+			return slot.offset + size;
+	}
+	return 0;
+}
+
+bool ThreadedFileReader::IsPrefetchQueued(u64 offset)
+{
+	return std::any_of(m_prefetchQueue.begin(), m_prefetchQueue.end(),
+		[offset](const PrefetchRange& range) { return range.offset <= offset && range.offset + range.size > offset; });
+}
+
+ThreadedFileReader::StreamSlot* ThreadedFileReader::AllocateStreamSlot(u32 length)
+{
+	const u32 cap = std::max(length, MINIMUM_SIZE);
+	if (m_streamSlots.empty())
+		m_streamSlots.resize(std::clamp<u32>(STREAM_CACHE_BYTES / cap, 2, MAX_STREAM_SLOTS));
+
+	// Only the read thread fills slots, one at a time, so there's always one to take
+	StreamSlot* victim = nullptr;
+	for (StreamSlot& slot : m_streamSlots)
+	{
+		if (!slot.filling && (!victim || slot.lastUsed < victim->lastUsed))
+			victim = &slot;
+	}
+
+	if (victim->size && !victim->used)
+		m_stats.prefetchWasted++;
+	if (victim->cap < cap)
+	{
+		victim->ptr = std::make_unique_for_overwrite<u8[]>(cap);
+		victim->cap = cap;
+	}
+	victim->size = 0;
+	victim->lastUsed = ++m_streamClock;
+	return victim;
+}
+
+void ThreadedFileReader::TouchStreamSlot(StreamSlot& slot)
+{
+	if (!slot.used)
+	{
+		slot.used = true;
+		m_stats.prefetchHits++;
+	}
+	slot.lastUsed = ++m_streamClock;
+}
+
+void ThreadedFileReader::ClearReadStreams()
+{
+	std::fill(std::begin(m_streams), std::end(m_streams), ReadStream());
+	m_streamSlots.clear();
+	m_prefetchQueue.clear();
+	m_streamClock = 0;
+	m_stats = {};
+}
+
+ThreadedFileReader::ReadStats ThreadedFileReader::GetReadStats()
+{
+	std::lock_guard<std::mutex> l(m_mtx);
+	return m_stats;
+}
+
+void ThreadedFileReader::WaitUntilIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mtx);
+	while (m_running || m_requestSize)
+		m_condition.wait(lock);
+}
+
 bool ThreadedFileReader::Precache(ProgressCallback* progress, Error* error)
 {
 	CancelAndWaitUntilStopped();
@@ -264,6 +552,11 @@ bool ThreadedFileReader::Precache2(ProgressCallback* progress, Error* error)
 	return false;
 }
 
+const u8* ThreadedFileReader::GetSectorPointer(u32 sector)
+{
+	return nullptr;
+}
+
 bool ThreadedFileReader::CheckAvailableMemoryForPrecaching(u64 required_size, Error* error)
 {
 	// Don't allow precaching to use more than 50% of system memory.
@@ -284,6 +577,7 @@ bool ThreadedFileReader::CheckAvailableMemoryForPrecaching(u64 required_size, Er
 bool ThreadedFileReader::Open(std::string filename, Error* error)
 {
 	CancelAndWaitUntilStopped();
+	ClearReadStreams();
 	return Open2(std::move(filename), error);
 }
 
@@ -294,7 +588,14 @@ int ThreadedFileReader::ReadSync(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
+		UpdateReadStreams(offset, size);
+		const bool cached = TryCachedRead(pBuffer, offset, size, l);
+		m_stats.requests++;
+		if (size == 0)
+			m_stats.hits++;
+		else
+			m_stats.misses++;
+		if (cached && m_prefetchQueue.empty())
 			return m_amtRead;
 
 		if (size > 0 && !m_running)
@@ -348,7 +649,14 @@ void ThreadedFileReader::BeginRead(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
+		UpdateReadStreams(offset, size);
+		const bool cached = TryCachedRead(pBuffer, offset, size, l);
+		m_stats.requests++;
+		if (size == 0)
+			m_stats.hits++;
+		else
+			m_stats.misses++;
+		if (cached && m_prefetchQueue.empty())
 			return;
 		if (size == 0)
 		{
@@ -393,6 +701,7 @@ void ThreadedFileReader::Close(void)
 	CancelAndWaitUntilStopped();
 	for (auto& buf : m_buffer)
 		buf.size.store(0, std::memory_order_relaxed);
+	ClearReadStreams();
 	Close2();
 }
 
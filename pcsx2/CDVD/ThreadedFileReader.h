@@ -9,6 +9,8 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <memory>
+#include <vector>
 
 class Error;
 class ProgressCallback;
@@ -92,9 +94,96 @@ private:
 	/// Returns the number of external block bytes copied
 	size_t CopyBlocks(void* dst, const void* src, size_t size) const;
 
+	/// A run of requests the guest is making, either back to back or with a constant stride
+	struct ReadStream
+	{
+		u64 offset = 0;
+		u32 size = 0;
+		s64 stride = 0;
+		u32 confidence = 0;
+		u64 lastUsed = 0;
+	};
+	/// A range of (internal block) bytes the stream tracker expects to be read soon
+	struct PrefetchRange
+	{
+		u64 offset;
+		u32 size;
+	};
+	/// Chunks fetched for predicted streams
+	/// Kept separate from m_buffer so that interleaved streams don't keep evicting each other
+	struct StreamSlot
+	{
+		std::unique_ptr<u8[]> ptr;
+		u64 offset = 0;
+		u32 size = 0;
+		u32 cap = 0;
+		u64 lastUsed = 0;
+		/// Set while the read thread is filling the slot without holding `m_mtx`
+		bool filling = false;
+		bool used = false;
+	};
+	static constexpr u32 MAX_READ_STREAMS = 4;
+	static constexpr u32 MAX_STREAM_SLOTS = 16;
+	static constexpr u32 MAX_PREFETCH_QUEUE = 16;
+	static constexpr u32 STREAM_CACHE_BYTES = 4 * 1024 * 1024;
+	/// Largest gap between two requests that will still be treated as part of the same stream
+	static constexpr s64 MAX_STREAM_STRIDE = 4 * 1024 * 1024;
+	static constexpr u32 MAX_PREFETCH_DEPTH = 4;
+	/// Number of requests that have to follow a stream's pattern before it gets prefetched
+	static constexpr u32 STREAM_CONFIDENCE = 2;
+
+	ReadStream m_streams[MAX_READ_STREAMS];
+	std::vector<StreamSlot> m_streamSlots;
+	/// Written by readers and consumed by the read thread, both under `m_mtx`
+	std::vector<PrefetchRange> m_prefetchQueue;
+	u64 m_streamClock = 0;
+
+public:
+	struct ReadStats
+	{
+		u64 requests;
+		/// Requests served entirely from the readahead buffers or the stream cache
+		u64 hits;
+		u64 misses;
+		/// Stream cache slots filled by the prefetcher
+		u64 prefetched;
+		/// Prefetched slots that were read at least once
+		u64 prefetchHits;
+		/// Prefetched slots evicted without ever being read
+		u64 prefetchWasted;
+	};
+
+private:
+	ReadStats m_stats = {};
+
 	/// Main loop of read thread
 	void Loop();
 
+	/// Match a request against the tracked streams, and queue prefetches for the ones that are predictable
+	/// Requires `m_mtx`
+	void UpdateReadStreams(u64 offset, u32 size);
+	/// Read queued predictions into the stream cache until the queue runs out or a real request comes in
+	/// Called on the read thread without holding `m_mtx`
+	void PrefetchStreams();
+	/// Get the filled stream cache slot containing `offset`, if there is one
+	/// Requires `m_mtx`
+	StreamSlot* FindStreamSlot(u64 offset);
+	/// Get the end of the readahead buffer containing `offset`, or 0 if there isn't one
+	/// Requires `m_mtx` when called from outside the read thread
+	u64 BufferEnd(u64 offset);
+	/// Get the end of the stream cache slot containing or being filled with `offset`, or 0 if there isn't one
+	/// Requires `m_mtx`
+	u64 StreamCacheEnd(u64 offset);
+	/// Requires `m_mtx`
+	bool IsPrefetchQueued(u64 offset);
+	/// Claim the least recently used stream cache slot for a chunk of `length` bytes
+	/// Requires `m_mtx`
+	StreamSlot* AllocateStreamSlot(u32 length);
+	/// Mark a stream cache slot as read, for the prefetch stats
+	/// Requires `m_mtx`
+	void TouchStreamSlot(StreamSlot& slot);
+	void ClearReadStreams();
+
 	/// Load the given block into one of the `m_buffer` buffers if necessary and return a pointer to its contents if successful
 	Buffer* GetBlockPtr(const Chunk& block);
 	/// Decompress from offset to size into
@@ -114,6 +203,9 @@ public:
 
 	virtual u32 GetBlockCount() const = 0;
 
+	/// Returns a pointer to the given sector if the whole image is available in memory, e.g. through a
+	/// file mapping, so callers can skip the read thread. Valid until the reader is closed or precached.
+	virtual const u8* GetSectorPointer(u32 sector);
 
 	bool Open(std::string filename, Error* error);
 	bool Precache(ProgressCallback* progress, Error* error);
@@ -124,4 +216,9 @@ public:
 	void Close();
 	void SetBlockSize(u32 bytes);
 	void SetDataOffset(u32 bytes);
+
+	/// Cache hit/miss and prefetch counters since the file was opened.
+	ReadStats GetReadStats();
+	/// Wait until the read thread has finished any readahead and queued prefetches.
+	void WaitUntilIdle();
 };
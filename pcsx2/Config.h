@@ -278,6 +278,7 @@ enum class GSRendererType : s8
 	VK = 14,
 	Metal = 17,
 	DX12 = 15,
+	Headless = 18,
 };
 
 enum class GSVSyncMode : u8
@@ -378,7 +379,8 @@ enum class SavestateCompressionMethod : u8
 	Uncompressed = 0,
 	Deflate64 = 1,
 	Zstandard = 2,
-	LZMA2 = 3
+	LZMA2 = 3,
+	ZstandardParallel = 4
 };
 
 enum class SavestateCompressionLevel : u8
@@ -569,7 +571,7 @@ struct Pcsx2Config
 		BITFIELD32()
 		bool
 			Enabled : 1, // universal toggle for the profiler.
-			RecBlocks_EE : 1, // Enables per-block profiling for the EE recompiler [unimplemented]
+			RecBlocks_EE : 1, // Enables per-block profiling for the EE recompiler
 			RecBlocks_IOP : 1, // Enables per-block profiling for the IOP recompiler [unimplemented]
 			RecBlocks_VU0 : 1, // Enables per-block profiling for the VU0 recompiler [unimplemented]
 			RecBlocks_VU1 : 1; // Enables per-block profiling for the VU1 recompiler [unimplemented]
@@ -612,6 +614,10 @@ struct Pcsx2Config
 
 		bool
 			EnableEECache : 1;
+		bool
+			EnableEEBlockCache : 1;
+		bool
+			EnableVUProgramCache : 1;
 		bool
 			EnableFastmem : 1;
 		bool
@@ -690,6 +696,7 @@ struct Pcsx2Config
 			{
 				bool
 					SynchronousMTGS : 1,
+					DynamicMTGSRing : 1,
 					VsyncEnable : 1,
 					DisableMailboxPresentation : 1,
 					ExtendedUpscalingMultipliers : 1,
@@ -723,6 +730,8 @@ struct Pcsx2Config
 					HWSpinCPUForReadbacks : 1,
 					GPUPaletteConversion : 1,
 					AutoFlushSW : 1,
+					SWTileScheduling : 1,
+					SWParallelDrawSetup : 1,
 					PreloadFrameWithGSData : 1,
 					Mipmap : 1,
 					HWMipmap : 1,
@@ -753,6 +762,7 @@ struct Pcsx2Config
 					LoadTextureReplacements : 1,
 					LoadTextureReplacementsAsync : 1,
 					PrecacheTextureReplacements : 1,
+					TextureDiskCache : 1,
 					EnableVideoCapture : 1,
 					EnableVideoCaptureParameters : 1,
 					VideoCaptureAutoResolution : 1,
@@ -817,6 +827,8 @@ struct Pcsx2Config
 		u8 ShadeBoost_Saturation = 50;
 		u8 PNGCompressionLevel = 1;
 
+		u32 TextureDiskCacheSize = 1024; // MB
+
 		u16 SWExtraThreads = 2;
 		u16 SWExtraThreadsHeight = 4;
 
@@ -1248,12 +1260,27 @@ struct Pcsx2Config
 
 	struct SavestateOptions
 	{
+		static constexpr u32 MIN_REWIND_BUFFER_SIZE = 128; // the two uncompressed states take most of this
+		static constexpr u32 MAX_REWIND_BUFFER_SIZE = 4096;
+		static constexpr u32 MAX_RUNAHEAD_FRAMES = 10;
+
 		SavestateOptions();
 		void LoadSave(SettingsWrapper& wrap);
+		void SanityCheck();
+
+		BITFIELD32()
+		bool
+			RewindEnable : 1, // keeps a ring of in-memory states which can be stepped back through
+			LogTimings : 1; // logs per-component sizes and times when saving/loading parallel states
+		BITFIELD_END
 
 		SavestateCompressionMethod CompressionType = SavestateCompressionMethod::Zstandard;
 		SavestateCompressionLevel CompressionRatio = SavestateCompressionLevel::Medium;
 
+		u32 RewindSaveFrequency = 10; // number of frames between rewind states
+		u32 RewindBufferSize = 256; // memory budget for rewind states, including the uncompressed ones, in megabytes
+		u32 RunaheadFrameCount = 0; // number of frames to speculatively run ahead, 0 disables run-ahead
+
 		bool operator==(const SavestateOptions& right) const;
 		bool operator!=(const SavestateOptions& right) const;
 	};
@@ -1265,6 +1292,7 @@ struct Pcsx2Config
 		CdvdVerboseReads : 1, // enables cdvd read activity verbosely dumped to the console
 		CdvdDumpBlocks : 1, // enables cdvd block dumping
 		CdvdPrecache : 1, // enables cdvd precaching of compressed images
+		CdvdMapImages : 1, // serves uncompressed image reads from a file mapping
 		EnablePatches : 1, // enables patch detection and application
 		EnableCheats : 1, // enables cheat detection and application
 		EnablePINE : 1, // enables inter-process communication
@@ -1312,6 +1340,7 @@ struct Pcsx2Config
 	// slots (3 each)
 	McdOptions Mcd[8];
 	std::string GzipIsoIndexTemplate; // for quick-access index with gzipped ISO
+	int GzipIsoIndexSpan; // distance between access points when building a gzip index, in KB
 
 	int PINESlot;
 
@@ -536,7 +536,7 @@ static __fi void VSyncStart(u32 sCycle)
 	// Without the patch and fixing this, the games have other issues, so I'm not going to rush to fix it.
 	// Refraction
 
-	// Bail out before the next frame starts if we're paused, or the CPU has changed.
+	// Bail out before the next frame starts if we're paused, the CPU has changed, or a memory state is due.
 	// Need to re-check this, because we might've paused during the sleep time.
 	if (VMManager::Internal::IsExecutionInterrupted())
 		Cpu->ExitExecution();
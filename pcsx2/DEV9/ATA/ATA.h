@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <thread>
 #include <atomic>
@@ -13,6 +14,7 @@
 #include "common/Path.h"
 
 #include "DEV9/SimpleQueue.h"
+#include "HddIOEngine.h"
 
 class ATA
 {
@@ -27,6 +29,9 @@ private:
 	std::FILE* hddImage = nullptr;
 	u64 hddImageSize;
 
+	//Parallel reads, falls back to hddImage if unavailable
+	HddIOEngine hddReader;
+
 	bool hddSparse = false;
 	u64 hddSparseBlockSize;
 	u64 HddSparseStart;
@@ -105,14 +110,21 @@ private:
 	//Transfer
 	//Write Buffer(s)
 	bool awaitFlush = false;
-	u8* currentWrite; //array
+	std::vector<u8> currentWrite;
 	u32 currentWriteLength;
 	u64 currentWriteSectors;
 
+	//Completed writes are held here, and written out once the drive is idle,
+	//the cache grows too large, or the guest/emulator asks for a flush
+	static constexpr u64 writeCacheLimit = 32 * 1024 * 1024;
+	static constexpr u64 writeFlushBatch = 2 * 1024 * 1024;
+	static constexpr std::chrono::milliseconds writeCacheIdleTime{100};
+	HddWriteCache writeCache;
+	std::chrono::steady_clock::time_point lastCachedWrite;
+
 	struct WriteQueueEntry
 	{
-		u8* data;
-		u32 length;
+		std::vector<u8> data;
 		u64 sector;
 	};
 	SimpleQueue<WriteQueueEntry> writeQueue;
@@ -170,6 +182,8 @@ public:
 	void Write(u32 addr, u16 value, int width);
 
 	void Async(u32 cycles);
+	//Writes out everything in the write cache, and waits for it to complete
+	void FlushWriteCache();
 
 	int ReadDMAToFIFO(u8* buffer, int space);
 	int WriteDMAFromFIFO(u8* buffer, int available);
@@ -212,6 +226,8 @@ private:
 	void IO_Thread();
 	void IO_Read();
 	bool IO_Write();
+	void IO_QueueCachedWrites(u64 maxBytes);
+	void IO_WaitForWrites();
 	bool IO_SparseZero(u64 byteOffset, u64 byteSize);
 	void IO_SparseCacheUpdateLocation(u64 Offset);
 	void IO_SparseCacheLoad();
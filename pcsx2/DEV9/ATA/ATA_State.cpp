@@ -101,6 +101,8 @@ int ATA::Open(const std::string& hddPath)
 
 	InitSparseSupport(hddPath);
 
+	hddReader.Open(hddPath);
+
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioRead = false;
@@ -251,6 +253,14 @@ void ATA::Close()
 	//Wait for async code to finish
 	if (ioRunning)
 	{
+		IO_QueueCachedWrites(UINT64_MAX);
+		if (writeCache.GetWriteCount() != 0)
+		{
+			DevCon.WriteLn("DEV9: ATA: %llu writes cached, written as %llu extents",
+				writeCache.GetWriteCount(), writeCache.GetFlushedExtentCount());
+		}
+		writeCache = {};
+
 		ioClose.store(true);
 		{
 			std::lock_guard ioSignallock(ioMutex);
@@ -286,6 +296,7 @@ void ATA::Close()
 		std::fclose(hddImage);
 		hddImage = nullptr;
 	}
+	hddReader.Close();
 
 	delete[] readBuffer;
 	readBuffer = nullptr;
@@ -543,6 +554,18 @@ void ATA::Async(uint cycles)
 			}
 			ioReady.notify_all();
 		}
+		else if (!writeCache.IsEmpty() &&
+				 (awaitFlush || writeCache.GetDirtyBytes() >= writeCacheLimit ||
+					 std::chrono::steady_clock::now() - lastCachedWrite >= writeCacheIdleTime)) //Write back cache
+		{
+			//Queue a batch at a time, so reads don't have to wait long for writes to complete
+			IO_QueueCachedWrites(writeFlushBatch);
+			{
+				std::lock_guard ioSignallock(ioMutex);
+				ioWrite = true;
+			}
+			ioReady.notify_all();
+		}
 		else if (awaitFlush) //Fire IRQ on flush completion?
 		{
 			//Log_Info("Flush done, raise IRQ");
@@ -68,13 +68,25 @@ void ATA::IO_Read()
 	}
 
 	const u64 pos = lba * 512;
-	if (FileSystem::FSeek64(hddImage, pos, SEEK_SET) != 0 ||
-		std::fread(readBuffer,  512, nsector, hddImage) != static_cast<size_t>(nsector))
+	if (hddReader.IsOpen())
+	{
+		if (!hddReader.Read(readBuffer, pos, static_cast<u64>(nsector) * 512))
+		{
+			Console.Error("DEV9: ATA: File read error");
+			pxAssert(false);
+			abort();
+		}
+	}
+	else if (FileSystem::FSeek64(hddImage, pos, SEEK_SET) != 0 ||
+			 std::fread(readBuffer, 512, nsector, hddImage) != static_cast<size_t>(nsector))
 	{
 		Console.Error("DEV9: ATA: File read error");
 		pxAssert(false);
 		abort();
 	}
+
+	//Writes still in the cache are newer than the image
+	writeCache.Overlay(lba, readBuffer, nsector);
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioRead = false;
@@ -91,6 +103,7 @@ bool ATA::IO_Write()
 		return false;
 	}
 
+	const u32 length = static_cast<u32>(entry.data.size());
 	const u64 imagePos = entry.sector * 512;
 	if (FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
 	{
@@ -101,13 +114,13 @@ bool ATA::IO_Write()
 	if (hddSparse)
 	{
 		u32 written = 0;
-		while (written != entry.length)
+		while (written != length)
 		{
 			IO_SparseCacheUpdateLocation(imagePos + written);
 			// Align to sparse block size.
 			u32 writeSize = hddSparseBlockSize - ((imagePos + written) % hddSparseBlockSize);
 			// Limit to size of write.
-			writeSize = std::min(writeSize, entry.length - written);
+			writeSize = std::min(writeSize, length - written);
 
 			pxAssert(writeSize > 0);
 			pxAssert(writeSize <= hddSparseBlockSize);
@@ -170,17 +183,50 @@ bool ATA::IO_Write()
 	}
 	else
 	{
-		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1 || std::fflush(hddImage) != 0)
+		if (std::fwrite(entry.data.data(), length, 1, hddImage) != 1 || std::fflush(hddImage) != 0)
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
 			abort();
 		}
 	}
-	delete[] entry.data;
 	return true;
 }
 
+void ATA::IO_QueueCachedWrites(u64 maxBytes)
+{
+	std::vector<HddWriteCache::Extent> extents;
+	writeCache.Take(maxBytes, &extents);
+	for (HddWriteCache::Extent& extent : extents)
+	{
+		WriteQueueEntry entry;
+		entry.data = std::move(extent.data);
+		entry.sector = extent.sector;
+		writeQueue.Enqueue(std::move(entry));
+	}
+}
+
+//Starts writing anything queued, and waits for the io thread to finish
+void ATA::IO_WaitForWrites()
+{
+	std::unique_lock ioWaitHandle(ioMutex);
+	if (!writeQueue.IsQueueEmpty())
+	{
+		ioWrite = true;
+		ioReady.notify_all();
+	}
+	ioThreadIdle_cv.wait(ioWaitHandle, [&] { return ioThreadIdle_bool && !ioWrite; });
+}
+
+void ATA::FlushWriteCache()
+{
+	if (!ioRunning)
+		return;
+
+	IO_QueueCachedWrites(UINT64_MAX);
+	IO_WaitForWrites();
+}
+
 void ATA::IO_SparseCacheLoad()
 {
 	// Reads are bounds checked, but for the sectors read only.
@@ -428,29 +474,14 @@ void ATA::HDD_ReadAsync(void (ATA::*drqCMD)())
 //Do one of the other
 void ATA::HDD_ReadSync(void (ATA::*drqCMD)())
 {
-	//unique_lock instead of lock_guard as also used for cv
-	std::unique_lock ioWaitHandle(ioMutex);
-	//Set ioWrite false to prevent reading & writing at the same time
-	const bool ioWritePaused = ioWrite;
-	ioWrite = false;
-
-	//wait until thread waiting
-	ioThreadIdle_cv.wait(ioWaitHandle, [&] { return ioThreadIdle_bool; });
-	ioWaitHandle.unlock();
+	//Writes which have left the write cache aren't visible to reads until written, so finish them first
+	//Writes are only queued in small batches, so this shouldn't take long
+	IO_WaitForWrites();
 
 	nsectorLeft = 0;
 
 	if (!HDD_CanAssessOrSetError())
-	{
-		if (ioWritePaused)
-		{
-			ioWaitHandle.lock();
-			ioWrite = true;
-			ioWaitHandle.unlock();
-			ioReady.notify_all();
-		}
 		return;
-	}
 
 	nsectorLeft = nsector;
 	if (readBufferLen < nsector * 512)
@@ -462,14 +493,6 @@ void ATA::HDD_ReadSync(void (ATA::*drqCMD)())
 
 	IO_Read();
 
-	if (ioWritePaused)
-	{
-		ioWaitHandle.lock();
-		ioWrite = true;
-		ioWaitHandle.unlock();
-		ioReady.notify_all();
-	}
-
 	(this->*drqCMD)();
 }
 
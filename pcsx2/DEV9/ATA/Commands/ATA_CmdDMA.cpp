@@ -34,7 +34,7 @@ void ATA::DRQCmdDMADataFromHost()
 		return;
 
 	nsectorLeft = nsector;
-	currentWrite = new u8[nsector * 512];
+	currentWrite.resize(nsector * 512);
 	currentWriteLength = nsector * 512;
 	currentWriteSectors = HDD_GetLBA();
 
@@ -47,12 +47,8 @@ void ATA::DRQCmdDMADataFromHost()
 }
 void ATA::PostCmdDMADataFromHost()
 {
-	WriteQueueEntry entry{0};
-	entry.data = currentWrite;
-	entry.length = currentWriteLength;
-	entry.sector = currentWriteSectors;
-	writeQueue.Enqueue(entry);
-	currentWrite = nullptr;
+	writeCache.Write(currentWriteSectors, currentWrite.data(), currentWriteLength / 512);
+	lastCachedWrite = std::chrono::steady_clock::now();
 	currentWriteLength = 0;
 	currentWriteSectors = 0;
 	nsectorLeft = 0;
@@ -31,7 +31,7 @@ void ATA::HDD_FlushCache() //Can't when DRQ set
 		return;
 	DevCon.WriteLn("DEV9: HDD_FlushCache");
 
-	if (!writeQueue.IsQueueEmpty())
+	if (!writeQueue.IsQueueEmpty() || !writeCache.IsEmpty())
 	{
 		regStatus |= ATA_STAT_SEEK;
 		awaitFlush = true;
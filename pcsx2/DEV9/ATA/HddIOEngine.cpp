@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "common/Assertions.h"
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Timer.h"
+
+#include "HddIOEngine.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__POSIX__)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+HddIOEngine::~HddIOEngine()
+{
+	Close();
+}
+
+bool HddIOEngine::Open(const std::string& path, u32 numWorkers)
+{
+	Close();
+
+#ifdef _WIN32
+	file = CreateFileW(FileSystem::GetWin32Path(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		Console.Error("DEV9: ATA: Failed to open HDD image for reading: %d", GetLastError());
+		return false;
+	}
+#elif defined(__POSIX__)
+	file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file == -1)
+	{
+		Console.Error("DEV9: ATA: Failed to open HDD image for reading: %d", errno);
+		return false;
+	}
+#endif
+
+	stopping = false;
+	stats = {};
+	for (u32 i = 0; i < std::max(numWorkers, 1u); i++)
+		workers.emplace_back(&HddIOEngine::WorkerThread, this);
+
+	return true;
+}
+
+void HddIOEngine::Close()
+{
+	if (!workers.empty())
+	{
+		{
+			std::lock_guard lock(queueMutex);
+			stopping = true;
+		}
+		queueCv.notify_all();
+		for (std::thread& worker : workers)
+			worker.join();
+		workers.clear();
+
+		if (stats.requests != 0)
+		{
+			DevCon.WriteLn("DEV9: ATA: %llu reads (%llu chunks, %llu on workers, %llu KiB), avg latency %.1f us, worst %llu us",
+				stats.requests, stats.chunks, stats.workerChunks, stats.bytes / 1024,
+				static_cast<double>(stats.totalLatencyUs) / static_cast<double>(stats.requests), stats.maxLatencyUs);
+		}
+	}
+
+#ifdef _WIN32
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(file);
+		file = INVALID_HANDLE_VALUE;
+	}
+#elif defined(__POSIX__)
+	if (file != -1)
+	{
+		close(file);
+		file = -1;
+	}
+#endif
+}
+
+bool HddIOEngine::Read(u8* dest, u64 offset, u64 size)
+{
+	pxAssert(IsOpen());
+	Common::Timer timer;
+
+	//The first chunk is read on the calling thread, so small reads don't wait on a worker
+	const Chunk first = {dest, offset, static_cast<u32>(std::min<u64>(CHUNK_SIZE, size))};
+	const bool queued = size > CHUNK_SIZE;
+	if (queued)
+	{
+		{
+			std::lock_guard lock(queueMutex);
+			failed = false;
+			for (u64 done = CHUNK_SIZE; done < size; done += CHUNK_SIZE)
+			{
+				queue.push_back({dest + done, offset + done, static_cast<u32>(std::min<u64>(CHUNK_SIZE, size - done))});
+				pending++;
+				stats.chunks++;
+				stats.workerChunks++;
+			}
+		}
+		queueCv.notify_all();
+	}
+
+	bool success = ReadChunk(first);
+	stats.chunks++;
+
+	if (queued)
+	{
+		std::unique_lock lock(queueMutex);
+		doneCv.wait(lock, [this] { return pending == 0; });
+		success &= !failed;
+	}
+
+	const u64 latency = static_cast<u64>(timer.GetTimeMilliseconds() * 1000.0);
+	stats.requests++;
+	stats.bytes += size;
+	stats.totalLatencyUs += latency;
+	stats.maxLatencyUs = std::max(stats.maxLatencyUs, latency);
+	return success;
+}
+
+void HddIOEngine::WorkerThread()
+{
+	std::unique_lock lock(queueMutex);
+	while (true)
+	{
+		queueCv.wait(lock, [this] { return stopping || !queue.empty(); });
+		if (queue.empty())
+			return;
+
+		const Chunk chunk = queue.front();
+		queue.pop_front();
+		lock.unlock();
+
+		const bool success = ReadChunk(chunk);
+
+		lock.lock();
+		failed |= !success;
+		if (--pending == 0)
+			doneCv.notify_one();
+	}
+}
+
+bool HddIOEngine::ReadChunk(const Chunk& chunk)
+{
+	u32 done = 0;
+	while (done < chunk.size)
+	{
+		const u64 pos = chunk.offset + done;
+#ifdef _WIN32
+		//The handle isn't opened for overlapped IO, so this is a positioned synchronous read
+		OVERLAPPED ov = {};
+		ov.Offset = static_cast<DWORD>(pos);
+		ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+		DWORD read;
+		if (!ReadFile(file, chunk.dest + done, chunk.size - done, &read, &ov) || read == 0)
+		{
+			Console.Error("DEV9: ATA: File read error: %d", GetLastError());
+			return false;
+		}
+#elif defined(__POSIX__)
+		const ssize_t read = pread(file, chunk.dest + done, chunk.size - done, static_cast<off_t>(pos));
+		if (read == -1 && errno == EINTR)
+			continue;
+		if (read <= 0)
+		{
+			Console.Error("DEV9: ATA: File read error: %d", read == 0 ? 0 : errno);
+			return false;
+		}
+#endif
+		done += static_cast<u32>(read);
+	}
+	return true;
+}
+
+void HddWriteCache::Write(u64 sector, const u8* data, u32 sectors)
+{
+	const auto extentEnd = [](const auto& it) { return it->first + it->second.size() / SECTOR_SIZE; };
+
+	writes++;
+	const u64 end = sector + sectors;
+
+	//Find the first extent which overlaps or touches the write
+	auto first = extents.upper_bound(sector);
+	if (first != extents.begin() && extentEnd(std::prev(first)) >= sector)
+		--first;
+
+	if (first == extents.end() || first->first > end)
+	{
+		extents.emplace_hint(first, sector, std::vector<u8>(data, data + static_cast<size_t>(sectors) * SECTOR_SIZE));
+		dirtyBytes += static_cast<u64>(sectors) * SECTOR_SIZE;
+		return;
+	}
+
+	auto last = first;
+	while (std::next(last) != extents.end() && std::next(last)->first <= end)
+		++last;
+
+	const u64 mergedStart = std::min(sector, first->first);
+	const u64 mergedEnd = std::max(end, extentEnd(last));
+
+	//Sequential writes extend the first extent, which can be reused rather than copied
+	std::vector<u8> merged;
+	auto copyFrom = first;
+	if (first->first == mergedStart)
+	{
+		dirtyBytes -= first->second.size();
+		merged = std::move(first->second);
+		++copyFrom;
+	}
+	merged.resize((mergedEnd - mergedStart) * SECTOR_SIZE);
+
+	for (auto it = copyFrom; it != std::next(last); ++it)
+	{
+		std::memcpy(&merged[(it->first - mergedStart) * SECTOR_SIZE], it->second.data(), it->second.size());
+		dirtyBytes -= it->second.size();
+	}
+	std::memcpy(&merged[(sector - mergedStart) * SECTOR_SIZE], data, static_cast<size_t>(sectors) * SECTOR_SIZE);
+
+	extents.erase(first, std::next(last));
+	dirtyBytes += merged.size();
+	extents.emplace(mergedStart, std::move(merged));
+}
+
+void HddWriteCache::Overlay(u64 sector, u8* data, u32 sectors) const
+{
+	if (extents.empty())
+		return;
+
+	const u64 end = sector + sectors;
+	auto it = extents.upper_bound(sector);
+	if (it != extents.begin())
+		--it;
+
+	for (; it != extents.end() && it->first < end; ++it)
+	{
+		const u64 extentEnd = it->first + it->second.size() / SECTOR_SIZE;
+		const u64 copyStart = std::max(sector, it->first);
+		const u64 copyEnd = std::min(end, extentEnd);
+		if (copyStart >= copyEnd)
+			continue;
+
+		std::memcpy(&data[(copyStart - sector) * SECTOR_SIZE], &it->second[(copyStart - it->first) * SECTOR_SIZE],
+			(copyEnd - copyStart) * SECTOR_SIZE);
+	}
+}
+
+void HddWriteCache::Take(u64 maxBytes, std::vector<Extent>* taken)
+{
+	u64 takenBytes = 0;
+	while (!extents.empty() && takenBytes < maxBytes)
+	{
+		auto node = extents.extract(extents.begin());
+		takenBytes += node.mapped().size();
+		dirtyBytes -= node.mapped().size();
+		flushedExtents++;
+		taken->push_back({node.key(), std::move(node.mapped())});
+	}
+}
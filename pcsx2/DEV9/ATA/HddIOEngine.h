@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/Pcsx2Defs.h"
+#include "common/RedtapeWindows.h"
+
+//Reads from the HDD image with several requests in flight at once
+//Large transfers are split into chunks, which are read in parallel by a pool of worker threads
+//Uses its own read only handle to the image, so reads don't disturb the file position of the writer
+class HddIOEngine
+{
+public:
+	struct Stats
+	{
+		u64 requests = 0;
+		u64 chunks = 0;
+		//Chunks handed to the worker threads, rather than read on the calling thread
+		u64 workerChunks = 0;
+		u64 bytes = 0;
+		u64 totalLatencyUs = 0;
+		u64 maxLatencyUs = 0;
+	};
+
+	static constexpr u32 DEFAULT_WORKERS = 4;
+	//A quarter of the largest LBA28 transfer (256 sectors), so big transfers are spread over the workers
+	static constexpr u32 CHUNK_SIZE = 32 * 1024;
+
+private:
+	struct Chunk
+	{
+		u8* dest;
+		u64 offset;
+		u32 size;
+	};
+
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+#elif defined(__POSIX__)
+	int file = -1;
+#endif
+
+	std::vector<std::thread> workers;
+	std::mutex queueMutex;
+	std::condition_variable queueCv;
+	std::condition_variable doneCv;
+	std::deque<Chunk> queue;
+	u32 pending = 0;
+	bool failed = false;
+	bool stopping = false;
+
+	Stats stats;
+
+public:
+	HddIOEngine() = default;
+	~HddIOEngine();
+
+	HddIOEngine(const HddIOEngine&) = delete;
+	HddIOEngine& operator=(const HddIOEngine&) = delete;
+
+	bool Open(const std::string& path, u32 numWorkers = DEFAULT_WORKERS);
+	void Close();
+	bool IsOpen() const { return !workers.empty(); }
+
+	//Reads size bytes at offset, blocks until all chunks have completed
+	//Only one thread may issue reads at a time
+	bool Read(u8* dest, u64 offset, u64 size);
+
+	const Stats& GetStats() const { return stats; }
+
+private:
+	void WorkerThread();
+	bool ReadChunk(const Chunk& chunk);
+};
+
+//Write back cache for guest writes to the HDD
+//Holds dirty sectors as non-overlapping extents, with adjacent and overlapping writes merged together,
+//so streaming writes reach the image as a few large writes instead of many small ones
+//Not thread safe, owned by the thread emulating the ATA device
+class HddWriteCache
+{
+public:
+	static constexpr u32 SECTOR_SIZE = 512;
+
+	struct Extent
+	{
+		u64 sector;
+		std::vector<u8> data;
+	};
+
+private:
+	//Keyed by first sector
+	std::map<u64, std::vector<u8>> extents;
+	u64 dirtyBytes = 0;
+
+	u64 writes = 0;
+	u64 flushedExtents = 0;
+
+public:
+	void Write(u64 sector, const u8* data, u32 sectors);
+	//Copies any dirty sectors in the range over data read from the image
+	void Overlay(u64 sector, u8* data, u32 sectors) const;
+
+	//Removes extents, lowest sector first, until at least maxBytes have been taken or the cache is empty
+	void Take(u64 maxBytes, std::vector<Extent>* taken);
+
+	bool IsEmpty() const { return extents.empty(); }
+	u64 GetDirtyBytes() const { return dirtyBytes; }
+	size_t GetExtentCount() const { return extents.size(); }
+
+	u64 GetWriteCount() const { return writes; }
+	u64 GetFlushedExtentCount() const { return flushedExtents; }
+};
@@ -1127,6 +1127,12 @@ void DEV9async(u32 cycles)
 	dev9.ata->Async(cycles);
 }
 
+void DEV9flushHDD()
+{
+	if (isRunning)
+		dev9.ata->FlushWriteCache();
+}
+
 void DEV9CheckChanges(const Pcsx2Config& old_config)
 {
 	if (!isRunning)
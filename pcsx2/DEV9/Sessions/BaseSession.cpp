@@ -3,6 +3,8 @@
 
 #include "BaseSession.h"
 
+#include <algorithm>
+
 namespace Sessions
 {
 	bool ConnectionKey::operator==(const ConnectionKey& other) const
@@ -36,4 +38,13 @@ namespace Sessions
 		for (size_t i = 0; i < Handlers.size(); i++)
 			Handlers[i](this);
 	}
+
+	u8* BaseSession::GetRecvBuffer(size_t size)
+	{
+		// Recv() is only called from the rx thread, but keep it per thread to be safe
+		thread_local std::vector<u8> buffer;
+		if (buffer.size() < size || buffer.empty())
+			buffer.resize(std::max<size_t>(size, 1));
+		return buffer.data();
+	}
 } // namespace Sessions
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "DEV9/PacketReader/IP/IP_Packet.h"
+#include "DEV9/Sessions/SessionSocket.h"
 #include <functional>
 #include <optional>
 #include <vector>
@@ -53,10 +54,19 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload) = 0;
 		virtual void Reset() = 0;
 
+		// Recv() is only called when the socket returned here is readable, when NeedsPolling() returns true,
+		// and periodically for idle timeouts. Sessions which don't know better are polled every time.
+		virtual SessionSocket GetRecvSocket() { return INVALID_SOCKET; }
+		virtual bool NeedsPolling() { return true; }
+
 		virtual ~BaseSession() {}
 
 	protected:
 		void RaiseEventConnectionClosed();
+
+		// Scratch buffer for reading from sockets, reused between packets
+		// Only to be used from within Recv()
+		static u8* GetRecvBuffer(size_t size);
 	};
 } // namespace Sessions
 
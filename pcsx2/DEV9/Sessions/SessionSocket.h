@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#ifdef _WIN32
+#include <winsock2.h>
+#elif defined(__POSIX__)
+#define INVALID_SOCKET -1
+#endif
+
+namespace Sessions
+{
+#ifdef _WIN32
+	typedef SOCKET SessionSocket;
+#elif defined(__POSIX__)
+	typedef int SessionSocket;
+#endif
+} // namespace Sessions
@@ -152,6 +152,22 @@ namespace Sessions
 		RaiseEventConnectionClosed();
 	}
 
+	SessionSocket TCP_Session::GetRecvSocket()
+	{
+		// Only read data in these states, see Recv()
+		if (state == TCP_State::Connected || state == TCP_State::Closing_ClosedByPS2)
+			return client;
+		return INVALID_SOCKET;
+	}
+
+	bool TCP_Session::NeedsPolling()
+	{
+		// Packets queued by the send thread, or waiting for connect() to complete
+		return _recvBuff.CanDequeue() ||
+			   state == TCP_State::SendingSYN_ACK ||
+			   state == TCP_State::CloseCompletedFlushBuffer;
+	}
+
 	TCP_Session::~TCP_Session()
 	{
 		CloseSocket();
@@ -7,11 +7,6 @@
 #include <mutex>
 #include <tuple>
 #include <vector>
-#ifdef _WIN32
-#include <winsock2.h>
-#elif defined(__POSIX__)
-#define INVALID_SOCKET -1
-#endif
 
 #include "DEV9/SimpleQueue.h"
 #include "DEV9/Sessions/BaseSession.h"
@@ -81,6 +76,9 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
+		virtual SessionSocket GetRecvSocket();
+		virtual bool NeedsPolling();
+
 		virtual ~TCP_Session();
 
 	private:
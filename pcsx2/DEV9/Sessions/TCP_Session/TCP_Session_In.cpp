@@ -84,7 +84,7 @@ namespace Sessions
 
 		if (maxSize > 0)
 		{
-			std::unique_ptr<u8[]> buffer;
+			u8* buffer;
 			int err = 0;
 			int recived;
 
@@ -101,8 +101,8 @@ namespace Sessions
 				if (available > static_cast<uint>(maxSize))
 					Console.WriteLn("DEV9: TCP: Got a lot of data: %lu using: %d", available, maxSize);
 
-				buffer = std::make_unique<u8[]>(maxSize);
-				recived = recv(client, reinterpret_cast<char*>(buffer.get()), maxSize, 0);
+				buffer = GetRecvBuffer(maxSize);
+				recived = recv(client, reinterpret_cast<char*>(buffer), maxSize, 0);
 				if (recived == -1)
 #ifdef _WIN32
 					err = WSAGetLastError();
@@ -166,7 +166,7 @@ namespace Sessions
 				DevCon.WriteLn("DEV9: TCP: [SRV] Sending %d bytes", recived);
 
 				PayloadData* recivedData = new PayloadData(recived);
-				memcpy(recivedData->data.get(), buffer.get(), recived);
+				memcpy(recivedData->data.get(), buffer, recived);
 
 				std::unique_ptr<TCP_Packet> iRet = CreateBasePacket(recivedData);
 				IncrementMyNumber((u32)recived);
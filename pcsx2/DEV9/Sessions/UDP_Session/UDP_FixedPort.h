@@ -4,10 +4,7 @@
 #pragma once
 #include <atomic>
 #include <mutex>
-#ifdef _WIN32
-#include <winsock2.h>
-#elif defined(__POSIX__)
-#define INVALID_SOCKET -1
+#ifdef __POSIX__
 #include <sys/socket.h>
 #endif
 
@@ -44,6 +41,9 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
+		virtual SessionSocket GetRecvSocket();
+		virtual bool NeedsPolling();
+
 		UDP_Session* NewClientSession(ConnectionKey parNewKey, bool parIsBrodcast, bool parIsMulticast);
 
 		virtual ~UDP_FixedPort();
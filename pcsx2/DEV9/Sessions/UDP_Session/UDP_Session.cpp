@@ -121,7 +121,7 @@ namespace Sessions
 		{
 			unsigned long available = 0;
 			PayloadData* recived = nullptr;
-			std::unique_ptr<u8[]> buffer;
+			u8* buffer = nullptr;
 			sockaddr_in endpoint{};
 
 			// FIONREAD returns total size of all available messages
@@ -133,14 +133,14 @@ namespace Sessions
 #endif
 			if (ret != SOCKET_ERROR)
 			{
-				buffer = std::make_unique<u8[]>(available);
+				buffer = GetRecvBuffer(available);
 
 #ifdef _WIN32
 				int fromlen = sizeof(endpoint);
 #elif defined(__POSIX__)
 				socklen_t fromlen = sizeof(endpoint);
 #endif
-				ret = recvfrom(client, reinterpret_cast<char*>(buffer.get()), available, 0, reinterpret_cast<sockaddr*>(&endpoint), &fromlen);
+				ret = recvfrom(client, reinterpret_cast<char*>(buffer), available, 0, reinterpret_cast<sockaddr*>(&endpoint), &fromlen);
 			}
 
 			if (ret == SOCKET_ERROR)
@@ -156,7 +156,7 @@ namespace Sessions
 			}
 
 			recived = new PayloadData(ret);
-			memcpy(recived->data.get(), buffer.get(), ret);
+			memcpy(recived->data.get(), buffer, ret);
 
 			std::unique_ptr<UDP_Packet> iRet = std::make_unique<UDP_Packet>(recived);
 			iRet->destinationPort = srcPort;
@@ -365,6 +365,19 @@ namespace Sessions
 		RaiseEventConnectionClosed();
 	}
 
+	SessionSocket UDP_Session::GetRecvSocket()
+	{
+		// Fixed port sessions are fed by their UDP_FixedPort, and only check for idle here
+		if (isFixedPort || !open.load())
+			return INVALID_SOCKET;
+		return client;
+	}
+
+	bool UDP_Session::NeedsPolling()
+	{
+		return false;
+	}
+
 	UDP_Session::~UDP_Session()
 	{
 		open.store(false);
@@ -4,10 +4,7 @@
 #pragma once
 #include <atomic>
 #include <chrono>
-#ifdef _WIN32
-#include <winsock2.h>
-#elif defined(__POSIX__)
-#define INVALID_SOCKET -1
+#ifdef __POSIX__
 #include <sys/socket.h>
 #endif
 
@@ -51,6 +48,9 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
+		virtual SessionSocket GetRecvSocket();
+		virtual bool NeedsPolling();
+
 		virtual ~UDP_Session();
 	};
 } // namespace Sessions
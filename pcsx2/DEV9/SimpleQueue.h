@@ -23,6 +23,15 @@ private:
 	std::atomic<SimpleQueueEntry*> head{nullptr};
 	SimpleQueueEntry* tail = nullptr;
 
+	//Dequeued entries are handed back to the queue thread to reuse, instead of
+	//allocating and freeing one for every packet
+	std::atomic<SimpleQueueEntry*> freeEntries{nullptr};
+	//Only touched by the queue thread
+	SimpleQueueEntry* freeCache = nullptr;
+
+	SimpleQueueEntry* AllocateEntry();
+	static void DeleteEntries(SimpleQueueEntry* entry);
+
 public:
 	SimpleQueue();
 
@@ -30,6 +39,8 @@ public:
 	void Enqueue(T entry);
 	//Used by single worker thread (i.e. IO)
 	bool Dequeue(T* entry);
+	//Used by single worker thread, true if Dequeue() would succeed
+	bool CanDequeue();
 	//May return false negative when another thread is mid Queue()
 	//Intended to only be used from queue thread
 	bool IsQueueEmpty();
@@ -44,11 +55,38 @@ SimpleQueue<T>::SimpleQueue()
 	head.store(tail);
 }
 
+template <class T>
+typename SimpleQueue<T>::SimpleQueueEntry* SimpleQueue<T>::AllocateEntry()
+{
+	//Take everything the worker thread has freed since last time
+	if (freeCache == nullptr)
+		freeCache = freeEntries.exchange(nullptr, std::memory_order_acquire);
+
+	if (freeCache == nullptr)
+		return new SimpleQueueEntry();
+
+	SimpleQueueEntry* entry = freeCache;
+	freeCache = entry->next;
+	entry->ready.store(false, std::memory_order_relaxed);
+	return entry;
+}
+
+template <class T>
+void SimpleQueue<T>::DeleteEntries(SimpleQueueEntry* entry)
+{
+	while (entry != nullptr)
+	{
+		SimpleQueueEntry* next = entry->next;
+		delete entry;
+		entry = next;
+	}
+}
+
 template <class T>
 void SimpleQueue<T>::Enqueue(T entry)
 {
 	//Allocate Next entry, and assign to head
-	SimpleQueueEntry* newHead = new SimpleQueueEntry();
+	SimpleQueueEntry* newHead = AllocateEntry();
 	SimpleQueueEntry* newEntry = head.exchange(newHead);
 
 	//Fill in
@@ -69,10 +107,21 @@ bool SimpleQueue<T>::Dequeue(T* entry)
 	tail = retEntry->next;
 
 	*entry = std::move(retEntry->value);
-	delete retEntry;
+
+	//Only the queue thread takes entries off the free list, and it takes all of them at once
+	retEntry->next = freeEntries.load(std::memory_order_relaxed);
+	while (!freeEntries.compare_exchange_weak(retEntry->next, retEntry, std::memory_order_release, std::memory_order_relaxed))
+		;
+
 	return true;
 }
 
+template <class T>
+bool SimpleQueue<T>::CanDequeue()
+{
+	return tail->ready.load();
+}
+
 //Note, next entry may not be ready to dequeue
 template <class T>
 bool SimpleQueue<T>::IsQueueEmpty()
@@ -100,4 +149,8 @@ SimpleQueue<T>::~SimpleQueue()
 		head = nullptr;
 		tail = nullptr;
 	}
+
+	DeleteEntries(freeEntries.exchange(nullptr));
+	DeleteEntries(freeCache);
+	freeCache = nullptr;
 }
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "common/Console.h"
+
+#include "SocketPoller.h"
+
+#ifdef DEV9_SOCKET_POLLER_EPOLL
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+using namespace Sessions;
+
+SocketPoller::SocketPoller()
+{
+#ifdef DEV9_SOCKET_POLLER_EPOLL
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (epollFd == -1)
+		Console.Error("DEV9: Socket: epoll_create1 failed: %d", errno);
+#endif
+}
+
+SocketPoller::~SocketPoller()
+{
+#ifdef DEV9_SOCKET_POLLER_EPOLL
+	if (epollFd != -1)
+		::close(epollFd);
+#endif
+}
+
+bool SocketPoller::IsInitialised() const
+{
+#ifdef DEV9_SOCKET_POLLER_EPOLL
+	return epollFd != -1;
+#else
+	return true;
+#endif
+}
+
+void SocketPoller::Add(SessionSocket socket, const ConnectionKey& key)
+{
+	auto it = sockets.find(socket);
+	if (it != sockets.end())
+	{
+		if (it->second == key)
+			return;
+		it->second = key;
+	}
+	else
+		sockets.emplace(socket, key);
+
+#ifdef DEV9_SOCKET_POLLER_EPOLL
+	epoll_event ev{};
+	ev.events = EPOLLIN | EPOLLPRI;
+	ev.data.fd = socket;
+	// The old socket might still be registered if it was closed while another descriptor referenced it
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &ev) == -1 &&
+		(errno != EEXIST || epoll_ctl(epollFd, EPOLL_CTL_MOD, socket, &ev) == -1))
+	{
+		Console.Error("DEV9: Socket: epoll_ctl failed: %d", errno);
+		sockets.erase(socket);
+	}
+#else
+	for (const pollfd& pfd : pollFds)
+	{
+		if (pfd.fd == socket)
+			return;
+	}
+
+	pollfd pfd{};
+	pfd.fd = socket;
+	pfd.events = POLLIN | POLLPRI;
+	pollFds.push_back(pfd);
+#endif
+}
+
+void SocketPoller::Remove(const ConnectionKey& key)
+{
+	for (auto it = sockets.begin(); it != sockets.end();)
+	{
+		if (it->second != key)
+		{
+			++it;
+			continue;
+		}
+
+		const SessionSocket socket = it->first;
+		it = sockets.erase(it);
+
+#ifdef DEV9_SOCKET_POLLER_EPOLL
+		// Fails if the socket was already closed, which is fine
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, socket, nullptr);
+#else
+		for (size_t i = 0; i < pollFds.size(); i++)
+		{
+			if (pollFds[i].fd == socket)
+			{
+				pollFds[i] = pollFds.back();
+				pollFds.pop_back();
+				break;
+			}
+		}
+#endif
+	}
+}
+
+void SocketPoller::Wait(int timeoutMs, std::vector<ConnectionKey>* ready)
+{
+	if (sockets.empty())
+		return;
+
+#ifdef DEV9_SOCKET_POLLER_EPOLL
+	epoll_event events[64];
+	const int count = epoll_wait(epollFd, events, std::size(events), timeoutMs);
+	if (count == -1)
+	{
+		if (errno != EINTR)
+			Console.Error("DEV9: Socket: epoll_wait failed: %d", errno);
+		return;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		auto it = sockets.find(events[i].data.fd);
+		if (it != sockets.end())
+			ready->push_back(it->second);
+	}
+#else
+#ifdef _WIN32
+	// Windows has no poll(), but WSAPoll() works the same way for our use
+	const int count = WSAPoll(pollFds.data(), static_cast<ULONG>(pollFds.size()), timeoutMs);
+#else
+	const int count = poll(pollFds.data(), pollFds.size(), timeoutMs);
+#endif
+	if (count <= 0)
+		return;
+
+	for (size_t i = 0; i < pollFds.size();)
+	{
+		const pollfd& pfd = pollFds[i];
+		if (pfd.revents & POLLNVAL)
+		{
+			// Closed by its session
+			sockets.erase(pfd.fd);
+			pollFds[i] = pollFds.back();
+			pollFds.pop_back();
+			continue;
+		}
+
+		if (pfd.revents != 0)
+		{
+			auto it = sockets.find(pfd.fd);
+			if (it != sockets.end())
+				ready->push_back(it->second);
+		}
+		i++;
+	}
+#endif
+}
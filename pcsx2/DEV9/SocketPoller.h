@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#elif defined(__POSIX__)
+#include <poll.h>
+#endif
+
+#include "Sessions/BaseSession.h"
+
+#if defined(__linux__)
+#define DEV9_SOCKET_POLLER_EPOLL
+#endif
+
+// Waits on the sockets of many sessions at once, so only sessions with data need to be serviced
+// Uses epoll where available, and poll()/WSAPoll() otherwise
+// Not thread safe, to be used from the rx thread only
+class SocketPoller
+{
+	int epollFd = -1;
+	std::vector<pollfd> pollFds;
+
+	// Sockets are closed by their session without telling us, the adapter removes them by key instead
+	// epoll forgets closed sockets itself, poll() reports them as invalid
+	std::unordered_map<Sessions::SessionSocket, Sessions::ConnectionKey> sockets;
+
+public:
+	SocketPoller();
+	~SocketPoller();
+
+	bool IsInitialised() const;
+
+	// Adds the socket if it isn't already waited on for this key
+	void Add(Sessions::SessionSocket socket, const Sessions::ConnectionKey& key);
+	// Removes any socket added for this key, to be called once the session has closed
+	void Remove(const Sessions::ConnectionKey& key);
+
+	// Waits up to timeoutMs for sockets to become readable, and appends their keys
+	// Errors are reported as readable, so the session can pick them up
+	void Wait(int timeoutMs, std::vector<Sessions::ConnectionKey>* ready);
+
+	size_t GetCount() const { return sockets.size(); }
+};
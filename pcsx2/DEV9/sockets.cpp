@@ -211,10 +211,14 @@ bool SocketAdapter::recv(NetPacket* pkt)
 	EthernetFrame* bFrame;
 	if (!vRecBuffer.Dequeue(&bFrame))
 	{
-		std::vector<ConnectionKey> keys = connections.GetKeys();
-		for (size_t i = 0; i < keys.size(); i++)
+		//Finish the sessions found last time before looking again, so busy sessions don't starve the rest
+		if (readySessions.empty())
+			FindReadySessions();
+
+		while (!readySessions.empty())
 		{
-			const ConnectionKey key = keys[i];
+			const ConnectionKey key = readySessions.back();
+			readySessions.pop_back();
 
 			BaseSession* session;
 			if (!connections.TryGetValue(key, &session))
@@ -250,6 +254,40 @@ bool SocketAdapter::recv(NetPacket* pkt)
 	return false;
 }
 
+void SocketAdapter::FindReadySessions()
+{
+	{
+		std::lock_guard lock(closedKeysMutex);
+		for (const ConnectionKey& key : closedKeys)
+			poller.Remove(key);
+		closedKeys.clear();
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	//Poll everything if the poller couldn't be created
+	const bool sweep = (now - lastSweep) >= SWEEP_INTERVAL || !poller.IsInitialised();
+	if (sweep)
+		lastSweep = now;
+
+	connections.GetEntries(&sessionEntries);
+	for (const auto& [key, session] : sessionEntries)
+	{
+		if (sweep || session->NeedsPolling())
+		{
+			readySessions.push_back(key);
+			continue;
+		}
+
+		const SessionSocket socket = session->GetRecvSocket();
+		if (socket != INVALID_SOCKET)
+			poller.Add(socket, key);
+	}
+
+	//Everything was added above
+	if (!sweep)
+		poller.Wait(0, &readySessions);
+}
+
 bool SocketAdapter::send(NetPacket* pkt)
 {
 	InspectSend(pkt);
@@ -539,6 +577,11 @@ void SocketAdapter::HandleConnectionClosed(BaseSession* sender)
 	const ConnectionKey key = sender->key;
 	connections.Remove(key);
 
+	{
+		std::lock_guard lock(closedKeysMutex);
+		closedKeys.push_back(key);
+	}
+
 	// Defer deleting the connection untill we have left the calling session's callstack
 	if (std::this_thread::get_id() == sendThreadId)
 		deleteQueueSendThread.push_back(sender);
@@ -571,6 +614,11 @@ void SocketAdapter::HandleFixedPortClosed(BaseSession* sender)
 	connections.Remove(key);
 	fixedUDPPorts.Remove(key.ps2Port);
 
+	{
+		std::lock_guard lock(closedKeysMutex);
+		closedKeys.push_back(key);
+	}
+
 	// Defer deleting the connection untill we have left the calling session's callstack
 	if (std::this_thread::get_id() == sendThreadId)
 		deleteQueueSendThread.push_back(sender);
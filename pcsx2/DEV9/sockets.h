@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #pragma once
+#include <chrono>
+#include <mutex>
 #include <vector>
 
 #include "net.h"
@@ -10,6 +12,7 @@
 #include "PacketReader/EthernetFrame.h"
 #include "Sessions/BaseSession.h"
 #include "SimpleQueue.h"
+#include "SocketPoller.h"
 #include "ThreadSafeMap.h"
 
 class SocketAdapter : public NetAdapter
@@ -32,6 +35,18 @@ class SocketAdapter : public NetAdapter
 	std::vector<Sessions::BaseSession*> deleteQueueSendThread;
 	std::vector<Sessions::BaseSession*> deleteQueueRecvThread;
 
+	//Only sessions with a readable socket or other work are passed to Recv()
+	//Everything else is checked once per SWEEP_INTERVAL, for idle timeouts
+	static constexpr std::chrono::milliseconds SWEEP_INTERVAL{1000};
+	SocketPoller poller;
+	std::vector<std::pair<Sessions::ConnectionKey, Sessions::BaseSession*>> sessionEntries;
+	std::vector<Sessions::ConnectionKey> readySessions;
+	std::chrono::steady_clock::time_point lastSweep;
+
+	//Closed sessions can be on either thread, the recv thread removes them from the poller
+	std::mutex closedKeysMutex;
+	std::vector<Sessions::ConnectionKey> closedKeys;
+
 public:
 	SocketAdapter();
 	virtual bool blocks();
@@ -48,6 +63,8 @@ public:
 	static AdapterOptions GetAdapterOptions();
 
 private:
+	void FindReadySessions();
+
 	bool SendIP(PacketReader::IP::IP_Packet* ipPkt);
 	bool SendICMP(Sessions::ConnectionKey Key, PacketReader::IP::IP_Packet* ipPkt);
 	bool SendIGMP(Sessions::ConnectionKey Key, PacketReader::IP::IP_Packet* ipPkt);
@@ -331,7 +331,7 @@ void gsPostVsyncStart()
 
 	const bool registers_written = s_GSRegistersWritten;
 	s_GSRegistersWritten = false;
-	MTGS::PostVsyncStart(registers_written);
+	MTGS::PostVsyncStart(registers_written, VMManager::Internal::IsReplayingRunaheadFrames());
 }
 
 bool SaveStateBase::gsFreeze()
@@ -17,8 +17,10 @@
 #include "Input/InputManager.h"
 #include "MTGS.h"
 #include "pcsx2/GS.h"
+#include "GS/Renderers/Null/GSDeviceHeadless.h"
 #include "GS/Renderers/Null/GSRendererNull.h"
 #include "GS/Renderers/HW/GSRendererHW.h"
+#include "GS/Renderers/HW/GSTextureDiskCache.h"
 #include "GS/Renderers/HW/GSTextureReplacements.h"
 #include "VMManager.h"
 
@@ -98,6 +100,9 @@ static RenderAPI GetAPIForRenderer(GSRendererType renderer)
 			return RenderAPI::Metal;
 #endif
 
+		case GSRendererType::Headless:
+			return RenderAPI::None;
+
 			// We could end up here if we ever removed a renderer.
 		default:
 			return GetAPIForRenderer(GSUtil::GetPreferredRenderer());
@@ -135,6 +140,10 @@ static bool OpenGSDevice(GSRendererType renderer, bool clear_state_on_fail, bool
 			break;
 #endif
 
+		case RenderAPI::None:
+			g_gs_device = std::make_unique<GSDeviceHeadless>();
+			break;
+
 		default:
 			Console.Error("Unsupported render API %s", GSDevice::RenderAPIToString(new_api));
 			return false;
@@ -228,6 +237,7 @@ static bool OpenGSRenderer(GSRendererType renderer, u8* basemem)
 static void CloseGSRenderer()
 {
 	GSTextureReplacements::Shutdown();
+	GSTextureDiskCache::Shutdown();
 
 	if (g_gs_renderer)
 	{
@@ -433,12 +443,12 @@ void GSgifTransfer3(u8* mem, u32 size)
 	g_gs_renderer->Transfer<2>(const_cast<u8*>(mem), size);
 }
 
-void GSvsync(u32 field, bool registers_written)
+void GSvsync(u32 field, bool registers_written, bool skip_present)
 {
 	// Do not move the flush into the VSync() method. It's here because EE transfers
 	// get cleared in HW VSync, and may be needed for a buffered draw (FFX FMVs).
 	g_gs_renderer->Flush(GSState::VSYNC);
-	g_gs_renderer->VSync(field, registers_written, g_gs_renderer->IsIdleFrame());
+	g_gs_renderer->VSync(field, registers_written, g_gs_renderer->IsIdleFrame(), skip_present);
 }
 
 int GSfreeze(FreezeAction mode, freezeData* data)
@@ -514,6 +524,9 @@ void GSGameChanged()
 	if (GSIsHardwareRenderer())
 		GSTextureReplacements::GameChanged();
 
+	if (g_gs_renderer)
+		g_gs_renderer->GameChanged();
+
 	if (!VMManager::HasValidVM() && GSCapture::IsCapturing())
 		GSCapture::EndCapture();
 }
@@ -673,14 +686,17 @@ void GSgetStats(SmallStringBase& info)
 			prefix = '\0';
 		}
 
-		info.format("{} SW | {} SP | {} P | {} D | {:.2f} S | {:.2f} U | {:.2f} {}pps",
+		info.format("{} SW | {} SP | {} P | {} D | {:.2f} S | {:.2f} U | {:.2f} {}pps | {} JH | {} JW | {} JC",
 			api_name,
 			(int)pm.Get(GSPerfMon::SyncPoint),
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
 			pm.Get(GSPerfMon::Swizzle) / 1024,
 			pm.Get(GSPerfMon::Unswizzle) / 1024,
-			pps,prefix);
+			pps,prefix,
+			(int)std::ceil(pm.Get(GSPerfMon::SWJitHits)),
+			(int)std::ceil(pm.Get(GSPerfMon::SWJitPrecompiled)),
+			(int)std::ceil(pm.Get(GSPerfMon::SWJitCompiles)));
 	}
 	else if (GSCurrentRenderer == GSRendererType::Null)
 	{
@@ -698,6 +714,13 @@ void GSgetStats(SmallStringBase& info)
 			(int)std::ceil(pm.Get(GSPerfMon::Readbacks)),
 			(int)std::ceil(pm.Get(GSPerfMon::TextureCopies)),
 			(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)));
+
+		if (GSTextureDiskCache::IsOpen())
+		{
+			info.append_format(" | {} DH | {} DM",
+				(int)std::ceil(pm.Get(GSPerfMon::TextureDiskCacheHits)),
+				(int)std::ceil(pm.Get(GSPerfMon::TextureDiskCacheMisses)));
+		}
 	}
 }
 
@@ -769,7 +792,9 @@ void GSUpdateConfig(const Pcsx2Config::GSOptions& new_config)
 
 	// Options which aren't using the global struct yet, so we need to recreate all GS objects.
 	if (GSConfig.SWExtraThreads != old_config.SWExtraThreads ||
-		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight)
+		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight ||
+		GSConfig.SWTileScheduling != old_config.SWTileScheduling ||
+		GSConfig.SWParallelDrawSetup != old_config.SWParallelDrawSetup)
 	{
 		if (!GSreopen(false, true, GSConfig.Renderer, &old_config))
 			pxFailRel("Failed to do quick GS reopen");
@@ -817,7 +842,10 @@ void GSUpdateConfig(const Pcsx2Config::GSOptions& new_config)
 
 	// texture dumping/replacement options
 	if (GSIsHardwareRenderer())
+	{
 		GSTextureReplacements::UpdateConfig(old_config);
+		GSTextureDiskCache::UpdateConfig(old_config);
+	}
 
 	// clear the hash texture cache since we might have replacements now
 	// also clear it when dumping changes, since we want to dump everything being used
@@ -1254,4 +1282,29 @@ BEGIN_HOTKEY_LIST(g_gs_hotkeys){"Screenshot", TRANSLATE_NOOP("Hotkeys", "Graphic
 				}
 			}
 		}},
+	{"BuildTextureReplacementPack", TRANSLATE_NOOP("Hotkeys", "Graphics"),
+		TRANSLATE_NOOP("Hotkeys", "Build Texture Replacement Pack"),
+		[](s32 pressed) {
+			if (!pressed)
+			{
+				if (!EmuConfig.GS.LoadTextureReplacements)
+				{
+					Host::AddKeyedOSDMessage("BuildReplacementPack",
+						TRANSLATE_STR("Hotkeys", "Texture replacements are not enabled."), Host::OSD_INFO_DURATION);
+				}
+				else
+				{
+					MTGS::RunOnGSThread([]() {
+						if (!g_gs_renderer || !GSIsHardwareRenderer())
+							return;
+
+						if (GSTextureReplacements::BuildReplacementPack())
+						{
+							Host::AddKeyedOSDMessage("BuildReplacementPack",
+								TRANSLATE_STR("Hotkeys", "Building texture replacement pack..."), Host::OSD_INFO_DURATION);
+						}
+					});
+				}
+			}
+		}},
 	END_HOTKEY_LIST()
@@ -22,6 +22,11 @@ public:
 		SyncPoint,
 		Barriers,
 		RenderPasses,
+		TextureDiskCacheHits,
+		TextureDiskCacheMisses,
+		SWJitHits,
+		SWJitPrecompiled,
+		SWJitCompiles,
 		CounterLast,
 
 		// Reused counters for HW.
@@ -75,6 +75,11 @@ enum GIF_REG_COMPLEX
 {
 	GIF_REG_STQRGBAXYZF2 = 0x00,
 	GIF_REG_STQRGBAXYZ2 = 0x01,
+	GIF_REG_UVRGBAXYZF2 = 0x02,
+	GIF_REG_UVRGBAXYZ2 = 0x03,
+	GIF_REG_RGBAXYZF2 = 0x04,
+	GIF_REG_RGBAXYZ2 = 0x05,
+	GIF_REG_COMPLEX_COUNT
 };
 
 enum GIF_A_D_REG
@@ -1110,12 +1115,18 @@ struct alignas(32) GIFPath
 	u32 type;
 	GSVector4i regs;
 
+	// Anything from TYPE_COMPLEX on is handled by a whole loop at a time, type - TYPE_COMPLEX is the GIF_REG_COMPLEX.
 	enum
 	{
 		TYPE_UNKNOWN,
 		TYPE_ADONLY,
-		TYPE_STQRGBAXYZF2,
-		TYPE_STQRGBAXYZ2
+		TYPE_COMPLEX,
+		TYPE_STQRGBAXYZF2 = TYPE_COMPLEX + GIF_REG_STQRGBAXYZF2,
+		TYPE_STQRGBAXYZ2 = TYPE_COMPLEX + GIF_REG_STQRGBAXYZ2,
+		TYPE_UVRGBAXYZF2 = TYPE_COMPLEX + GIF_REG_UVRGBAXYZF2,
+		TYPE_UVRGBAXYZ2 = TYPE_COMPLEX + GIF_REG_UVRGBAXYZ2,
+		TYPE_RGBAXYZF2 = TYPE_COMPLEX + GIF_REG_RGBAXYZF2,
+		TYPE_RGBAXYZ2 = TYPE_COMPLEX + GIF_REG_RGBAXYZ2,
 	};
 
 	__forceinline void SetTag(const void* mem)
@@ -1156,6 +1167,11 @@ struct alignas(32) GIFPath
 					case 1:
 						break;
 					case 2:
+						// untextured
+						if (regs.U32[0] == 0x00000401)
+							type = TYPE_RGBAXYZF2;
+						if (regs.U32[0] == 0x00000501)
+							type = TYPE_RGBAXYZ2;
 						break;
 					case 3:
 						// many games, TODO: formats mixed with NOPs (xeno2: 040f010f02, 04010f020f, mgs3: 04010f0f02, 0401020f0f, 04010f020f)
@@ -1164,9 +1180,26 @@ struct alignas(32) GIFPath
 						// GoW (has other crazy formats, like ...030503050103)
 						if (regs.U32[0] == 0x00050102)
 							type = TYPE_STQRGBAXYZ2;
-						// TODO: common types with UV instead
+						// sprites and 2D, UV instead of STQ
+						if (regs.U32[0] == 0x00040103)
+							type = TYPE_UVRGBAXYZF2;
+						if (regs.U32[0] == 0x00050103)
+							type = TYPE_UVRGBAXYZ2;
 						break;
 					case 4:
+						// two untextured vertices per loop
+						if (regs.U32[0] == 0x04010401)
+						{
+							type = TYPE_RGBAXYZF2;
+							nreg = 2;
+							nloop *= 2;
+						}
+						if (regs.U32[0] == 0x05010501)
+						{
+							type = TYPE_RGBAXYZ2;
+							nreg = 2;
+							nloop *= 2;
+						}
 						break;
 					case 5:
 						break;
@@ -201,8 +201,12 @@ void GSState::SetPrimHandlers()
 	m_fpGIFRegHandlerXYZ[P][1] = &GSState::GIFRegHandlerXYZF2<P, 1, auto_flush, index_swap>; \
 	m_fpGIFRegHandlerXYZ[P][2] = &GSState::GIFRegHandlerXYZ2<P, 0, auto_flush, index_swap>; \
 	m_fpGIFRegHandlerXYZ[P][3] = &GSState::GIFRegHandlerXYZ2<P, 1, auto_flush, index_swap>; \
-	m_fpGIFPackedRegHandlerSTQRGBAXYZF2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZF2<P, auto_flush, index_swap>; \
-	m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush, index_swap>;
+	m_fpGIFPackedRegHandlerComplex[P][GIF_REG_STQRGBAXYZF2] = &GSState::GIFPackedRegHandlerSTQRGBAXYZF2<P, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerComplex[P][GIF_REG_STQRGBAXYZ2] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerComplex[P][GIF_REG_UVRGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, auto_flush, index_swap, 0x00040103>; \
+	m_fpGIFPackedRegHandlerComplex[P][GIF_REG_UVRGBAXYZ2] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, auto_flush, index_swap, 0x00050103>; \
+	m_fpGIFPackedRegHandlerComplex[P][GIF_REG_RGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, auto_flush, index_swap, 0x00000401>; \
+	m_fpGIFPackedRegHandlerComplex[P][GIF_REG_RGBAXYZ2] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, auto_flush, index_swap, 0x00000501>;
 
 	SetHandlerXYZ(GS_POINTLIST, true, false);
 	SetHandlerXYZ(GS_LINELIST, auto_flush, index_swap);
@@ -705,6 +709,70 @@ void GSState::GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, u32
 	m_q = r[-3].STQ.Q; // remember the last one, STQ outputs this to the temp Q each time
 }
 
+template <u32 prim, bool auto_flush, bool index_swap, u32 regs>
+void GSState::GIFPackedRegHandlerRGBAXYZ(const GIFPackedReg* RESTRICT r, u32 size)
+{
+	// regs is the REGS signature, one register per byte as in GIFPath::regs: an optional UV, RGBA, then XYZF2 or XYZ2.
+	constexpr bool uv = (regs & 0xff) == GIF_REG_UV;
+	constexpr u32 nreg = uv ? 3 : 2;
+	constexpr u32 xyz_reg = (regs >> ((nreg - 1) * 8)) & 0xff;
+	static_assert(((regs >> ((nreg - 2) * 8)) & 0xff) == GIF_REG_RGBA && (xyz_reg == GIF_REG_XYZF2 || xyz_reg == GIF_REG_XYZ2));
+
+	pxAssert(size > 0 && size % nreg == 0);
+
+	// The generic path sets this on the UV qword, before the XYZ handler can flush anything.
+	if constexpr (uv)
+	{
+		if (GSConfig.UserHacks_ForceEvenSpritePosition)
+			m_isPackedUV_HackFlag = true; // see GIFPackedRegHandlerUV_Hack
+	}
+
+	CheckFlushes();
+
+	const GIFPackedReg* RESTRICT r_end = r + size;
+
+	while (r < r_end)
+	{
+		if constexpr (uv)
+		{
+			const GSVector4i v = GSVector4i::loadl(r) & GSVector4i::x00003fff(); // see GIFPackedRegHandlerUV
+
+			m_v.UV = (u32)GSVector4i::store(v.ps32(v));
+		}
+
+		const GSVector4i rgba = (GSVector4i::load<false>(&r[nreg - 2]) & GSVector4i::x000000ff()).ps32().pu16();
+
+		m_v.RGBAQ.U32[0] = (u32)GSVector4i::store(rgba);
+		m_v.RGBAQ.Q = m_q;
+
+		const GIFPackedReg* RESTRICT p = &r[nreg - 1];
+
+		if constexpr (xyz_reg == GIF_REG_XYZF2)
+		{
+			GSVector4i xy = GSVector4i::loadl(&p->U64[0]);
+			GSVector4i zf = GSVector4i::loadl(&p->U64[1]);
+			xy = xy.upl16(xy.srl<4>()).upl32(GSVector4i::load((int)m_v.UV));
+			zf = zf.srl32<4>() & GSVector4i::x00ffffff().upl32(GSVector4i::x000000ff());
+
+			m_v.m[1] = xy.upl32(zf);
+
+			VertexKick<prim, auto_flush, index_swap>(p->XYZF2.Skip());
+		}
+		else
+		{
+			const GSVector4i xy = GSVector4i::loadl(&p->U64[0]);
+			const GSVector4i z = GSVector4i::loadl(&p->U64[1]);
+			const GSVector4i xyz = xy.upl16(xy.srl<4>()).upl32(z);
+
+			m_v.m[1] = xyz.upl64(GSVector4i::loadl(&m_v.UV));
+
+			VertexKick<prim, auto_flush, index_swap>(p->XYZ2.Skip());
+		}
+
+		r += nreg;
+	}
+}
+
 void GSState::GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, u32 size)
 {
 }
@@ -2419,20 +2487,12 @@ void GSState::Transfer(const u8* mem, u32 size)
 								} while (--total > 0);
 
 								break;
-							case GIFPath::TYPE_STQRGBAXYZF2: // majority of the vertices are formatted like this
-								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2])((GIFPackedReg*)mem, total);
-
-								mem += total * sizeof(GIFPackedReg);
-
-								break;
-							case GIFPath::TYPE_STQRGBAXYZ2:
-								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2])((GIFPackedReg*)mem, total);
+							default: // majority of the vertices are formatted like one of these (STQRGBAXYZF2 most of all)
+								(this->*m_fpGIFPackedRegHandlersC[path.type - GIFPath::TYPE_COMPLEX])((GIFPackedReg*)mem, total);
 
 								mem += total * sizeof(GIFPackedReg);
 
 								break;
-							default:
-								ASSUME(0);
 						}
 
 						path.nloop = 0;
@@ -2785,8 +2845,7 @@ void GSState::UpdateVertexKick()
 	m_fpGIFRegHandlers[GIF_A_D_REG_XYZ2] = m_fpGIFRegHandlerXYZ[prim][2];
 	m_fpGIFRegHandlers[GIF_A_D_REG_XYZ3] = m_fpGIFRegHandlerXYZ[prim][3];
 
-	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2] = m_fpGIFPackedRegHandlerSTQRGBAXYZF2[prim];
-	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2] = m_fpGIFPackedRegHandlerSTQRGBAXYZ2[prim];
+	std::copy(std::begin(m_fpGIFPackedRegHandlerComplex[prim]), std::end(m_fpGIFPackedRegHandlerComplex[prim]), m_fpGIFPackedRegHandlersC);
 }
 
 void GSState::GrowVertexBuffer()
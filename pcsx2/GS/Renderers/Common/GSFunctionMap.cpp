@@ -9,10 +9,12 @@ namespace GSCodeReserve
 	static u8* s_memory_base;
 	static u8* s_memory_end;
 	static u8* s_memory_ptr;
+	static std::mutex s_mutex;
 }
 
 void GSCodeReserve::ResetMemory()
 {
+	std::lock_guard<std::mutex> lock(s_mutex);
 	s_memory_base = SysMemory::GetSWRec();
 	s_memory_end = SysMemory::GetSWRecEnd();
 	s_memory_ptr = s_memory_base;
@@ -23,6 +25,16 @@ size_t GSCodeReserve::GetMemoryUsed()
 	return s_memory_ptr - s_memory_base;
 }
 
+size_t GSCodeReserve::GetMemoryFree()
+{
+	return s_memory_end - s_memory_ptr;
+}
+
+std::mutex& GSCodeReserve::GetMutex()
+{
+	return s_mutex;
+}
+
 u8* GSCodeReserve::ReserveMemory(size_t size)
 {
 	pxAssert((s_memory_ptr + size) <= s_memory_end);
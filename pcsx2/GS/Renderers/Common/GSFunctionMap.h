@@ -4,11 +4,14 @@
 #pragma once
 
 #include "GS/GSExtra.h"
+#include "GS/GSPerfMon.h"
 #include "GS/Renderers/SW/GSScanlineEnvironment.h"
 
 #include "common/HostSys.h"
 
 #include <cinttypes>
+#include <mutex>
+#include <vector>
 
 template <class KEY, class VALUE>
 class GSFunctionMap
@@ -48,6 +51,7 @@ public:
 		if (it != m_map_active.end())
 		{
 			m_active = it->second;
+			g_perfmon.Put(GSPerfMon::SWJitHits, 1);
 		}
 		else
 		{
@@ -67,6 +71,12 @@ public:
 		return m_active->f;
 	}
 
+	void GetActiveKeys(std::vector<KEY>* keys) const
+	{
+		for (const auto& i : m_map_active)
+			keys->push_back(i.first);
+	}
+
 	void UpdateStats(u64 frame, u64 ticks, int actual, int total, int prims)
 	{
 		if (m_active)
@@ -142,6 +152,10 @@ namespace GSCodeReserve
 	void ResetMemory();
 
 	size_t GetMemoryUsed();
+	size_t GetMemoryFree();
+
+	/// Held while generating code, so functions can be compiled ahead of time on another thread.
+	std::mutex& GetMutex();
 
 	u8* ReserveMemory(size_t size);
 	void CommitMemory(size_t size);
@@ -165,44 +179,69 @@ public:
 
 	void Clear()
 	{
+		std::lock_guard<std::mutex> lock(GSCodeReserve::GetMutex());
 		m_cgmap.clear();
 	}
 
 	VALUE GetDefaultFunction(KEY key)
 	{
-		VALUE ret = nullptr;
+		std::lock_guard<std::mutex> lock(GSCodeReserve::GetMutex());
 
 		auto i = m_cgmap.find(key);
 
 		if (i != m_cgmap.end())
 		{
-			ret = i->second;
+			// Only compiled ahead of time, anything compiled on demand is already active.
+			g_perfmon.Put(GSPerfMon::SWJitPrecompiled, 1);
+			return i->second;
 		}
-		else
-		{
-			HostSys::BeginCodeWrite();
 
-			u8* code_ptr = GSCodeReserve::ReserveMemory(MAX_SIZE);
-			CG cg(key, code_ptr, MAX_SIZE);
-			cg.Generate();
-			pxAssert(cg.GetSize() < MAX_SIZE);
+		g_perfmon.Put(GSPerfMon::SWJitCompiles, 1);
+		return Generate(key);
+	}
+
+	/// Compiles a function before it's needed, returns false if there's not enough space left to do so.
+	/// Safe to call from any thread.
+	bool Precompile(KEY key, size_t reserve)
+	{
+		std::lock_guard<std::mutex> lock(GSCodeReserve::GetMutex());
+
+		if (m_cgmap.find(key) != m_cgmap.end())
+			return true;
+
+		// Leave room for whatever the game actually uses.
+		if (GSCodeReserve::GetMemoryFree() < reserve + MAX_SIZE)
+			return false;
+
+		Generate(key);
+		return true;
+	}
+
+private:
+	VALUE Generate(KEY key)
+	{
+		HostSys::BeginCodeWrite();
+
+		u8* code_ptr = GSCodeReserve::ReserveMemory(MAX_SIZE);
+		CG cg(key, code_ptr, MAX_SIZE);
+		cg.Generate();
+		pxAssert(cg.GetSize() < MAX_SIZE);
 
 #if 0
-			fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg.getSize(), (u64)key);
-			GSScanlineSelector sel(key);
-			sel.Print();
+		fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg.getSize(), (u64)key);
+		GSScanlineSelector sel(key);
+		sel.Print();
 #endif
 
-			const u32 size = static_cast<u32>(cg.GetSize());
-			GSCodeReserve::CommitMemory(size);
+		const u32 size = static_cast<u32>(cg.GetSize());
+		GSCodeReserve::CommitMemory(size);
 
-			HostSys::EndCodeWrite();
-			HostSys::FlushInstructionCache(code_ptr, static_cast<u32>(size));
+		HostSys::EndCodeWrite();
+		HostSys::FlushInstructionCache(code_ptr, static_cast<u32>(size));
 
-			ret = (VALUE)cg.GetCode();
+		VALUE ret = (VALUE)cg.GetCode();
 
-			m_cgmap[key] = ret;
-		}
+		m_cgmap[key] = ret;
 
 		return ret;
 	}
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/GSRegs.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+/// Finds items by the GS memory pages they cover, so overlap tests only have to look at the items sharing a page
+/// with the query instead of every item. Block ranges are unwrapped, i.e. an item which wraps around the end of
+/// GS memory continues past MAX_BLOCKS rather than starting again at zero, which is what the texture cache uses
+/// for its overlap tests.
+///
+/// The index doesn't know where items keep their range, the owner passes it in, so items can be indexed in
+/// place without a lookup table. Queries can return items which don't overlap the exact block range, callers
+/// still have to do their own test.
+template <class T>
+class GSPageIndex
+{
+public:
+	static constexpr u32 NUM_PAGES = MAX_PAGES * 2;
+
+	/// Pages an item is currently registered in. Empty until the first update.
+	struct Range
+	{
+		u16 first = 1;
+		u16 last = 0;
+
+		__fi bool Empty() const { return (first > last); }
+	};
+
+	/// Registers the item for the specified block range, or moves it if it was already registered elsewhere.
+	void Update(T* item, Range& range, u32 start_bp, u32 end_bp)
+	{
+		const u16 first = static_cast<u16>(std::min(start_bp / BLOCKS_PER_PAGE, NUM_PAGES - 1));
+		const u16 last = static_cast<u16>(std::min(std::max(start_bp, end_bp) / BLOCKS_PER_PAGE, NUM_PAGES - 1));
+		if (range.first == first && range.last == last)
+			return;
+
+		Remove(item, range);
+
+		for (u32 page = first; page <= last; page++)
+			m_map[page].push_back({item, first});
+
+		range.first = first;
+		range.last = last;
+		m_count++;
+	}
+
+	/// Removes the item from all pages it is registered in. Does nothing if it isn't registered.
+	void Remove(T* item, Range& range)
+	{
+		if (range.Empty())
+			return;
+
+		for (u32 page = range.first; page <= range.last; page++)
+		{
+			std::vector<Node>& nodes = m_map[page];
+			for (auto it = nodes.begin(); it != nodes.end(); ++it)
+			{
+				if (it->item == item)
+				{
+					// Order within a page doesn't matter, callers which care sort by their own criteria.
+					*it = nodes.back();
+					nodes.pop_back();
+					break;
+				}
+			}
+		}
+
+		range = {};
+		m_count--;
+	}
+
+	/// Calls the function once for each item registered in any page of the block range.
+	template <typename F>
+	void ForEach(u32 start_bp, u32 end_bp, const F& func) const
+	{
+		if (m_count == 0)
+			return;
+
+		const u32 first = std::min(start_bp / BLOCKS_PER_PAGE, NUM_PAGES - 1);
+		const u32 last = std::min(std::max(start_bp, end_bp) / BLOCKS_PER_PAGE, NUM_PAGES - 1);
+		for (u32 page = first; page <= last; page++)
+		{
+			for (const Node& node : m_map[page])
+			{
+				// Items covering several pages are only reported from the first page both ranges share.
+				if (node.first_page == page || page == first)
+					func(node.item);
+			}
+		}
+	}
+
+	/// Returns true if nothing is registered in the block range.
+	bool Empty(u32 start_bp, u32 end_bp) const
+	{
+		if (m_count == 0)
+			return true;
+
+		const u32 first = std::min(start_bp / BLOCKS_PER_PAGE, NUM_PAGES - 1);
+		const u32 last = std::min(std::max(start_bp, end_bp) / BLOCKS_PER_PAGE, NUM_PAGES - 1);
+		for (u32 page = first; page <= last; page++)
+		{
+			if (!m_map[page].empty())
+				return false;
+		}
+
+		return true;
+	}
+
+	/// Forgets every item. The ranges held by the items are not reset.
+	void Clear()
+	{
+		for (std::vector<Node>& nodes : m_map)
+			nodes.clear();
+		m_count = 0;
+	}
+
+	__fi u32 GetCount() const { return m_count; }
+
+private:
+	struct Node
+	{
+		T* item;
+		u16 first_page;
+	};
+
+	std::array<std::vector<Node>, NUM_PAGES> m_map;
+	u32 m_count = 0;
+};
@@ -544,7 +544,7 @@ void GSRenderer::EndPresentFrame()
 	ImGuiManager::NewFrame();
 }
 
-void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
+void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame, bool skip_present)
 {
 	if (GSConfig.DumpGSData && s_n >= GSConfig.SaveN)
 	{
@@ -582,6 +582,9 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 		}
 	}
 
+	// Frames replayed by run-ahead are never shown, only the frame after the replay is.
+	skip_frame |= skip_present;
+
 	const bool blank_frame = !Merge(field);
 
 	m_last_draw_n = s_n;
@@ -45,7 +45,10 @@ public:
 
 	virtual void UpdateRenderFixes();
 
-	virtual void VSync(u32 field, bool registers_written, bool idle_frame);
+	/// Called on the GS thread when the running game changes.
+	virtual void GameChanged() {}
+
+	virtual void VSync(u32 field, bool registers_written, bool idle_frame, bool skip_present);
 	virtual bool CanUpscale() { return false; }
 	virtual float GetUpscaleMultiplier() { return 1.0f; }
 	virtual float GetTextureScaleFactor() { return 1.0f; }
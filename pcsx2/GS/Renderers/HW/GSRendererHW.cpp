@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "GS/Renderers/HW/GSRendererHW.h"
+#include "GS/Renderers/HW/GSTextureDiskCache.h"
 #include "GS/Renderers/HW/GSTextureReplacements.h"
 #include "GS/GSGL.h"
 #include "GS/GSPerfMon.h"
@@ -22,6 +23,7 @@ GSRendererHW::GSRendererHW()
 	pxAssert(!g_texture_cache);
 	g_texture_cache = std::make_unique<GSTextureCache>();
 	GSTextureReplacements::Initialize();
+	GSTextureDiskCache::Initialize();
 
 	// Hope nothing requires too many draw calls.
 	m_drawlist.reserve(2048);
@@ -92,7 +94,7 @@ void GSRendererHW::UpdateSettings(const Pcsx2Config::GSOptions& old_config)
 	SetTCOffset();
 }
 
-void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
+void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame, bool skip_present)
 {
 	if (GSConfig.LoadTextureReplacements)
 		GSTextureReplacements::ProcessAsyncLoadedTextures();
@@ -140,7 +142,7 @@ void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
 	m_skip = 0;
 	m_skip_offset = 0;
 
-	GSRenderer::VSync(field, registers_written, idle_frame);
+	GSRenderer::VSync(field, registers_written, idle_frame, skip_present);
 }
 
 GSTexture* GSRendererHW::GetOutput(int i, float& scale, int& y_offset)
@@ -3055,10 +3057,14 @@ void GSRendererHW::Draw()
 					rt->m_valid_alpha_high = false;
 			}
 			rt->m_TEX0 = FRAME_TEX0;
+			g_texture_cache->UpdateTargetIndex(rt);
 		}
 
 		if (ds && (!is_possible_mem_clear || ds->m_TEX0.PSM != ZBUF_TEX0.PSM || (rt && ds->m_TEX0.TBW != rt->m_TEX0.TBW)))
+		{
 			ds->m_TEX0 = ZBUF_TEX0;
+			g_texture_cache->UpdateTargetIndex(ds);
+		}
 	}
 	else if (!m_texture_shuffle)
 	{
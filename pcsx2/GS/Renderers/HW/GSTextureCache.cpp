@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "GSTextureCache.h"
+#include "GSTextureDiskCache.h"
 #include "GSTextureReplacements.h"
 #include "GSRendererHW.h"
 #include "GS/GSState.h"
@@ -1827,10 +1828,9 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 	// TODO: Move all frame stuff to its own routine too.
 	if (!is_frame)
 	{
-		for (auto i = list.begin(); i != list.end(); ++i)
+		GetTargetsInRange(type, bp, bp, m_target_candidates);
+		for (Target* t : m_target_candidates)
 		{
-			Target* t = *i;
-
 			if (bp == t->m_TEX0.TBP0)
 			{
 				bool can_use = true;
@@ -1872,7 +1872,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 				if (can_use)
 				{
 					if (used)
-						list.MoveFront(i.Index());
+						MoveTargetFront(t);
 
 					dst = t;
 
@@ -1883,7 +1883,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 				{
 					GL_INS("TC: Deleting RT BP 0x%x BW %d PSM %s due to change in target", t->m_TEX0.TBP0, t->m_TEX0.TBW, psm_str(t->m_TEX0.PSM));
 					InvalidateSourcesFromTarget(t);
-					i = list.erase(i);
+					EraseTarget(t);
 					delete t;
 				}
 			}
@@ -2235,6 +2235,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 			dst->OffsetHack_modxy = dst_match->OffsetHack_modxy;
 			dst->m_end_block = dst_match->m_end_block; // If we're copying the size, we need to keep the end block.
 			dst->m_valid = dst_match->m_valid;
+			UpdateTargetIndex(dst);
 			dst->m_valid_alpha_low = dst_match->m_valid_alpha_low; //&& psm_s.trbpp != 24;
 			dst->m_valid_alpha_high = dst_match->m_valid_alpha_high; //&& psm_s.trbpp != 24;
 			dst->m_valid_rgb = dst_match->m_valid_rgb;
@@ -2681,6 +2682,7 @@ bool GSTextureCache::PreloadTarget(GIFRegTEX0 TEX0, const GSVector2i& size, cons
 								new_valid.w = std::max(new_valid.w - overlapping_pages_height, 0);
 								t->m_TEX0.TBP0 += (overlapping_pages_height / GSLocalMemory::m_psm[t->m_TEX0.PSM].pgs.y) << 5;
 								t->ResizeValidity(new_valid);
+								UpdateTargetIndex(t);
 							}
 							else
 							{
@@ -3277,20 +3279,13 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 
 	for (int type = 0; type < 2; type++)
 	{
-		auto& list = m_dst[type];
-		for (auto i = list.begin(); i != list.end();)
+		// Only targets sharing a page with the write can pass the overlap test below.
+		GetTargetsInRange(type, bp, end_bp, m_target_candidates);
+		for (Target* t : m_target_candidates)
 		{
-			auto j = i;
-			Target* t = *j;
-
 			// Don't bother checking any further if the target doesn't overlap with the write/invalidation.
 			if ((bp < t->m_TEX0.TBP0 && end_bp < t->m_TEX0.TBP0) || bp > t->UnwrappedEndBlock())
-			{
-				++i;
 				continue;
-			}
-
-			++i;
 
 			if (GSUtil::HasSharedBits(psm, t->m_TEX0.PSM))
 			{
@@ -3309,7 +3304,7 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 						if (FullRectDirty(t))
 						{
 							InvalidateSourcesFromTarget(t);
-							i = list.erase(j);
+							EraseTarget(t);
 							GL_CACHE("TC: Remove Target(%s) (0x%x)", to_string(type),
 								t->m_TEX0.TBP0);
 							delete t;
@@ -3327,7 +3322,7 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 					if (FullRectDirty(t, rgba._u32))
 					{
 						InvalidateSourcesFromTarget(t);
-						i = list.erase(j);
+						EraseTarget(t);
 						GL_CACHE("TC: Remove Target(%s) (0x%x)", to_string(type),
 							t->m_TEX0.TBP0);
 						delete t;
@@ -4116,21 +4111,60 @@ void GSTextureCache::CopyPages(Target* src, u32 sbw, u32 src_offset, Target* dst
 	g_gs_device->DrawMultiStretchRects(rects, num_pages, dst->m_texture, shader);
 }
 
-GSTextureCache::Target* GSTextureCache::GetExactTarget(u32 BP, u32 BW, int type, u32 end_bp)
+void GSTextureCache::AddTarget(Target* t)
 {
-	auto& rts = m_dst[type];
-	for (auto it = rts.begin(); it != rts.end(); ++it) // Iterate targets from MRU to LRU.
+	t->m_list_index = m_dst[t->m_type].InsertFront(t);
+	t->m_lru_stamp = ++m_target_lru_stamp;
+	m_dst_index[t->m_type].Update(t, t->m_page_range, t->m_TEX0.TBP0, t->UnwrappedEndBlock());
+}
+
+void GSTextureCache::MoveTargetFront(Target* t)
+{
+	m_dst[t->m_type].MoveFront(t->m_list_index);
+	t->m_lru_stamp = ++m_target_lru_stamp;
+}
+
+void GSTextureCache::EraseTarget(Target* t)
+{
+	m_dst[t->m_type].EraseIndex(t->m_list_index);
+}
+
+void GSTextureCache::UpdateTargetIndex(Target* t)
+{
+	// Targets which haven't been added to the cache yet get indexed when they are.
+	if (!t->m_page_range.Empty())
+		m_dst_index[t->m_type].Update(t, t->m_page_range, t->m_TEX0.TBP0, t->UnwrappedEndBlock());
+}
+
+void GSTextureCache::GetTargetsInRange(int type, u32 start_bp, u32 end_bp, std::vector<Target*>& targets) const
+{
+	targets.clear();
+	m_dst_index[type].ForEach(start_bp, end_bp, [&targets](Target* t) { targets.push_back(t); });
+
+	// Same order as walking the list, so the callers behave the same as they did before the index.
+	if (targets.size() > 1)
 	{
-		Target* t = *it;
+		std::sort(targets.begin(), targets.end(),
+			[](const Target* lhs, const Target* rhs) { return lhs->m_lru_stamp > rhs->m_lru_stamp; });
+	}
+}
 
-		if (t->m_TEX0.TBP0 == BP && t->m_TEX0.TBW == BW && t->UnwrappedEndBlock() >= end_bp)
+GSTextureCache::Target* GSTextureCache::GetExactTarget(u32 BP, u32 BW, int type, u32 end_bp)
+{
+	// Any target starting at BP is indexed under the page containing BP.
+	Target* found = nullptr;
+	m_dst_index[type].ForEach(BP, BP, [BP, BW, end_bp, &found](Target* t) {
+		if (t->m_TEX0.TBP0 == BP && t->m_TEX0.TBW == BW && t->UnwrappedEndBlock() >= end_bp &&
+			(!found || t->m_lru_stamp > found->m_lru_stamp))
 		{
-			rts.MoveFront(it.Index());
-			return t;
+			found = t;
 		}
-	}
+	});
 
-	return nullptr;
+	if (found)
+		MoveTargetFront(found);
+
+	return found;
 }
 
 GSTextureCache::Target* GSTextureCache::GetTargetWithSharedBits(u32 BP, u32 PSM) const
@@ -4149,16 +4183,23 @@ GSTextureCache::Target* GSTextureCache::GetTargetWithSharedBits(u32 BP, u32 PSM)
 
 GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(GSTextureCache::Target* target) const
 {
+	// Wrapped targets never pass the overlap test, so there's nothing to find for them either.
+	if (target->Wraps())
+		return nullptr;
+
 	for (int i = 0; i < 2; i++)
 	{
-		for (Target* tgt : m_dst[i])
-		{
-			if (tgt == target)
-				continue;
+		Target* found = nullptr;
+		m_dst_index[i].ForEach(target->m_TEX0.TBP0, target->m_end_block, [target, &found](Target* tgt) {
+			if (tgt != target && CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, target->m_TEX0.TBP0, target->m_end_block) &&
+				(!found || tgt->m_lru_stamp > found->m_lru_stamp))
+			{
+				found = tgt;
+			}
+		});
 
-			if (CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, target->m_TEX0.TBP0, target->m_end_block))
-				return tgt;
-		}
+		if (found)
+			return found;
 	}
 
 	return nullptr;
@@ -4166,13 +4207,22 @@ GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(GSTextureCache::Ta
 
 GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(u32 BP, u32 end_bp) const
 {
+	if (BP > end_bp)
+		return nullptr;
+
 	for (int i = 0; i < 2; i++)
 	{
-		for (Target* tgt : m_dst[i])
-		{
-			if (CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, BP, end_bp))
-				return tgt;
-		}
+		Target* found = nullptr;
+		m_dst_index[i].ForEach(BP, end_bp, [BP, end_bp, &found](Target* tgt) {
+			if (CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, BP, end_bp) &&
+				(!found || tgt->m_lru_stamp > found->m_lru_stamp))
+			{
+				found = tgt;
+			}
+		});
+
+		if (found)
+			return found;
 	}
 
 	return nullptr;
@@ -4245,26 +4295,19 @@ bool GSTextureCache::HasTargetInHeightCache(u32 bp, u32 fbw, u32 psm, u32 max_ag
 
 bool GSTextureCache::Has32BitTarget(u32 bp)
 {
-	// Look for 32-bit targets at the matching block.
-	for (auto i = m_dst[RenderTarget].begin(); i != m_dst[RenderTarget].end(); ++i)
+	// Look for 32-bit targets at the matching block, then try depth.
+	for (int type = 0; type < 2; type++)
 	{
-		const Target* const t = *i;
-		if (bp == t->m_TEX0.TBP0 && t->m_32_bits_fmt)
-		{
-			// May as well move it to the front, because we're going to be looking it up again.
-			m_dst[RenderTarget].MoveFront(i.Index());
-			return true;
-		}
-	}
+		Target* found = nullptr;
+		m_dst_index[type].ForEach(bp, bp, [bp, &found](Target* t) {
+			if (bp == t->m_TEX0.TBP0 && t->m_32_bits_fmt && (!found || t->m_lru_stamp > found->m_lru_stamp))
+				found = t;
+		});
 
-	// Try depth.
-	for (auto i = m_dst[DepthStencil].begin(); i != m_dst[DepthStencil].end(); ++i)
-	{
-		const Target* const t = *i;
-		if (bp == t->m_TEX0.TBP0 && t->m_32_bits_fmt)
+		if (found)
 		{
 			// May as well move it to the front, because we're going to be looking it up again.
-			m_dst[DepthStencil].MoveFront(i.Index());
+			MoveTargetFront(found);
 			return true;
 		}
 	}
@@ -5402,29 +5445,45 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 	const bool compute_alpha_minmax = !paltex;
 	std::pair<u8, u8> alpha_minmax = {0u, 255u};
 
-	// upload base level
-	PreloadTexture(TEX0, TEXA, region, g_gs_renderer->m_mem, paltex, tex, 0, compute_alpha_minmax ? &alpha_minmax : nullptr);
-
-	// upload mips if present
-	if (lod)
+	// the disk cache stores indexed textures without the palette, same as the hash cache does below
+	const HashCacheKey disk_key = paltex ? key.WithRemovedCLUTHash() : key;
+	const u32 levels = static_cast<u32>(std::max(tlevels, 1));
+	const bool use_disk_cache = GSTextureDiskCache::IsOpen();
+	if (!use_disk_cache ||
+		!GSTextureDiskCache::LoadTexture(disk_key, tex, levels, compute_alpha_minmax ? &alpha_minmax : nullptr))
 	{
-		const int basemip = lod->x;
-		for (int mip = 1; mip < tlevels; mip++)
+		std::vector<u8> disk_cache_data;
+		std::vector<u8>* const disk_cache_data_ptr = use_disk_cache ? &disk_cache_data : nullptr;
+
+		// upload base level
+		PreloadTexture(TEX0, TEXA, region, g_gs_renderer->m_mem, paltex, tex, 0, compute_alpha_minmax ? &alpha_minmax : nullptr,
+			disk_cache_data_ptr);
+
+		// upload mips if present
+		if (lod)
 		{
-			const GIFRegTEX0 MIP_TEX0{g_gs_renderer->GetTex0Layer(basemip + mip)};
-			std::pair<u8, u8> mip_alpha_minmax;
-			PreloadTexture(MIP_TEX0, TEXA, region.AdjustForMipmap(mip), g_gs_renderer->m_mem, paltex, tex, mip,
-				compute_alpha_minmax ? &mip_alpha_minmax : nullptr);
-			if (compute_alpha_minmax)
+			const int basemip = lod->x;
+			for (int mip = 1; mip < tlevels; mip++)
 			{
-				alpha_minmax.first = std::min(alpha_minmax.first, mip_alpha_minmax.first);
-				alpha_minmax.second = std::max(alpha_minmax.second, mip_alpha_minmax.second);
+				const GIFRegTEX0 MIP_TEX0{g_gs_renderer->GetTex0Layer(basemip + mip)};
+				std::pair<u8, u8> mip_alpha_minmax;
+				PreloadTexture(MIP_TEX0, TEXA, region.AdjustForMipmap(mip), g_gs_renderer->m_mem, paltex, tex, mip,
+					compute_alpha_minmax ? &mip_alpha_minmax : nullptr, disk_cache_data_ptr);
+				if (compute_alpha_minmax)
+				{
+					alpha_minmax.first = std::min(alpha_minmax.first, mip_alpha_minmax.first);
+					alpha_minmax.second = std::max(alpha_minmax.second, mip_alpha_minmax.second);
+				}
 			}
 		}
 
-		tex->ClearMipmapGenerationFlag();
+		if (use_disk_cache)
+			GSTextureDiskCache::InsertTexture(disk_key, tex, levels, alpha_minmax, disk_cache_data);
 	}
 
+	if (lod)
+		tex->ClearMipmapGenerationFlag();
+
 	// remove the palette hash when using paltex/indexed
 	if (paltex)
 		key.RemoveCLUTHash();
@@ -5515,7 +5574,7 @@ GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, i
 
 	g_texture_cache->m_target_memory_usage += t->m_texture->GetMemUsage();
 
-	g_texture_cache->m_dst[type].push_front(t);
+	g_texture_cache->AddTarget(t);
 
 	t->UpdateTextureDebugName();
 
@@ -6141,6 +6200,7 @@ GSTextureCache::Target::~Target()
 {
 	// Targets should never be shared.
 	pxAssert(!m_shared_texture);
+	g_texture_cache->m_dst_index[m_type].Remove(this, m_page_range);
 	if (m_texture)
 	{
 		g_texture_cache->m_target_memory_usage -= m_texture->GetMemUsage();
@@ -6442,6 +6502,7 @@ void GSTextureCache::Target::ResizeValidity(const GSVector4i& rect)
 		m_valid = m_valid.rintersect(rect);
 		m_drawn_since_read = m_drawn_since_read.rintersect(rect);
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->UpdateTargetIndex(this);
 	}
 	// Else No valid size, so need to resize down.
 
@@ -6455,12 +6516,14 @@ void GSTextureCache::Target::UpdateValidity(const GSVector4i& rect, bool can_res
 		m_valid = rect;
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->UpdateTargetIndex(this);
 	}
 	else if (can_resize)
 	{
 		m_valid = m_valid.runion(rect);
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->UpdateTargetIndex(this);
 	}
 	// GL_CACHE("UpdateValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
@@ -7286,7 +7349,7 @@ GSTextureCache::HashType GSTextureCache::HashTexture(const GIFRegTEX0& TEX0, con
 }
 
 void GSTextureCache::PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem,
-	bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax)
+	bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax, std::vector<u8>* disk_cache_data)
 {
 	// m_TEX0 is adjusted for mips (messy, should be changed).
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
@@ -7310,7 +7373,7 @@ void GSTextureCache::PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TE
 	// If we can stream it directly to GPU memory, do so, otherwise go through a temp buffer.
 	const GSVector4i unoffset_rect(0, 0, tw, th);
 	GSTexture::GSMap map;
-	if (rect.eq(block_rect) && !alpha_minmax && tex->Map(map, &unoffset_rect, level))
+	if (rect.eq(block_rect) && !alpha_minmax && !disk_cache_data && tex->Map(map, &unoffset_rect, level))
 	{
 		rtx(mem, off, block_rect, map.bits, map.pitch, TEXA);
 		tex->Unmap();
@@ -7333,6 +7396,12 @@ void GSTextureCache::PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TE
 			*alpha_minmax = GSGetRGBA8AlphaMinMax(ptr, unoffset_rect.width(), unoffset_rect.height(), pitch);
 
 		tex->Update(unoffset_rect, ptr, pitch, level);
+
+		if (disk_cache_data)
+		{
+			GSTextureDiskCache::AppendLevel(*disk_cache_data, static_cast<u32>(tw), static_cast<u32>(th), ptr, pitch,
+				static_cast<u32>(tw) << (paltex ? 0 : 2));
+		}
 	}
 }
 
@@ -5,6 +5,7 @@
 
 #include "GS/Renderers/Common/GSRenderer.h"
 #include "GS/Renderers/Common/GSFastList.h"
+#include "GS/Renderers/Common/GSPageIndex.h"
 #include "GS/Renderers/Common/GSDirtyRect.h"
 
 #include <unordered_set>
@@ -231,6 +232,11 @@ public:
 		GSVector4i m_drawn_since_read{};
 		int readbacks_since_draw = 0;
 
+		// Position in m_dst, and the pages the target is indexed under. Only valid once it's been added to the cache.
+		GSPageIndex<Target>::Range m_page_range;
+		u64 m_lru_stamp = 0;
+		u16 m_list_index = 0;
+
 	public:
 		Target(GIFRegTEX0 TEX0, int type, const GSVector2i& unscaled_size, float scale, GSTexture* texture);
 		~Target();
@@ -415,6 +421,9 @@ protected:
 	u64 m_hash_cache_replacement_memory_usage = 0;
 
 	FastList<Target*> m_dst[2];
+	GSPageIndex<Target> m_dst_index[2];
+	u64 m_target_lru_stamp = 0;
+	std::vector<Target*> m_target_candidates;
 	FastList<TargetHeightElem> m_target_heights;
 	u64 m_target_memory_usage = 0;
 
@@ -451,7 +460,8 @@ protected:
 	void RemoveFromHashCache(HashCacheMap::iterator it);
 	void AgeHashCache();
 
-	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax);
+	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax,
+		std::vector<u8>* disk_cache_data = nullptr);
 	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
 
 	// TODO: virtual void Write(Source* s, const GSVector4i& r) = 0;
@@ -459,6 +469,18 @@ protected:
 
 	Source* CreateMergedSource(GIFRegTEX0 TEX0, GIFRegTEXA TEXA, SourceRegion region, float scale);
 
+	/// Adds a newly created target to the front of its list, and indexes it.
+	void AddTarget(Target* t);
+
+	/// Moves a target to the front of its list, i.e. makes it the most recently used.
+	void MoveTargetFront(Target* t);
+
+	/// Removes a target from its list. Deleting the target removes it from the index.
+	void EraseTarget(Target* t);
+
+	/// Collects the targets of the specified type which may overlap the unwrapped block range, most recently used first.
+	void GetTargetsInRange(int type, u32 start_bp, u32 end_bp, std::vector<Target*>& targets) const;
+
 public:
 	GSTextureCache();
 	~GSTextureCache();
@@ -497,6 +519,9 @@ public:
 		const GSVector4i draw_rc = GSVector4i::zero(), GSTextureCache::Source* src = nullptr);
 	Target* LookupDisplayTarget(GIFRegTEX0 TEX0, const GSVector2i& size, float scale, bool is_feedback);
 
+	/// Updates the index after the start or end block of a target has changed.
+	void UpdateTargetIndex(Target* t);
+
 	/// Looks up a target in the cache, and only returns it if the BP/BW match exactly.
 	Target* GetExactTarget(u32 BP, u32 BW, int type, u32 end_bp);
 	Target* GetTargetWithSharedBits(u32 BP, u32 PSM) const;
@@ -0,0 +1,649 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "common/Assertions.h"
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Timer.h"
+
+#include "Config.h"
+#include "GS/GSPerfMon.h"
+#include "GS/Renderers/HW/GSTextureDiskCache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+	static constexpr u32 INDEX_MAGIC = 0x43545347; // GSTC
+	static constexpr u32 INDEX_VERSION = 2;
+
+	// Textures larger than this fraction of the cache aren't worth the space.
+	static constexpr u64 MAX_TEXTURE_FRACTION = 16;
+
+	// Compaction keeps this fraction of the limit, so the next session has room for new textures.
+	static constexpr u64 COMPACT_KEEP_NUMERATOR = 3;
+	static constexpr u64 COMPACT_KEEP_DENOMINATOR = 4;
+
+	// Index entries for new textures are written out in batches, the whole index is rewritten at close anyway.
+	static constexpr size_t INDEX_WRITE_BATCH = 64;
+
+	struct IndexHeader
+	{
+		u32 magic;
+		u32 version;
+		u64 clock;
+	};
+	static_assert(sizeof(IndexHeader) == 16);
+
+	struct IndexEntry
+	{
+		GSTextureCache::HashCacheKey key;
+		u64 offset;
+		u64 last_used;
+		u32 size;
+		u32 width;
+		u32 height;
+		u16 levels;
+		u8 format;
+		u8 alpha_min;
+		u8 alpha_max;
+	};
+
+	// Entries are written field by field, see SerializeEntry().
+	static constexpr size_t SERIALIZED_ENTRY_SIZE = 73;
+
+	struct LevelHeader
+	{
+		u32 width;
+		u32 height;
+	};
+
+	using EntryMap = std::unordered_map<GSTextureCache::HashCacheKey, IndexEntry, GSTextureCache::HashCacheKeyHash>;
+} // namespace
+
+static bool OpenCache();
+static void CloseCache();
+static bool OpenFiles();
+static void CloseFiles();
+static void SerializeEntry(const IndexEntry& entry, u8* data);
+static IndexEntry DeserializeEntry(const u8* data);
+static bool LoadIndex();
+static bool WriteIndex(const char* path, const std::vector<IndexEntry>& entries);
+static bool MapBlob();
+static void UnmapBlob();
+static bool EnsureMapped(u64 end);
+static void Compact();
+static bool WritePendingIndexEntries();
+
+static std::string s_index_path;
+static std::string s_blob_path;
+static std::FILE* s_index_file = nullptr;
+static std::FILE* s_blob_file = nullptr;
+static u64 s_blob_size = 0;
+static u64 s_live_size = 0;
+static u64 s_size_limit = 0;
+static u64 s_clock = 0;
+static EntryMap s_entries;
+static std::vector<u8> s_pending_index_entries;
+static bool s_full_warning_shown = false;
+
+static const u8* s_mapping = nullptr;
+static u64 s_mapping_size = 0;
+#ifdef _WIN32
+static HANDLE s_mapping_handle = nullptr;
+#endif
+
+static u32 s_hits = 0;
+static u32 s_misses = 0;
+static u32 s_inserts = 0;
+
+void GSTextureDiskCache::Initialize()
+{
+	if (GSConfig.TextureDiskCache)
+		OpenCache();
+}
+
+void GSTextureDiskCache::UpdateConfig(const Pcsx2Config::GSOptions& old_config)
+{
+	if (GSConfig.TextureDiskCache == old_config.TextureDiskCache &&
+		GSConfig.TextureDiskCacheSize == old_config.TextureDiskCacheSize)
+	{
+		return;
+	}
+
+	CloseCache();
+	if (GSConfig.TextureDiskCache)
+		OpenCache();
+}
+
+void GSTextureDiskCache::Shutdown()
+{
+	CloseCache();
+}
+
+bool GSTextureDiskCache::IsOpen()
+{
+	return (s_blob_file != nullptr);
+}
+
+bool OpenCache()
+{
+	s_index_path = Path::Combine(EmuFolders::Cache, "gs_texture_cache.idx");
+	s_blob_path = Path::Combine(EmuFolders::Cache, "gs_texture_cache.bin");
+	s_size_limit = static_cast<u64>(std::max(GSConfig.TextureDiskCacheSize, 1u)) * _1mb;
+	s_full_warning_shown = false;
+	s_hits = 0;
+	s_misses = 0;
+	s_inserts = 0;
+
+	if (!LoadIndex())
+	{
+		// Start again, whatever was there doesn't match the index.
+		s_entries.clear();
+		s_clock = 0;
+		FileSystem::DeleteFilePath(s_blob_path.c_str());
+		if (!WriteIndex(s_index_path.c_str(), {}))
+			return false;
+	}
+
+	// Compacting copies everything we keep, so it's only done here rather than when the cache fills up
+	// mid-session. Going past the keep size means the last session was close to filling it.
+	if (s_blob_size > (s_size_limit * COMPACT_KEEP_NUMERATOR) / COMPACT_KEEP_DENOMINATOR)
+	{
+		Common::Timer timer;
+		Compact();
+		DevCon.WriteLn("Texture disk cache: compacted in %.2f ms", timer.GetTimeMilliseconds());
+	}
+
+	if (!OpenFiles())
+	{
+		Console.Error("Failed to open texture disk cache in '%s'.", EmuFolders::Cache.c_str());
+		CloseCache();
+		return false;
+	}
+
+	DevCon.WriteLn("Texture disk cache: %zu textures, %.1f MB of %.1f MB", s_entries.size(),
+		static_cast<double>(s_live_size) / _1mb, static_cast<double>(s_size_limit) / _1mb);
+	return true;
+}
+
+void CloseCache()
+{
+	if (!s_blob_file && !s_index_file)
+		return;
+
+	if (s_hits > 0 || s_misses > 0)
+	{
+		DevCon.WriteLn("Texture disk cache: %u hits, %u misses (%.1f%%), %u textures written", s_hits, s_misses,
+			(static_cast<double>(s_hits) * 100.0) / static_cast<double>(s_hits + s_misses), s_inserts);
+	}
+
+	const bool rewrite_index = (s_index_file != nullptr);
+	CloseFiles();
+
+	if (rewrite_index)
+	{
+		// Rewrite the index with the new use times, which also drops entries replaced during the session.
+		std::vector<IndexEntry> entries;
+		entries.reserve(s_entries.size());
+		for (const auto& it : s_entries)
+			entries.push_back(it.second);
+		WriteIndex(s_index_path.c_str(), entries);
+	}
+
+	s_entries.clear();
+	s_live_size = 0;
+	s_blob_size = 0;
+}
+
+bool OpenFiles()
+{
+	// The blob is mapped through the same handle, so it has to be readable as well as appendable.
+	s_blob_file = FileSystem::OpenCFile(s_blob_path.c_str(), "a+b");
+	s_index_file = FileSystem::OpenCFile(s_index_path.c_str(), "ab");
+	if (!s_blob_file || !s_index_file)
+	{
+		CloseFiles();
+		return false;
+	}
+
+	s_blob_size = static_cast<u64>(std::max<s64>(FileSystem::FSize64(s_blob_file), 0));
+	if (s_blob_size > 0 && !MapBlob())
+		Console.Warning("Failed to map texture disk cache, cached textures will not be used.");
+
+	return true;
+}
+
+void CloseFiles()
+{
+	UnmapBlob();
+
+	s_pending_index_entries.clear();
+
+	if (s_blob_file)
+	{
+		std::fclose(s_blob_file);
+		s_blob_file = nullptr;
+	}
+
+	if (s_index_file)
+	{
+		std::fclose(s_index_file);
+		s_index_file = nullptr;
+	}
+}
+
+template <typename T>
+static void SerializeField(u8*& data, T value)
+{
+	std::memcpy(data, &value, sizeof(value));
+	data += sizeof(value);
+}
+
+template <typename T>
+static void DeserializeField(const u8*& data, T* value)
+{
+	std::memcpy(value, data, sizeof(*value));
+	data += sizeof(*value);
+}
+
+void SerializeEntry(const IndexEntry& entry, u8* data)
+{
+	u8* const start = data;
+	SerializeField(data, entry.key.TEX0Hash);
+	SerializeField(data, entry.key.CLUTHash);
+	SerializeField(data, entry.key.TEX0.U64);
+	SerializeField(data, entry.key.TEXA.U64);
+	SerializeField(data, entry.key.region_width);
+	SerializeField(data, entry.key.region_height);
+	SerializeField(data, entry.offset);
+	SerializeField(data, entry.last_used);
+	SerializeField(data, entry.size);
+	SerializeField(data, entry.width);
+	SerializeField(data, entry.height);
+	SerializeField(data, entry.levels);
+	SerializeField(data, entry.format);
+	SerializeField(data, entry.alpha_min);
+	SerializeField(data, entry.alpha_max);
+	pxAssert(static_cast<size_t>(data - start) == SERIALIZED_ENTRY_SIZE);
+}
+
+IndexEntry DeserializeEntry(const u8* data)
+{
+	IndexEntry entry = {};
+	DeserializeField(data, &entry.key.TEX0Hash);
+	DeserializeField(data, &entry.key.CLUTHash);
+	DeserializeField(data, &entry.key.TEX0.U64);
+	DeserializeField(data, &entry.key.TEXA.U64);
+	DeserializeField(data, &entry.key.region_width);
+	DeserializeField(data, &entry.key.region_height);
+	DeserializeField(data, &entry.offset);
+	DeserializeField(data, &entry.last_used);
+	DeserializeField(data, &entry.size);
+	DeserializeField(data, &entry.width);
+	DeserializeField(data, &entry.height);
+	DeserializeField(data, &entry.levels);
+	DeserializeField(data, &entry.format);
+	DeserializeField(data, &entry.alpha_min);
+	DeserializeField(data, &entry.alpha_max);
+	return entry;
+}
+
+bool LoadIndex()
+{
+	s_entries.clear();
+	s_live_size = 0;
+	s_blob_size = 0;
+
+	const s64 blob_size = FileSystem::GetPathFileSize(s_blob_path.c_str());
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(s_index_path.c_str());
+	if (!data.has_value() || data->size() < sizeof(IndexHeader) || blob_size < 0)
+		return false;
+
+	IndexHeader header;
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != INDEX_MAGIC || header.version != INDEX_VERSION)
+	{
+		Console.Warning("Texture disk cache index is from a different version, discarding.");
+		return false;
+	}
+
+	s_clock = header.clock;
+	s_blob_size = static_cast<u64>(blob_size);
+
+	// Entries appended during a session come after the rest, and replace any with the same key.
+	const size_t count = (data->size() - sizeof(IndexHeader)) / SERIALIZED_ENTRY_SIZE;
+	for (size_t i = 0; i < count; i++)
+	{
+		const IndexEntry entry = DeserializeEntry(data->data() + sizeof(IndexHeader) + i * SERIALIZED_ENTRY_SIZE);
+		if ((entry.offset + entry.size) > s_blob_size || entry.levels == 0)
+			continue;
+
+		s_clock = std::max(s_clock, entry.last_used);
+		auto it = s_entries.find(entry.key);
+		if (it != s_entries.end())
+		{
+			s_live_size -= it->second.size;
+			it->second = entry;
+		}
+		else
+		{
+			s_entries.emplace(entry.key, entry);
+		}
+
+		s_live_size += entry.size;
+	}
+
+	return true;
+}
+
+bool WriteIndex(const char* path, const std::vector<IndexEntry>& entries)
+{
+	auto fp = FileSystem::OpenManagedCFile(path, "wb");
+	if (!fp)
+		return false;
+
+	std::vector<u8> data(entries.size() * SERIALIZED_ENTRY_SIZE);
+	for (size_t i = 0; i < entries.size(); i++)
+		SerializeEntry(entries[i], data.data() + i * SERIALIZED_ENTRY_SIZE);
+
+	const IndexHeader header = {INDEX_MAGIC, INDEX_VERSION, s_clock};
+	if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+		(!data.empty() && std::fwrite(data.data(), data.size(), 1, fp.get()) != 1))
+	{
+		Console.Error("Failed to write texture disk cache index '%s'.", path);
+		return false;
+	}
+
+	return true;
+}
+
+bool MapBlob()
+{
+	UnmapBlob();
+
+	// Appends have to reach the file before the new mapping can see them.
+	std::fflush(s_blob_file);
+	const u64 size = s_blob_size;
+	if (size == 0)
+		return false;
+
+#ifdef _WIN32
+	const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(s_blob_file)));
+	const HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_handle)
+		return false;
+
+	s_mapping = static_cast<const u8*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+	if (!s_mapping)
+	{
+		CloseHandle(mapping_handle);
+		return false;
+	}
+
+	s_mapping_handle = mapping_handle;
+#else
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fileno(s_blob_file), 0);
+	if (mapping == MAP_FAILED)
+		return false;
+
+	// Textures are looked up in whatever order the game uses them.
+	madvise(mapping, size, MADV_RANDOM);
+	s_mapping = static_cast<const u8*>(mapping);
+#endif
+
+	s_mapping_size = size;
+	return true;
+}
+
+void UnmapBlob()
+{
+	if (!s_mapping)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(s_mapping);
+	CloseHandle(s_mapping_handle);
+	s_mapping_handle = nullptr;
+#else
+	munmap(const_cast<u8*>(s_mapping), s_mapping_size);
+#endif
+
+	s_mapping = nullptr;
+	s_mapping_size = 0;
+}
+
+bool EnsureMapped(u64 end)
+{
+	// Textures written this session are past the end of the mapping, which only happens once they've
+	// been dropped from the hash cache and come back, so remapping on demand is cheap enough.
+	return (end <= s_mapping_size || (end <= s_blob_size && MapBlob()));
+}
+
+void Compact()
+{
+	// Keep the most recently used textures, copying them into a new blob.
+	std::vector<IndexEntry> entries;
+	entries.reserve(s_entries.size());
+	for (const auto& it : s_entries)
+		entries.push_back(it.second);
+	std::sort(entries.begin(), entries.end(),
+		[](const IndexEntry& lhs, const IndexEntry& rhs) { return lhs.last_used > rhs.last_used; });
+
+	const u64 keep_size = (s_size_limit * COMPACT_KEEP_NUMERATOR) / COMPACT_KEEP_DENOMINATOR;
+	const std::string temp_blob_path = s_blob_path + ".tmp";
+	const std::string temp_index_path = s_index_path + ".tmp";
+
+	auto src = FileSystem::OpenManagedCFile(s_blob_path.c_str(), "rb");
+	auto dst = FileSystem::OpenManagedCFile(temp_blob_path.c_str(), "wb");
+	if (!src || !dst)
+		return;
+
+	std::vector<IndexEntry> kept;
+	std::vector<u8> buffer;
+	u64 new_size = 0;
+	for (IndexEntry& entry : entries)
+	{
+		if ((new_size + entry.size) > keep_size)
+			continue;
+
+		buffer.resize(entry.size);
+		if (FileSystem::FSeek64(src.get(), static_cast<s64>(entry.offset), SEEK_SET) != 0 ||
+			std::fread(buffer.data(), entry.size, 1, src.get()) != 1 ||
+			std::fwrite(buffer.data(), entry.size, 1, dst.get()) != 1)
+		{
+			Console.Error("Failed to compact texture disk cache.");
+			dst.reset();
+			FileSystem::DeleteFilePath(temp_blob_path.c_str());
+			return;
+		}
+
+		entry.offset = new_size;
+		new_size += entry.size;
+		kept.push_back(entry);
+	}
+
+	src.reset();
+	dst.reset();
+	if (!WriteIndex(temp_index_path.c_str(), kept) ||
+		!FileSystem::RenamePath(temp_blob_path.c_str(), s_blob_path.c_str()) ||
+		!FileSystem::RenamePath(temp_index_path.c_str(), s_index_path.c_str()))
+	{
+		Console.Error("Failed to replace texture disk cache after compacting.");
+		FileSystem::DeleteFilePath(temp_blob_path.c_str());
+		FileSystem::DeleteFilePath(temp_index_path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("Texture disk cache: evicted %zu of %zu textures, %.1f MB -> %.1f MB", entries.size() - kept.size(),
+		entries.size(), static_cast<double>(s_blob_size) / _1mb, static_cast<double>(new_size) / _1mb);
+
+	s_entries.clear();
+	for (const IndexEntry& entry : kept)
+		s_entries.emplace(entry.key, entry);
+	s_live_size = new_size;
+	s_blob_size = new_size;
+}
+
+bool WritePendingIndexEntries()
+{
+	// The textures have to reach the blob first, so a crash can't leave entries pointing past its end.
+	if (std::fflush(s_blob_file) != 0 ||
+		std::fwrite(s_pending_index_entries.data(), s_pending_index_entries.size(), 1, s_index_file) != 1)
+	{
+		return false;
+	}
+
+	s_pending_index_entries.clear();
+	return true;
+}
+
+bool GSTextureDiskCache::LoadTexture(const GSTextureCache::HashCacheKey& key, GSTexture* tex, u32 levels, std::pair<u8, u8>* alpha_minmax)
+{
+	auto it = s_entries.find(key);
+	if (it == s_entries.end() || it->second.width != static_cast<u32>(tex->GetWidth()) ||
+		it->second.height != static_cast<u32>(tex->GetHeight()) || it->second.levels != levels ||
+		it->second.format != static_cast<u8>(tex->GetFormat()) || !EnsureMapped(it->second.offset + it->second.size))
+	{
+		s_misses++;
+		g_perfmon.Put(GSPerfMon::TextureDiskCacheMisses, 1);
+		return false;
+	}
+
+	IndexEntry& entry = it->second;
+	const u8* const start = s_mapping + entry.offset;
+	const u32 bpp = (tex->GetFormat() == GSTexture::Format::UNorm8) ? 1 : 4;
+
+	// Check every level fits before touching the texture, a truncated entry shouldn't leave it half uploaded.
+	u64 pos = 0;
+	for (u32 level = 0; level < levels; level++)
+	{
+		LevelHeader lh;
+		if ((pos + sizeof(lh)) > entry.size)
+			break;
+
+		std::memcpy(&lh, start + pos, sizeof(lh));
+		pos += sizeof(lh) + static_cast<u64>(lh.width) * bpp * lh.height;
+		if (lh.width == 0 || lh.height == 0 || pos > entry.size)
+		{
+			pos = entry.size + 1;
+			break;
+		}
+	}
+
+	if (pos > entry.size)
+	{
+		Console.Warning("Texture disk cache entry %" PRIx64 " is corrupted, ignoring it.", key.TEX0Hash);
+		s_live_size -= entry.size;
+		s_entries.erase(it);
+		s_misses++;
+		g_perfmon.Put(GSPerfMon::TextureDiskCacheMisses, 1);
+		return false;
+	}
+
+	const u8* ptr = start;
+	for (u32 level = 0; level < levels; level++)
+	{
+		LevelHeader lh;
+		std::memcpy(&lh, ptr, sizeof(lh));
+		ptr += sizeof(lh);
+
+		const u32 row_size = lh.width * bpp;
+		tex->Update(GSVector4i(0, 0, lh.width, lh.height), ptr, row_size, level);
+		ptr += row_size * lh.height;
+	}
+
+	if (alpha_minmax)
+		*alpha_minmax = std::make_pair(entry.alpha_min, entry.alpha_max);
+
+	entry.last_used = ++s_clock;
+	s_hits++;
+	g_perfmon.Put(GSPerfMon::TextureDiskCacheHits, 1);
+	return true;
+}
+
+void GSTextureDiskCache::AppendLevel(std::vector<u8>& data, u32 width, u32 height, const u8* texels, u32 pitch, u32 row_size)
+{
+	const LevelHeader lh = {width, height};
+	const size_t pos = data.size();
+	data.resize(pos + sizeof(lh) + static_cast<size_t>(row_size) * height);
+
+	u8* dst = data.data() + pos;
+	std::memcpy(dst, &lh, sizeof(lh));
+	dst += sizeof(lh);
+	for (u32 y = 0; y < height; y++)
+	{
+		std::memcpy(dst, texels, row_size);
+		dst += row_size;
+		texels += pitch;
+	}
+}
+
+void GSTextureDiskCache::InsertTexture(const GSTextureCache::HashCacheKey& key, const GSTexture* tex, u32 levels,
+	const std::pair<u8, u8>& alpha_minmax, const std::vector<u8>& data)
+{
+	if (data.empty() || data.size() > (s_size_limit / MAX_TEXTURE_FRACTION))
+		return;
+
+	if ((s_blob_size + data.size()) > s_size_limit)
+	{
+		if (!s_full_warning_shown)
+		{
+			Console.Warning("Texture disk cache is full, new textures will be cached after it's compacted next boot.");
+			s_full_warning_shown = true;
+		}
+
+		return;
+	}
+
+	IndexEntry entry = {};
+	entry.key = key;
+	entry.offset = s_blob_size;
+	entry.last_used = ++s_clock;
+	entry.size = static_cast<u32>(data.size());
+	entry.width = static_cast<u32>(tex->GetWidth());
+	entry.height = static_cast<u32>(tex->GetHeight());
+	entry.levels = static_cast<u16>(levels);
+	entry.format = static_cast<u8>(tex->GetFormat());
+	entry.alpha_min = alpha_minmax.first;
+	entry.alpha_max = alpha_minmax.second;
+
+	const size_t index_pos = s_pending_index_entries.size();
+	s_pending_index_entries.resize(index_pos + SERIALIZED_ENTRY_SIZE);
+	SerializeEntry(entry, s_pending_index_entries.data() + index_pos);
+	if (std::fwrite(data.data(), data.size(), 1, s_blob_file) != 1 ||
+		(s_pending_index_entries.size() >= (INDEX_WRITE_BATCH * SERIALIZED_ENTRY_SIZE) && !WritePendingIndexEntries()))
+	{
+		Console.Error("Failed to write to texture disk cache, closing it.");
+		CloseCache();
+		return;
+	}
+
+	s_blob_size += data.size();
+	s_inserts++;
+
+	auto it = s_entries.find(key);
+	if (it != s_entries.end())
+	{
+		// Same texture with a different size or format, the old copy is garbage now.
+		s_live_size -= it->second.size;
+		it->second = entry;
+	}
+	else
+	{
+		s_entries.emplace(key, entry);
+	}
+
+	s_live_size += entry.size;
+}
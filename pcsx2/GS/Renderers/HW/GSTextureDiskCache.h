@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/Renderers/HW/GSTextureCache.h"
+
+#include <utility>
+#include <vector>
+
+/// Keeps expanded hash cache textures on disk between sessions, so the first time a texture is seen after boot
+/// it can be uploaded straight from the file instead of being unswizzled and palette expanded again.
+///
+/// Textures are stored in one blob file in the cache directory, which is memory mapped, with a separate index
+/// of hash cache keys. Once the blob reaches the size limit, new textures aren't cached for the rest of the
+/// session. The least recently used textures are dropped the next time it's opened, by copying the rest to a
+/// new blob.
+namespace GSTextureDiskCache
+{
+	void Initialize();
+	void UpdateConfig(const Pcsx2Config::GSOptions& old_config);
+	void Shutdown();
+
+	bool IsOpen();
+
+	/// Uploads all levels of a cached texture with the same key, size, format and level count as tex.
+	/// Returns false if there isn't one, in which case the texture should be preloaded and inserted.
+	bool LoadTexture(const GSTextureCache::HashCacheKey& key, GSTexture* tex, u32 levels, std::pair<u8, u8>* alpha_minmax);
+
+	/// Appends one level of texels to the data for a texture which will be inserted.
+	void AppendLevel(std::vector<u8>& data, u32 width, u32 height, const u8* texels, u32 pitch, u32 row_size);
+
+	/// Writes a texture, built with AppendLevel(), to the cache.
+	void InsertTexture(const GSTextureCache::HashCacheKey& key, const GSTexture* tex, u32 levels,
+		const std::pair<u8, u8>& alpha_minmax, const std::vector<u8>& data);
+} // namespace GSTextureDiskCache
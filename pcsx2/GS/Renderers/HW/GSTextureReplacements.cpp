@@ -2,13 +2,16 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "common/AlignedMalloc.h"
+#include "common/BitUtils.h"
 #include "common/Console.h"
+#include "common/Error.h"
 #include "common/HashCombine.h"
 #include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
 #include "common/ScopedGuard.h"
 #include "common/TextureDecompress.h"
+#include "common/Timer.h"
 
 #include "Config.h"
 #include "Host.h"
@@ -29,6 +32,13 @@
 #include <tuple>
 #include <thread>
 
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
 // this is a #define instead of a variable to avoid warnings from non-literal format strings
 #define TEXTURE_FILENAME_FORMAT_STRING "%" PRIx64 "-%08x"
 #define TEXTURE_FILENAME_CLUT_FORMAT_STRING "%" PRIx64 "-%" PRIx64 "-%08x"
@@ -38,6 +48,7 @@
 #define TEXTURE_FILENAME_OLD_REGION_CLUT_FORMAT_STRING "%" PRIx64 "-%" PRIx64 "-r%" PRIx64 "-%08x"
 #define TEXTURE_REPLACEMENT_SUBDIRECTORY_NAME "replacements"
 #define TEXTURE_DUMP_SUBDIRECTORY_NAME "dumps"
+#define TEXTURE_REPLACEMENT_PACK_NAME "replacements.pack"
 
 namespace
 {
@@ -80,6 +91,57 @@ namespace
 		}
 	};
 	static_assert(sizeof(TextureName) == 32, "ReplacementTextureName is expected size");
+
+	/// Replacement packs hold every replacement for a game in one file, so they don't have to be found and
+	/// decoded individually. The file is the header, then the level data for each texture, then the index.
+	struct PackHeader
+	{
+		static constexpr u32 MAGIC = 0x50525347; // GSRP
+		static constexpr u32 VERSION = 1;
+
+		u32 magic;
+		u32 version;
+		u32 num_textures;
+		u32 reserved;
+		u64 index_offset;
+		u64 reserved2;
+	};
+	static_assert(sizeof(PackHeader) == 32);
+
+	struct PackEntry // 64 bytes
+	{
+		TextureName name;
+		u64 offset;
+		u64 size;
+		u32 width;
+		u32 height;
+		u8 format;
+		u8 num_levels;
+		u8 alpha_min;
+		u8 alpha_max;
+		u32 reserved;
+	};
+	static_assert(sizeof(PackEntry) == 64);
+
+	/// Precedes the data for each level, which is stored in the format it will be uploaded in.
+	struct PackLevel
+	{
+		static constexpr u32 ALIGNMENT = 16;
+
+		u32 width;
+		u32 height;
+		u32 pitch;
+		u32 size;
+	};
+	static_assert(sizeof(PackLevel) == 16);
+
+	enum class PackBuildState : u8
+	{
+		None,
+		Building,
+		Succeeded,
+		Failed,
+	};
 } // namespace
 
 namespace std
@@ -112,6 +174,14 @@ namespace GSTextureReplacements
 	static void QueueAsyncReplacementTextureLoad(const TextureName& name, const std::string& filename, bool mipmap, bool cache_only);
 	static void PrecacheReplacementTextures();
 	static void ClearReplacementTextures();
+	static void WarnIfMissingCompressedMipmaps(GSTexture::Format format, bool has_mips, bool mipmap);
+
+	static std::string GetReplacementPackPath();
+	static bool OpenReplacementPack(const std::string& path);
+	static void CloseReplacementPack();
+	static GSTexture* CreatePackedReplacementTexture(const PackEntry& entry, bool mipmap);
+	static bool WriteReplacementPack(const std::string& directory, const std::string& path, u32* num_textures, Error* error);
+	static void FinishReplacementPackBuild();
 
 	static void StartWorkerThread();
 	static void StopWorkerThread();
@@ -148,6 +218,22 @@ namespace GSTextureReplacements
 	static std::condition_variable s_worker_thread_cv;
 	static std::deque<std::pair<std::function<void()>, bool>> s_worker_thread_queue;
 	static bool s_worker_thread_running = false;
+
+	/// Memory mapped replacement pack, if the game has one. Textures are uploaded straight from the mapping.
+	static std::unordered_map<TextureName, const PackEntry*> s_pack_entries;
+	static const u8* s_pack_mapping = nullptr;
+	static u64 s_pack_size = 0;
+#ifdef _WIN32
+	static HANDLE s_pack_mapping_handle = nullptr;
+#endif
+	static u32 s_pack_uploads = 0;
+	static double s_pack_upload_time = 0.0;
+	static double s_pack_max_upload_time = 0.0;
+
+	/// Result of building a pack on the worker thread, protected by the replacement texture cache mutex.
+	static PackBuildState s_pack_build_state = PackBuildState::None;
+	static u32 s_pack_build_textures = 0;
+	static std::string s_pack_build_error;
 }; // namespace GSTextureReplacements
 
 TextureName GSTextureReplacements::CreateTextureName(const GSTextureCache::HashCacheKey& hash, u32 miplevel)
@@ -357,6 +443,7 @@ void GSTextureReplacements::ReloadReplacementMap()
 	{
 		s_replacement_texture_filenames.clear();
 		s_replacement_textures_without_clut_hash.clear();
+		CloseReplacementPack();
 
 		std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
 		s_replacement_texture_cache.clear();
@@ -368,6 +455,11 @@ void GSTextureReplacements::ReloadReplacementMap()
 	if (s_current_serial.empty() || !GSConfig.LoadTextureReplacements)
 		return;
 
+	// a pack takes the place of the loose files, scanning them is what it's there to avoid
+	const std::string pack_path(GetReplacementPackPath());
+	if (FileSystem::FileExists(pack_path.c_str()) && OpenReplacementPack(pack_path))
+		return;
+
 	const std::string replacement_dir(Path::Combine(GetGameTextureDirectory(), TEXTURE_REPLACEMENT_SUBDIRECTORY_NAME));
 
 	FileSystem::FindResultsArray files;
@@ -451,7 +543,7 @@ u32 GSTextureReplacements::CalcMipmapLevelsForReplacement(u32 width, u32 height)
 
 bool GSTextureReplacements::HasAnyReplacementTextures()
 {
-	return !s_replacement_texture_filenames.empty();
+	return !s_replacement_texture_filenames.empty() || !s_pack_entries.empty();
 }
 
 bool GSTextureReplacements::HasReplacementTextureWithOtherPalette(const GSTextureCache::HashCacheKey& hash)
@@ -466,6 +558,17 @@ GSTexture* GSTextureReplacements::LookupReplacementTexture(const GSTextureCache:
 	const TextureName name(CreateTextureName(hash, 0));
 	*pending = false;
 
+	// packs are already in the format the GPU wants, no need to go through the cache
+	if (!s_pack_entries.empty())
+	{
+		const auto pit = s_pack_entries.find(name);
+		if (pit == s_pack_entries.end())
+			return nullptr;
+
+		*alpha_minmax = std::make_pair(pit->second->alpha_min, pit->second->alpha_max);
+		return CreatePackedReplacementTexture(*pit->second, mipmap);
+	}
+
 	// replacement for this name exists?
 	auto fnit = s_replacement_texture_filenames.find(name);
 	if (fnit == s_replacement_texture_filenames.end())
@@ -678,6 +781,7 @@ void GSTextureReplacements::ClearReplacementTextures()
 {
 	s_replacement_texture_filenames.clear();
 	s_replacement_textures_without_clut_hash.clear();
+	CloseReplacementPack();
 
 	std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
 	s_replacement_texture_cache.clear();
@@ -685,11 +789,11 @@ void GSTextureReplacements::ClearReplacementTextures()
 	s_async_loaded_textures.clear();
 }
 
-GSTexture* GSTextureReplacements::CreateReplacementTexture(const ReplacementTexture& rtex, bool mipmap)
+void GSTextureReplacements::WarnIfMissingCompressedMipmaps(GSTexture::Format format, bool has_mips, bool mipmap)
 {
 	// can't use generated mipmaps with compressed formats, because they can't be rendered to
 	// in the future I guess we could decompress the dds and generate them... but there's no reason that modders can't generate mips in dds
-	if (mipmap && GSTexture::IsCompressedFormat(rtex.format) && rtex.mips.empty())
+	if (mipmap && GSTexture::IsCompressedFormat(format) && !has_mips)
 	{
 		static bool log_once = false;
 		if (!log_once)
@@ -701,9 +805,12 @@ GSTexture* GSTextureReplacements::CreateReplacementTexture(const ReplacementText
 				Host::OSD_WARNING_DURATION);
 			log_once = true;
 		}
-
-		mipmap = false;
 	}
+}
+
+GSTexture* GSTextureReplacements::CreateReplacementTexture(const ReplacementTexture& rtex, bool mipmap)
+{
+	WarnIfMissingCompressedMipmaps(rtex.format, !rtex.mips.empty(), mipmap);
 
 	GSTexture* tex = g_gs_device->CreateTexture(rtex.width, rtex.height, static_cast<int>(rtex.mips.size()) + 1, rtex.format);
 	if (!tex)
@@ -727,6 +834,8 @@ GSTexture* GSTextureReplacements::CreateReplacementTexture(const ReplacementText
 
 void GSTextureReplacements::ProcessAsyncLoadedTextures()
 {
+	FinishReplacementPackBuild();
+
 	// this holds the lock while doing the upload, but it should be reasonably quick
 	std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
 	for (const auto& [name, mipmap] : s_async_loaded_textures)
@@ -761,8 +870,12 @@ void GSTextureReplacements::DumpTexture(const GSTextureCache::HashCacheKey& hash
 {
 	// check if it's been dumped or replaced already
 	const TextureName name(CreateTextureName(hash, level));
-	if (s_dumped_textures.find(name) != s_dumped_textures.end() || s_replacement_texture_filenames.find(name) != s_replacement_texture_filenames.end())
+	if (s_dumped_textures.find(name) != s_dumped_textures.end() ||
+		s_replacement_texture_filenames.find(name) != s_replacement_texture_filenames.end() ||
+		s_pack_entries.find(name) != s_pack_entries.end())
+	{
 		return;
+	}
 
 	s_dumped_textures.insert(name);
 
@@ -804,6 +917,352 @@ void GSTextureReplacements::ClearDumpedTextureList()
 	s_dumped_textures.clear();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Replacement Packs
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string GSTextureReplacements::GetReplacementPackPath()
+{
+	return Path::Combine(GetGameTextureDirectory(), TEXTURE_REPLACEMENT_PACK_NAME);
+}
+
+bool GSTextureReplacements::OpenReplacementPack(const std::string& path)
+{
+	Common::Timer timer;
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "rb");
+	const s64 size = fp ? FileSystem::FSize64(fp.get()) : -1;
+	if (size < static_cast<s64>(sizeof(PackHeader)))
+	{
+		Console.Error(fmt::format("Failed to open replacement pack '{}'.", path));
+		return false;
+	}
+
+#ifdef _WIN32
+	const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(fp.get())));
+	const HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	const u8* mapping = mapping_handle ? static_cast<const u8*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+	if (!mapping)
+	{
+		if (mapping_handle)
+			CloseHandle(mapping_handle);
+		Console.Error(fmt::format("Failed to map replacement pack '{}'.", path));
+		return false;
+	}
+
+	s_pack_mapping_handle = mapping_handle;
+#else
+	void* mapping_ptr = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fileno(fp.get()), 0);
+	if (mapping_ptr == MAP_FAILED)
+	{
+		Console.Error(fmt::format("Failed to map replacement pack '{}'.", path));
+		return false;
+	}
+
+	// textures are pulled in whatever order the game uses them
+	madvise(mapping_ptr, static_cast<size_t>(size), MADV_RANDOM);
+	const u8* mapping = static_cast<const u8*>(mapping_ptr);
+#endif
+
+	// the file can be closed now, the mapping keeps it alive
+	s_pack_mapping = mapping;
+	s_pack_size = static_cast<u64>(size);
+
+	PackHeader header;
+	std::memcpy(&header, mapping, sizeof(header));
+	if (header.magic != PackHeader::MAGIC || header.version != PackHeader::VERSION || header.index_offset > s_pack_size ||
+		(s_pack_size - header.index_offset) / sizeof(PackEntry) < header.num_textures)
+	{
+		Console.Error(fmt::format("Replacement pack '{}' is invalid or from a different version, ignoring it.", path));
+		CloseReplacementPack();
+		return false;
+	}
+
+	const PackEntry* entries = reinterpret_cast<const PackEntry*>(mapping + header.index_offset);
+	s_pack_entries.reserve(header.num_textures);
+	for (u32 i = 0; i < header.num_textures; i++)
+	{
+		const PackEntry& entry = entries[i];
+		if (entry.offset > header.index_offset || entry.size > (header.index_offset - entry.offset) || entry.num_levels == 0)
+		{
+			Console.Warning("Skipping invalid replacement pack entry %u.", i);
+			continue;
+		}
+
+		s_pack_entries.emplace(entry.name, &entry);
+
+		// zero out the CLUT hash, because we need this for checking if there's any replacements with this hash when using paltex
+		TextureName name(entry.name);
+		name.CLUTHash = 0;
+		s_replacement_textures_without_clut_hash.insert(name);
+	}
+
+	Console.WriteLn(fmt::format("Opened replacement pack with {} textures ({:.1f} MB) in {:.2f} ms.", s_pack_entries.size(),
+		static_cast<double>(s_pack_size) / 1048576.0, timer.GetTimeMilliseconds()));
+	return true;
+}
+
+void GSTextureReplacements::CloseReplacementPack()
+{
+	if (!s_pack_mapping)
+		return;
+
+	if (s_pack_uploads > 0)
+	{
+		Console.WriteLn(fmt::format("Uploaded {} packed replacement textures, {:.3f} ms average, {:.3f} ms worst.", s_pack_uploads,
+			s_pack_upload_time / static_cast<double>(s_pack_uploads), s_pack_max_upload_time));
+	}
+
+	s_pack_entries.clear();
+
+#ifdef _WIN32
+	UnmapViewOfFile(s_pack_mapping);
+	CloseHandle(s_pack_mapping_handle);
+	s_pack_mapping_handle = nullptr;
+#else
+	munmap(const_cast<u8*>(s_pack_mapping), s_pack_size);
+#endif
+
+	s_pack_mapping = nullptr;
+	s_pack_size = 0;
+	s_pack_uploads = 0;
+	s_pack_upload_time = 0.0;
+	s_pack_max_upload_time = 0.0;
+}
+
+GSTexture* GSTextureReplacements::CreatePackedReplacementTexture(const PackEntry& entry, bool mipmap)
+{
+	Common::Timer timer;
+
+	const GSTexture::Format format = static_cast<GSTexture::Format>(entry.format);
+	WarnIfMissingCompressedMipmaps(format, entry.num_levels > 1, mipmap);
+
+	// only the base level is wanted without mipmapping, same as the file loaders
+	const u32 num_levels = mipmap ? entry.num_levels : 1u;
+
+	// check all the levels are there before creating anything, the pack could have been truncated
+	const u8* const start = s_pack_mapping + entry.offset;
+	u64 pos = 0;
+	for (u32 level = 0; level < num_levels; level++)
+	{
+		PackLevel lh;
+		if ((pos + sizeof(lh)) > entry.size)
+			return nullptr;
+
+		std::memcpy(&lh, start + pos, sizeof(lh));
+		pos = Common::AlignUpPow2(pos + sizeof(lh) + lh.size, PackLevel::ALIGNMENT);
+		if (lh.width == 0 || lh.height == 0 || pos > entry.size)
+		{
+			Console.Warning("Replacement pack entry %" PRIx64 " is corrupted.", entry.name.TEX0Hash);
+			return nullptr;
+		}
+	}
+
+	GSTexture* tex = g_gs_device->CreateTexture(entry.width, entry.height, static_cast<int>(num_levels), format);
+	if (!tex)
+		return nullptr;
+
+	pos = 0;
+	for (u32 level = 0; level < num_levels; level++)
+	{
+		PackLevel lh;
+		std::memcpy(&lh, start + pos, sizeof(lh));
+		tex->Update(GSVector4i(0, 0, static_cast<int>(lh.width), static_cast<int>(lh.height)), start + pos + sizeof(lh), lh.pitch, level);
+		pos = Common::AlignUpPow2(pos + sizeof(lh) + lh.size, PackLevel::ALIGNMENT);
+	}
+
+	const double time = timer.GetTimeMilliseconds();
+	s_pack_uploads++;
+	s_pack_upload_time += time;
+	s_pack_max_upload_time = std::max(s_pack_max_upload_time, time);
+	return tex;
+}
+
+bool GSTextureReplacements::WriteReplacementPack(const std::string& directory, const std::string& path, u32* num_textures, Error* error)
+{
+	FileSystem::FindResultsArray files;
+	if (!FileSystem::FindFiles(directory.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files))
+	{
+		Error::SetStringFmt(error, "No replacement textures found in '{}'.", directory);
+		return false;
+	}
+
+	std::vector<std::pair<TextureName, std::string>> textures;
+	for (FILESYSTEM_FIND_DATA& fd : files)
+	{
+		const std::string filename(Path::GetFileName(fd.FileName));
+		if (!GetLoader(filename))
+			continue;
+
+		std::optional<TextureName> name = ParseReplacementName(filename);
+		if (name.has_value())
+			textures.emplace_back(name.value(), std::move(fd.FileName));
+	}
+	if (textures.empty())
+	{
+		Error::SetStringFmt(error, "No replacement textures found in '{}'.", directory);
+		return false;
+	}
+
+	// same order every time, so rebuilding an unchanged directory gives the same file
+	std::sort(textures.begin(), textures.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "wb", error);
+	if (!fp)
+		return false;
+
+	PackHeader header = {};
+	header.magic = PackHeader::MAGIC;
+	header.version = PackHeader::VERSION;
+	u64 pos = sizeof(header);
+	if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1)
+	{
+		Error::SetErrno(error, "fwrite() failed: ", errno);
+		return false;
+	}
+
+	static constexpr u8 padding[PackLevel::ALIGNMENT] = {};
+	const auto write_level = [&fp, &pos](u32 width, u32 height, u32 pitch, const std::vector<u8>& data) {
+		const PackLevel lh = {width, height, pitch, static_cast<u32>(data.size())};
+		const u64 end = pos + sizeof(lh) + data.size();
+		const size_t pad = static_cast<size_t>(Common::AlignUpPow2(end, PackLevel::ALIGNMENT) - end);
+		if (std::fwrite(&lh, sizeof(lh), 1, fp.get()) != 1 || std::fwrite(data.data(), data.size(), 1, fp.get()) != 1 ||
+			(pad > 0 && std::fwrite(padding, pad, 1, fp.get()) != 1))
+		{
+			return false;
+		}
+
+		pos = end + pad;
+		return true;
+	};
+
+	std::vector<PackEntry> entries;
+	entries.reserve(textures.size());
+	for (const auto& [name, filename] : textures)
+	{
+		// keep the mips, so the pack works whether mipmapping is on or not
+		std::optional<ReplacementTexture> rtex(LoadReplacementTexture(name, filename, false));
+		if (!rtex.has_value())
+			continue;
+
+		PackEntry entry = {};
+		entry.name = name;
+		entry.offset = pos;
+		entry.width = rtex->width;
+		entry.height = rtex->height;
+		entry.format = static_cast<u8>(rtex->format);
+		entry.num_levels = static_cast<u8>(rtex->mips.size() + 1);
+		entry.alpha_min = rtex->alpha_minmax.first;
+		entry.alpha_max = rtex->alpha_minmax.second;
+
+		bool written = write_level(rtex->width, rtex->height, rtex->pitch, rtex->data);
+		for (const ReplacementTexture::MipData& mip : rtex->mips)
+			written = written && write_level(mip.width, mip.height, mip.pitch, mip.data);
+		if (!written)
+		{
+			Error::SetErrno(error, "fwrite() failed: ", errno);
+			return false;
+		}
+
+		entry.size = pos - entry.offset;
+		entries.push_back(entry);
+	}
+
+	header.num_textures = static_cast<u32>(entries.size());
+	header.index_offset = pos;
+	if ((!entries.empty() && std::fwrite(entries.data(), sizeof(PackEntry) * entries.size(), 1, fp.get()) != 1) ||
+		FileSystem::FSeek64(fp.get(), 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+		std::fflush(fp.get()) != 0)
+	{
+		Error::SetErrno(error, "fwrite() failed: ", errno);
+		return false;
+	}
+
+	*num_textures = header.num_textures;
+	return true;
+}
+
+bool GSTextureReplacements::BuildReplacementPack()
+{
+	if (s_current_serial.empty() || !s_worker_thread_running)
+		return false;
+
+	{
+		std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
+		if (s_pack_build_state == PackBuildState::Building)
+			return false;
+		s_pack_build_state = PackBuildState::Building;
+	}
+
+	// written next to the real pack, which is still mapped, and swapped in on the GS thread once it's done
+	const std::string directory(Path::Combine(GetGameTextureDirectory(), TEXTURE_REPLACEMENT_SUBDIRECTORY_NAME));
+	std::string temp_path(GetReplacementPackPath() + ".tmp");
+	QueueWorkerThreadItem([directory, temp_path = std::move(temp_path)]() {
+		Common::Timer timer;
+		Error error;
+		u32 num_textures = 0;
+		const bool result = WriteReplacementPack(directory, temp_path, &num_textures, &error);
+		if (result)
+		{
+			Console.WriteLn(fmt::format("Built replacement pack with {} textures in {:.2f} seconds.", num_textures,
+				timer.GetTimeSeconds()));
+		}
+		else
+		{
+			FileSystem::DeleteFilePath(temp_path.c_str());
+		}
+
+		std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
+		s_pack_build_state = result ? PackBuildState::Succeeded : PackBuildState::Failed;
+		s_pack_build_textures = num_textures;
+		s_pack_build_error = error.GetDescription();
+	}, false);
+
+	return true;
+}
+
+void GSTextureReplacements::FinishReplacementPackBuild()
+{
+	PackBuildState state;
+	u32 num_textures;
+	std::string error;
+	{
+		std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
+		state = s_pack_build_state;
+		if (state != PackBuildState::Succeeded && state != PackBuildState::Failed)
+			return;
+
+		num_textures = s_pack_build_textures;
+		error = std::move(s_pack_build_error);
+		s_pack_build_state = PackBuildState::None;
+	}
+
+	if (state == PackBuildState::Failed)
+	{
+		Console.Error(fmt::format("Failed to build replacement pack: {}", error));
+		Host::AddIconOSDMessage("BuildReplacementPack", ICON_FA_EXCLAMATION_CIRCLE,
+			fmt::format(TRANSLATE_FS("GS", "Failed to build texture replacement pack: {}"), error), Host::OSD_ERROR_DURATION);
+		return;
+	}
+
+	// the old pack has to be unmapped before it can be replaced on Windows
+	const std::string pack_path(GetReplacementPackPath());
+	CloseReplacementPack();
+
+	Error rename_error;
+	if (!FileSystem::RenamePath((pack_path + ".tmp").c_str(), pack_path.c_str(), &rename_error))
+	{
+		Console.Error(fmt::format("Failed to replace '{}': {}", pack_path, rename_error.GetDescription()));
+		return;
+	}
+
+	Host::AddIconOSDMessage("BuildReplacementPack", ICON_FA_IMAGES,
+		fmt::format(TRANSLATE_FS("GS", "Built texture replacement pack with {} textures."), num_textures), Host::OSD_INFO_DURATION);
+
+	ReloadReplacementMap();
+	g_gs_renderer->PurgeTextureCache(true, false, true);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Worker Thread
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -834,6 +1293,9 @@ void GSTextureReplacements::StopWorkerThread()
 
 	// clear out workery-things too
 	CancelPendingLoadsAndDumps();
+
+	// a queued pack build might not have run
+	s_pack_build_state = PackBuildState::None;
 }
 
 void GSTextureReplacements::QueueWorkerThreadItem(std::function<void()> fn, bool high_priority)
@@ -47,6 +47,10 @@ namespace GSTextureReplacements
 		GSTextureCache::SourceRegion region, GSLocalMemory& mem, u32 level);
 	void ClearDumpedTextureList();
 
+	/// Converts the current game's replacement directory to a pack on the worker thread, which is used in place of
+	/// the directory once it's built. Returns false if there's nothing to build from, or a build is already running.
+	bool BuildReplacementPack();
+
 	/// Loader will take a filename and interpret the format (e.g. DDS, PNG, etc).
 	using ReplacementTextureLoader = bool (*)(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
 	ReplacementTextureLoader GetLoader(const std::string_view filename);
@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/Renderers/Null/GSDeviceHeadless.h"
+#include "GS/Renderers/Null/GSTextureHeadless.h"
+#include "GS/GSPerfMon.h"
+
+#include "common/StringUtil.h"
+
+#include <algorithm>
+
+GSDeviceHeadless::GSDeviceHeadless() = default;
+
+GSDeviceHeadless::~GSDeviceHeadless() = default;
+
+RenderAPI GSDeviceHeadless::GetRenderAPI() const
+{
+	return RenderAPI::None;
+}
+
+bool GSDeviceHeadless::HasSurface() const
+{
+	return false;
+}
+
+bool GSDeviceHeadless::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
+{
+	if (!GSDevice::Create(vsync_mode, allow_present_throttle))
+		return false;
+
+	m_name = "Headless";
+	m_max_texture_size = 8192;
+
+	// Report what a typical desktop GPU supports, so the renderer takes the same paths it would there.
+	m_features.broken_point_sampler = false;
+	m_features.vs_expand = true;
+	m_features.primitive_id = true;
+	m_features.texture_barrier = true;
+	m_features.provoking_vertex_last = true;
+	m_features.point_expand = false;
+	m_features.line_expand = false;
+	m_features.prefer_new_textures = true;
+	m_features.dxt_textures = true;
+	m_features.bptc_textures = true;
+	m_features.framebuffer_fetch = false;
+	m_features.stencil_buffer = true;
+	m_features.cas_sharpening = false;
+	m_features.test_and_sample_depth = true;
+
+	return true;
+}
+
+bool GSDeviceHeadless::UpdateWindow()
+{
+	return true;
+}
+
+void GSDeviceHeadless::ResizeWindow(s32 new_window_width, s32 new_window_height, float new_window_scale)
+{
+}
+
+bool GSDeviceHeadless::SupportsExclusiveFullscreen() const
+{
+	return false;
+}
+
+void GSDeviceHeadless::DestroySurface()
+{
+}
+
+std::string GSDeviceHeadless::GetDriverInfo() const
+{
+	return "Headless device, textures are kept in system memory and draws are not rendered.";
+}
+
+void GSDeviceHeadless::SetVSyncMode(GSVSyncMode mode, bool allow_present_throttle)
+{
+	m_vsync_mode = mode;
+	m_allow_present_throttle = allow_present_throttle;
+}
+
+GSDevice::PresentResult GSDeviceHeadless::BeginPresent(bool frame_skip)
+{
+	// Nowhere to present to.
+	return PresentResult::FrameSkipped;
+}
+
+void GSDeviceHeadless::EndPresent()
+{
+}
+
+bool GSDeviceHeadless::SetGPUTimingEnabled(bool enabled)
+{
+	return false;
+}
+
+float GSDeviceHeadless::GetAndResetAccumulatedGPUTime()
+{
+	return 0.0f;
+}
+
+GSTexture* GSDeviceHeadless::CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format)
+{
+	return new GSTextureHeadless(type, width, height, levels, format);
+}
+
+std::unique_ptr<GSDownloadTexture> GSDeviceHeadless::CreateDownloadTexture(u32 width, u32 height, GSTexture::Format format)
+{
+	return GSDownloadTextureHeadless::Create(width, height, format);
+}
+
+void GSDeviceHeadless::CommitClear(GSTexture* tex)
+{
+	if (tex)
+		static_cast<GSTextureHeadless*>(tex)->CommitClear();
+}
+
+void GSDeviceHeadless::CopyRect(GSTexture* sTex, GSTexture* dTex, const GSVector4i& r, u32 destX, u32 destY)
+{
+	CommitClear(sTex);
+	CommitClear(dTex);
+	g_perfmon.Put(GSPerfMon::TextureCopies, 1);
+
+	// Depth is copied between depth formats through shaders, so only same-format copies make it here.
+	if (sTex->GetFormat() != dTex->GetFormat() || sTex->IsCompressedFormat())
+		return;
+
+	const GSVector4i src = r.rintersect(sTex->GetRect());
+	const int width = std::min(src.width(), dTex->GetWidth() - static_cast<int>(destX));
+	const int height = std::min(src.height(), dTex->GetHeight() - static_cast<int>(destY));
+	if (width <= 0 || height <= 0)
+		return;
+
+	GSTextureHeadless* const stex = static_cast<GSTextureHeadless*>(sTex);
+	GSTextureHeadless* const dtex = static_cast<GSTextureHeadless*>(dTex);
+	StringUtil::StrideMemCpy(dtex->GetTexelPointer(destX, destY), dtex->GetLevelPitch(0), stex->GetTexelPointer(src.left, src.top),
+		stex->GetLevelPitch(0), dtex->CalcUploadPitch(width), height);
+}
+
+void GSDeviceHeadless::StretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, ShaderConvert shader, bool linear)
+{
+	// Unscaled plain copies are cheap enough to do properly, which keeps readbacks of copied targets meaningful.
+	const GSVector4i src = GSVector4i(sRect * GSVector4(sTex->GetSize()).xyxy());
+	const GSVector4i dst = GSVector4i(dRect);
+	if (shader == ShaderConvert::COPY && src.width() == dst.width() && src.height() == dst.height())
+	{
+		CopyRect(sTex, dTex, src, dst.left, dst.top);
+		return;
+	}
+
+	CommitClear(sTex);
+	CommitClear(dTex);
+	g_perfmon.Put(GSPerfMon::TextureCopies, 1);
+}
+
+void GSDeviceHeadless::StretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, bool red, bool green, bool blue, bool alpha, ShaderConvert shader)
+{
+	if (red && green && blue && alpha)
+	{
+		StretchRect(sTex, sRect, dTex, dRect, shader, false);
+		return;
+	}
+
+	CommitClear(sTex);
+	CommitClear(dTex);
+	g_perfmon.Put(GSPerfMon::TextureCopies, 1);
+}
+
+void GSDeviceHeadless::PresentRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, PresentShader shader, float shaderTime, bool linear)
+{
+	CommitClear(dTex);
+}
+
+void GSDeviceHeadless::UpdateCLUTTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize)
+{
+	CommitClear(dTex);
+}
+
+void GSDeviceHeadless::ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM, GSTexture* dTex, u32 DBW, u32 DPSM)
+{
+	CommitClear(dTex);
+}
+
+void GSDeviceHeadless::FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect)
+{
+	CommitClear(dTex);
+}
+
+void GSDeviceHeadless::DoMerge(GSTexture* sTex[3], GSVector4* sRect, GSTexture* dTex, GSVector4* dRect, const GSRegPMODE& PMODE, const GSRegEXTBUF& EXTBUF, u32 c, const bool linear)
+{
+	CommitClear(dTex);
+}
+
+void GSDeviceHeadless::DoInterlace(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, ShaderInterlace shader, bool linear, const InterlaceConstantBuffer& cb)
+{
+	CommitClear(dTex);
+}
+
+void GSDeviceHeadless::DoFXAA(GSTexture* sTex, GSTexture* dTex)
+{
+	CommitClear(dTex);
+}
+
+void GSDeviceHeadless::DoShadeBoost(GSTexture* sTex, GSTexture* dTex, const float params[4])
+{
+	CommitClear(dTex);
+}
+
+bool GSDeviceHeadless::DoCAS(GSTexture* sTex, GSTexture* dTex, bool sharpen_only, const std::array<u32, NUM_CAS_CONSTANTS>& constants)
+{
+	return false;
+}
+
+void GSDeviceHeadless::RenderHW(GSHWDrawConfig& config)
+{
+	// Clears are resolved the same way a render pass load would, the draw itself is skipped.
+	CommitClear(config.rt);
+	CommitClear(config.ds);
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+}
+
+void GSDeviceHeadless::ClearSamplerCache()
+{
+}
+
+void GSDeviceHeadless::PushDebugGroup(const char* fmt, ...)
+{
+}
+
+void GSDeviceHeadless::PopDebugGroup()
+{
+}
+
+void GSDeviceHeadless::InsertDebugMessage(DebugMessageCategory category, const char* fmt, ...)
+{
+}
@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/Renderers/Null/GSTextureHeadless.h"
+#include "GS/GSPerfMon.h"
+
+#include "common/Assertions.h"
+#include "common/StringUtil.h"
+
+#include <algorithm>
+#include <cstring>
+
+GSTextureHeadless::GSTextureHeadless(Type type, int width, int height, int levels, Format format)
+{
+	m_type = type;
+	m_format = format;
+	m_size.x = width;
+	m_size.y = height;
+	m_mipmap_levels = levels;
+
+	u32 total_size = 0;
+	m_level_offsets.reserve(levels);
+	for (int level = 0; level < levels; level++)
+	{
+		m_level_offsets.push_back(total_size);
+		total_size += CalcUploadSize(std::max(height >> level, 1), GetLevelPitch(level));
+	}
+
+	m_data = std::make_unique_for_overwrite<u8[]>(total_size);
+}
+
+GSTextureHeadless::~GSTextureHeadless() = default;
+
+void* GSTextureHeadless::GetNativeHandle() const
+{
+	return m_data.get();
+}
+
+u32 GSTextureHeadless::GetLevelPitch(int level) const
+{
+	return CalcUploadPitch(std::max(m_size.x >> level, 1));
+}
+
+u8* GSTextureHeadless::GetTexelPointer(int x, int y, int level) const
+{
+	const u32 block_size = GetCompressedBlockSize();
+	return m_data.get() + m_level_offsets[level] + (static_cast<u32>(y) / block_size) * GetLevelPitch(level) +
+		   (static_cast<u32>(x) / block_size) * GetCompressedBytesPerBlock();
+}
+
+bool GSTextureHeadless::Update(const GSVector4i& r, const void* data, int pitch, int layer)
+{
+	if (layer >= m_mipmap_levels)
+		return false;
+
+	// Anything outside the rectangle has to keep the clear colour.
+	if (layer == 0 && !r.eq(GetRect()))
+		CommitClear();
+	else if (layer == 0)
+		m_state = State::Dirty;
+
+	const u32 block_size = GetCompressedBlockSize();
+	const u32 rows = (static_cast<u32>(r.height()) + (block_size - 1)) / block_size;
+	StringUtil::StrideMemCpy(GetTexelPointer(r.left, r.top, layer), GetLevelPitch(layer), data, pitch,
+		CalcUploadPitch(r.width()), rows);
+
+	g_perfmon.Put(GSPerfMon::TextureUploads, 1);
+	m_needs_mipmaps_generated |= (layer == 0);
+	return true;
+}
+
+bool GSTextureHeadless::Map(GSMap& m, const GSVector4i* r, int layer)
+{
+	if (layer >= m_mipmap_levels || IsCompressedFormat())
+		return false;
+
+	const GSVector4i rc = r ? *r : GetRect();
+	if (layer == 0 && !rc.eq(GetRect()))
+		CommitClear();
+	else if (layer == 0)
+		m_state = State::Dirty;
+
+	m.bits = GetTexelPointer(rc.left, rc.top, layer);
+	m.pitch = static_cast<int>(GetLevelPitch(layer));
+
+	g_perfmon.Put(GSPerfMon::TextureUploads, 1);
+	m_needs_mipmaps_generated |= (layer == 0);
+	return true;
+}
+
+void GSTextureHeadless::Unmap()
+{
+	// Always mapped.
+}
+
+void GSTextureHeadless::GenerateMipmap()
+{
+	// Nothing samples from the lower levels, so there's no point in spending time filtering them.
+}
+
+#ifdef PCSX2_DEVBUILD
+
+void GSTextureHeadless::SetDebugName(std::string_view name)
+{
+}
+
+#endif
+
+void GSTextureHeadless::CommitClear()
+{
+	if (m_state != State::Cleared)
+	{
+		if (m_state == State::Invalidated)
+			m_state = State::Dirty;
+		return;
+	}
+
+	m_state = State::Dirty;
+
+	const u32 count = static_cast<u32>(m_size.x) * static_cast<u32>(m_size.y);
+	switch (m_format)
+	{
+		case Format::Color:
+		case Format::UInt32:
+		case Format::PrimID:
+			std::fill_n(reinterpret_cast<u32*>(m_data.get()), count, m_clear_value.color);
+			break;
+
+		case Format::DepthStencil:
+			std::fill_n(reinterpret_cast<float*>(m_data.get()), count, m_clear_value.depth);
+			break;
+
+		case Format::HDRColor:
+		{
+			// RGBA16 UNorm, widen each channel so 0xFF stays at full intensity.
+			u64 value = 0;
+			for (u32 i = 0; i < 4; i++)
+				value |= static_cast<u64>(((m_clear_value.color >> (i * 8)) & 0xFF) * 257) << (i * 16);
+			std::fill_n(reinterpret_cast<u64*>(m_data.get()), count, value);
+		}
+		break;
+
+		case Format::UInt16:
+			std::fill_n(reinterpret_cast<u16*>(m_data.get()), count, static_cast<u16>(m_clear_value.color));
+			break;
+
+		case Format::UNorm8:
+			std::memset(m_data.get(), static_cast<u8>(m_clear_value.color), count);
+			break;
+
+		default:
+			break;
+	}
+}
+
+GSDownloadTextureHeadless::GSDownloadTextureHeadless(u32 width, u32 height, GSTexture::Format format)
+	: GSDownloadTexture(width, height, format)
+{
+}
+
+GSDownloadTextureHeadless::~GSDownloadTextureHeadless() = default;
+
+std::unique_ptr<GSDownloadTextureHeadless> GSDownloadTextureHeadless::Create(u32 width, u32 height, GSTexture::Format format)
+{
+	std::unique_ptr<GSDownloadTextureHeadless> tex(new GSDownloadTextureHeadless(width, height, format));
+	tex->m_buffer = std::make_unique_for_overwrite<u8[]>(GetBufferSize(width, height, format));
+	tex->m_map_pointer = tex->m_buffer.get();
+	return tex;
+}
+
+void GSDownloadTextureHeadless::CopyFromTexture(
+	const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
+{
+	GSTextureHeadless* const tex = static_cast<GSTextureHeadless*>(stex);
+	tex->CommitClear();
+
+	pxAssert(tex->GetFormat() == m_format);
+	pxAssert(drc.width() == src.width() && drc.height() == src.height());
+	pxAssert(src.z <= tex->GetWidth() && src.w <= tex->GetHeight());
+	pxAssert(static_cast<u32>(drc.z) <= m_width && static_cast<u32>(drc.w) <= m_height);
+	pxAssert(src_level < static_cast<u32>(tex->GetMipmapLevels()));
+	pxAssert((drc.left == 0 && drc.top == 0) || !use_transfer_pitch);
+
+	u32 copy_offset, copy_size, copy_rows;
+	m_current_pitch = GetTransferPitch(use_transfer_pitch ? static_cast<u32>(drc.width()) : m_width, 1);
+	GetTransferSize(drc, &copy_offset, &copy_size, &copy_rows);
+	g_perfmon.Put(GSPerfMon::Readbacks, 1);
+
+	StringUtil::StrideMemCpy(m_buffer.get() + copy_offset, m_current_pitch, tex->GetTexelPointer(src.left, src.top, src_level),
+		tex->GetLevelPitch(src_level), copy_size, copy_rows);
+	m_needs_flush = false;
+}
+
+bool GSDownloadTextureHeadless::Map(const GSVector4i& read_rc)
+{
+	// Always mapped.
+	return true;
+}
+
+void GSDownloadTextureHeadless::Unmap()
+{
+	// Always mapped.
+}
+
+void GSDownloadTextureHeadless::Flush()
+{
+	// Copies are done synchronously.
+}
+
+#ifdef PCSX2_DEVBUILD
+
+void GSDownloadTextureHeadless::SetDebugName(std::string_view name)
+{
+}
+
+#endif
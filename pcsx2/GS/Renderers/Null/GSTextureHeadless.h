@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/Renderers/Common/GSTexture.h"
+
+#include <memory>
+#include <vector>
+
+/// Texture which lives entirely in system memory, used by the headless device.
+class GSTextureHeadless final : public GSTexture
+{
+public:
+	GSTextureHeadless(Type type, int width, int height, int levels, Format format);
+	~GSTextureHeadless() override;
+
+	void* GetNativeHandle() const override;
+
+	bool Update(const GSVector4i& r, const void* data, int pitch, int layer = 0) override;
+	bool Map(GSMap& m, const GSVector4i* r = nullptr, int layer = 0) override;
+	void Unmap() override;
+	void GenerateMipmap() override;
+
+#ifdef PCSX2_DEVBUILD
+	void SetDebugName(std::string_view name) override;
+#endif
+
+	/// Returns the row pitch of the specified mip level.
+	u32 GetLevelPitch(int level) const;
+
+	/// Returns a pointer to the texel (or compressed block) containing x, y in the specified mip level.
+	u8* GetTexelPointer(int x, int y, int level = 0) const;
+
+	/// Writes the pending clear value out to memory, if there is one. Like the GPU backends, clears are
+	/// deferred until something actually reads from or partially overwrites the texture.
+	void CommitClear();
+
+private:
+	std::unique_ptr<u8[]> m_data;
+	std::vector<u32> m_level_offsets;
+};
+
+class GSDownloadTextureHeadless final : public GSDownloadTexture
+{
+public:
+	~GSDownloadTextureHeadless() override;
+
+	static std::unique_ptr<GSDownloadTextureHeadless> Create(u32 width, u32 height, GSTexture::Format format);
+
+	void CopyFromTexture(const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch) override;
+
+	bool Map(const GSVector4i& read_rc) override;
+	void Unmap() override;
+
+	void Flush() override;
+
+#ifdef PCSX2_DEVBUILD
+	void SetDebugName(std::string_view name) override;
+#endif
+
+private:
+	GSDownloadTextureHeadless(u32 width, u32 height, GSTexture::Format format);
+
+	std::unique_ptr<u8[]> m_buffer;
+};
@@ -6,8 +6,17 @@
 #include "GS/Renderers/SW/GSScanlineEnvironment.h"
 #include "GS/Renderers/SW/GSRasterizer.h"
 
+#include "Config.h"
+
 #include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
 
+#include <algorithm>
 #include <fstream>
 
 // Comment to disable all dynamic code generation.
@@ -34,6 +43,9 @@ GSDrawScanline::GSDrawScanline()
 
 GSDrawScanline::~GSDrawScanline()
 {
+	StopPrecompile();
+	SaveKeys();
+
 	if (const size_t used = GSCodeReserve::GetMemoryUsed(); used > 0)
 		DevCon.WriteLn("SW JIT generated %zu bytes of code", used);
 }
@@ -115,11 +127,154 @@ void GSDrawScanline::BeginDraw(const GSRasterizerData& data, GSScanlineLocalData
 void GSDrawScanline::ResetCodeCache()
 {
 	Console.Warning("GS Software JIT cache overflow, resetting.");
+	StopPrecompile();
 	m_sp_map.Clear();
 	m_ds_map.Clear();
 	GSCodeReserve::ResetMemory();
 }
 
+namespace
+{
+	struct SWJitKeyFileHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 sp_count;
+		u32 ds_count;
+	};
+
+	static constexpr u32 SW_JIT_KEY_FILE_MAGIC = 0x4B4A5753; // SWJK
+	static constexpr u32 SW_JIT_KEY_FILE_VERSION = 1;
+} // namespace
+
+static std::string GetKeyFilePath(u32 crc)
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("sw_jit_{:08X}.bin", crc));
+}
+
+void GSDrawScanline::SetGameCRC(u32 crc)
+{
+#ifdef ENABLE_JIT_RASTERIZER
+	if (crc == m_crc)
+		return;
+
+	StopPrecompile();
+	SaveKeys();
+
+	m_crc = crc;
+	LoadKeys();
+	StartPrecompile();
+#endif
+}
+
+void GSDrawScanline::LoadKeys()
+{
+	m_loaded_sp_keys.clear();
+	m_loaded_ds_keys.clear();
+	if (m_crc == 0 || GSConfig.DisableShaderCache)
+		return;
+
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(GetKeyFilePath(m_crc).c_str());
+	if (!data.has_value() || data->size() < sizeof(SWJitKeyFileHeader))
+		return;
+
+	SWJitKeyFileHeader header;
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != SW_JIT_KEY_FILE_MAGIC || header.version != SW_JIT_KEY_FILE_VERSION ||
+		data->size() != sizeof(header) + (static_cast<size_t>(header.sp_count) + header.ds_count) * sizeof(u64))
+	{
+		Console.Warning("SW JIT key file for %08X is invalid, ignoring.", m_crc);
+		return;
+	}
+
+	const u8* ptr = data->data() + sizeof(header);
+	m_loaded_sp_keys.resize(header.sp_count);
+	std::memcpy(m_loaded_sp_keys.data(), ptr, header.sp_count * sizeof(u64));
+	ptr += header.sp_count * sizeof(u64);
+	m_loaded_ds_keys.resize(header.ds_count);
+	std::memcpy(m_loaded_ds_keys.data(), ptr, header.ds_count * sizeof(u64));
+}
+
+void GSDrawScanline::SaveKeys()
+{
+	if (m_crc == 0 || GSConfig.DisableShaderCache)
+		return;
+
+	// Keep anything from the last run which wasn't used this time, it might be needed later in the game.
+	const auto merge = [](const std::vector<u64>& loaded, std::vector<u64>* keys) {
+		std::sort(keys->begin(), keys->end());
+		const size_t active = keys->size();
+		for (const u64 key : loaded)
+		{
+			if (!std::binary_search(keys->begin(), keys->begin() + active, key))
+				keys->push_back(key);
+		}
+		return keys->size() > loaded.size();
+	};
+
+	std::vector<u64> sp_keys, ds_keys;
+	m_sp_map.GetActiveKeys(&sp_keys);
+	m_ds_map.GetActiveKeys(&ds_keys);
+	const bool sp_added = merge(m_loaded_sp_keys, &sp_keys);
+	const bool ds_added = merge(m_loaded_ds_keys, &ds_keys);
+	if (!sp_added && !ds_added)
+		return;
+
+	const SWJitKeyFileHeader header = {SW_JIT_KEY_FILE_MAGIC, SW_JIT_KEY_FILE_VERSION,
+		static_cast<u32>(sp_keys.size()), static_cast<u32>(ds_keys.size())};
+	std::vector<u8> data(sizeof(header) + (sp_keys.size() + ds_keys.size()) * sizeof(u64));
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), sp_keys.data(), sp_keys.size() * sizeof(u64));
+	std::memcpy(data.data() + sizeof(header) + sp_keys.size() * sizeof(u64), ds_keys.data(), ds_keys.size() * sizeof(u64));
+
+	const std::string path = GetKeyFilePath(m_crc);
+	if (!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size()))
+		Console.Warning("Failed to save SW JIT keys to %s", path.c_str());
+
+	m_loaded_sp_keys = std::move(sp_keys);
+	m_loaded_ds_keys = std::move(ds_keys);
+}
+
+void GSDrawScanline::StartPrecompile()
+{
+	if (m_loaded_sp_keys.empty() && m_loaded_ds_keys.empty())
+		return;
+
+	m_precompile_cancel.store(false, std::memory_order_relaxed);
+	m_precompile_thread = std::thread([this]() {
+		Threading::SetNameOfCurrentThread("GS-SW-JIT");
+
+		// Don't let last run's functions crowd out the ones this run needs, that would force a reset.
+		const size_t reserve = (GSCodeReserve::GetMemoryUsed() + GSCodeReserve::GetMemoryFree()) / 2;
+		Common::Timer timer;
+		u32 compiled = 0;
+
+		for (const u64 key : m_loaded_ds_keys)
+		{
+			if (m_precompile_cancel.load(std::memory_order_relaxed) || !m_ds_map.Precompile(key, reserve))
+				return;
+			compiled++;
+		}
+		for (const u64 key : m_loaded_sp_keys)
+		{
+			if (m_precompile_cancel.load(std::memory_order_relaxed) || !m_sp_map.Precompile(key, reserve))
+				return;
+			compiled++;
+		}
+
+		DevCon.WriteLn("SW JIT precompiled %u functions in %.2f ms", compiled, timer.GetTimeMilliseconds());
+	});
+}
+
+void GSDrawScanline::StopPrecompile()
+{
+	if (!m_precompile_thread.joinable())
+		return;
+
+	m_precompile_cancel.store(true, std::memory_order_relaxed);
+	m_precompile_thread.join();
+}
+
 bool GSDrawScanline::SetupDraw(GSRasterizerData& data)
 {
 	const GSScanlineGlobalData& global = data.global;
@@ -14,6 +14,10 @@
 #include "GS/Renderers/SW/GSDrawScanlineCodeGenerator.arm64.h"
 #endif
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 struct GSScanlineLocalData;
 
 MULTI_ISA_UNSHARED_START
@@ -39,6 +43,10 @@ public:
 	/// Flushes the code cache, forcing everything to be recompiled.
 	void ResetCodeCache();
 
+	/// Saves the functions used by the previous game, then compiles the ones used the last time
+	/// the new game ran on a worker thread, so they're ready before the first draw needs them.
+	void SetGameCRC(u32 crc);
+
 	/// Populates function pointers. If this returns false, we ran out of code space.
 	bool SetupDraw(GSRasterizerData& data);
 
@@ -55,6 +63,17 @@ private:
 	GSCodeGeneratorFunctionMap<GSSetupPrimCodeGenerator, u64, SetupPrimPtr> m_sp_map;
 	GSCodeGeneratorFunctionMap<GSDrawScanlineCodeGenerator, u64, DrawScanlinePtr> m_ds_map;
 
+	u32 m_crc = 0;
+	std::vector<u64> m_loaded_sp_keys;
+	std::vector<u64> m_loaded_ds_keys;
+	std::thread m_precompile_thread;
+	std::atomic_bool m_precompile_cancel{false};
+
+	void LoadKeys();
+	void SaveKeys();
+	void StartPrecompile();
+	void StopPrecompile();
+
 	static void CSetupPrim(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, GSScanlineLocalData& local);
 	static void CDrawScanline(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
 	static void CDrawEdge(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
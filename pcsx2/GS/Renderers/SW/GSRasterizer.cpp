@@ -124,6 +124,11 @@ int GSRasterizer::GetPixels(bool reset)
 }
 
 void GSRasterizer::Draw(GSRasterizerData& data)
+{
+	Draw(data, data.scissor);
+}
+
+void GSRasterizer::Draw(GSRasterizerData& data, const GSVector4i& scissor)
 {
 	if ((data.vertex && data.vertex_count == 0) || (data.index && data.index_count == 0))
 		return;
@@ -148,11 +153,11 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 
 	static constexpr u16 tmp_index[] = {0, 1, 2};
 
-	bool scissor_test = !data.bbox.eq(data.bbox.rintersect(data.scissor));
+	bool scissor_test = !data.bbox.eq(data.bbox.rintersect(scissor));
 
-	m_scissor = data.scissor;
-	m_fscissor_x = GSVector4(data.scissor).xzxz();
-	m_fscissor_y = GSVector4(data.scissor).ywyw();
+	m_scissor = scissor;
+	m_fscissor_x = GSVector4(scissor).xzxz();
+	m_fscissor_y = GSVector4(scissor).ywyw();
 	m_scanmsk_value = data.scanmsk_value;
 
 	switch (data.primclass)
@@ -1296,6 +1301,9 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 		return std::make_unique<GSSingleRasterizer>();
 	}
 
+	if (GSConfig.SWTileScheduling)
+		return GSTiledRasterizerList::Create(threads);
+
 	std::unique_ptr<GSRasterizerList> rl(new GSRasterizerList(threads));
 
 	const std::vector<u32>& procs = VMManager::Internal::GetSoftwareRendererProcessorList();
@@ -1320,3 +1328,228 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 void GSRasterizerList::PrintStats()
 {
 }
+
+//
+
+static int compute_best_tile_height(int threads)
+{
+	// Every band a draw touches walks all of its primitives, so bands are much taller than the interleaved
+	// rows of GSRasterizerList: about two per worker over a 512 line frame, so there is still something to
+	// steal, but no less than 32 lines.
+
+	const int bands = std::max(threads, 1) * 2;
+	int th = 5;
+
+	while (th < 8 && (512 >> th) > bands)
+		th++;
+
+	return th;
+}
+
+GSTiledRasterizerList::GSTiledRasterizerList(int threads)
+{
+	m_tile_height = compute_best_tile_height(threads);
+	m_tiles = std::make_unique<Tile[]>(2048 >> m_tile_height);
+
+	PerformanceMetrics::SetGSSWThreadCount(threads);
+}
+
+GSTiledRasterizerList::~GSTiledRasterizerList()
+{
+	m_exit = true;
+	for (auto& worker : m_workers)
+		worker->sema.NotifyOfWork();
+	for (auto& worker : m_workers)
+		worker->thread.join();
+
+	PerformanceMetrics::SetGSSWThreadCount(0);
+}
+
+int GSTiledRasterizerList::TakeTile(int id)
+{
+	// Our own tiles come off the front, stolen ones off the back.
+	{
+		Worker& worker = *m_workers[id];
+		std::unique_lock lock(worker.lock);
+		if (!worker.tiles.empty())
+		{
+			const int tile = worker.tiles.front();
+			worker.tiles.pop_front();
+			return tile;
+		}
+	}
+
+	const int count = static_cast<int>(m_workers.size());
+	for (int i = 1; i < count; i++)
+	{
+		Worker& victim = *m_workers[(id + i) % count];
+		std::unique_lock lock(victim.lock);
+		if (!victim.tiles.empty())
+		{
+			const int tile = victim.tiles.back();
+			victim.tiles.pop_back();
+			m_steals.fetch_add(1, std::memory_order_relaxed);
+			return tile;
+		}
+	}
+
+	return -1;
+}
+
+void GSTiledRasterizerList::RunTile(GSRasterizer& r, int tile)
+{
+	Tile& t = m_tiles[tile];
+	const int top = tile << m_tile_height;
+	const int bottom = top + (1 << m_tile_height);
+
+	for (;;)
+	{
+		GSRingHeap::SharedPtr<GSRasterizerData> data;
+		{
+			std::unique_lock lock(t.lock);
+			if (t.queue.empty())
+			{
+				// Anything queued after this will schedule the tile again.
+				t.scheduled = false;
+				return;
+			}
+
+			data = std::move(t.queue.front());
+			t.queue.pop_front();
+		}
+
+		GSVector4i scissor = data->scissor;
+		scissor.top = std::max(scissor.top, top);
+		scissor.bottom = std::min(scissor.bottom, bottom);
+		r.Draw(*data.get(), scissor);
+
+		data = {};
+		m_pending.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+void GSTiledRasterizerList::WorkerThread(int id, u64 affinity)
+{
+	GSRasterizerList::OnWorkerStartup(id, affinity);
+
+	Worker& worker = *m_workers[id];
+	for (;;)
+	{
+		worker.sema.WaitForWorkWithSpin();
+		if (m_exit)
+			break;
+
+		int tile;
+		while ((tile = TakeTile(id)) >= 0)
+			RunTile(*worker.r, tile);
+	}
+
+	GSRasterizerList::OnWorkerShutdown(id);
+}
+
+void GSTiledRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
+{
+	GSVector4i r = data->bbox.rintersect(data->scissor);
+
+	if (!m_ds.SetupDraw(*data.get())) [[unlikely]]
+	{
+		Sync();
+		m_ds.ResetCodeCache();
+		m_ds.SetupDraw(*data.get());
+	}
+
+	pxAssert(r.top >= 0 && r.top < 2048 && r.bottom >= 0 && r.bottom < 2048);
+
+	int top = r.top >> m_tile_height;
+	const int bottom = (r.bottom + (1 << m_tile_height) - 1) >> m_tile_height;
+	const int count = static_cast<int>(m_workers.size());
+	bool scheduled = false;
+
+	for (; top < bottom; top++)
+	{
+		Tile& tile = m_tiles[top];
+		bool schedule;
+
+		m_pending.fetch_add(1, std::memory_order_relaxed);
+		{
+			std::unique_lock lock(tile.lock);
+			tile.queue.push_back(data);
+			schedule = !tile.scheduled;
+			tile.scheduled = true;
+		}
+
+		if (schedule)
+		{
+			Worker& worker = *m_workers[top % count];
+			std::unique_lock lock(worker.lock);
+			worker.tiles.push_back(top);
+			scheduled = true;
+		}
+	}
+
+	// Wake everyone, not just the owners, so idle workers can steal.
+	if (scheduled)
+	{
+		for (auto& worker : m_workers)
+			worker->sema.NotifyOfWork();
+	}
+}
+
+void GSTiledRasterizerList::Sync()
+{
+	if (!IsSynced())
+	{
+		for (auto& worker : m_workers)
+			worker->sema.WaitForEmptyWithSpin();
+
+		pxAssert(IsSynced());
+		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
+	}
+}
+
+bool GSTiledRasterizerList::IsSynced() const
+{
+	return (m_pending.load(std::memory_order_acquire) == 0);
+}
+
+int GSTiledRasterizerList::GetPixels(bool reset)
+{
+	int pixels = 0;
+
+	for (auto& worker : m_workers)
+		pixels += worker->r->GetPixels(reset);
+
+	return pixels;
+}
+
+std::unique_ptr<IRasterizer> GSTiledRasterizerList::Create(int threads)
+{
+	std::unique_ptr<GSTiledRasterizerList> rl(new GSTiledRasterizerList(threads));
+
+	const std::vector<u32>& procs = VMManager::Internal::GetSoftwareRendererProcessorList();
+	const bool pin = (EmuConfig.EnableThreadPinning && static_cast<size_t>(threads) <= procs.size());
+	if (EmuConfig.EnableThreadPinning && !pin)
+		WARNING_LOG("Not pinning SW threads, we need {} processors, but only have {}", threads, procs.size());
+
+	// Every worker can draw any row, so they all get a single-threaded rasterizer.
+	for (int i = 0; i < threads; i++)
+	{
+		rl->m_workers.push_back(std::make_unique<Worker>());
+		rl->m_workers[i]->r = std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, 0, 1));
+	}
+
+	// Workers steal from each other, so don't start any until they all exist.
+	for (int i = 0; i < threads; i++)
+	{
+		const u64 affinity = pin ? (static_cast<u64>(1u) << procs[i]) : 0;
+		rl->m_workers[i]->thread = std::thread(&GSTiledRasterizerList::WorkerThread, rl.get(), i, affinity);
+	}
+
+	return rl;
+}
+
+void GSTiledRasterizerList::PrintStats()
+{
+	DevCon.WriteLn("GS SW tile scheduler: %d line bands, %u stolen", 1 << m_tile_height,
+		m_steals.exchange(0, std::memory_order_relaxed));
+}
@@ -11,6 +11,9 @@
 #include "GS/GSRingHeap.h"
 #include "GS/MultiISA.h"
 
+#include <atomic>
+#include <deque>
+
 MULTI_ISA_UNSHARED_START
 
 class GSDrawScanline;
@@ -117,6 +120,7 @@ public:
 	__forceinline int FindMyNextScanline(int top) const;
 
 	void Draw(GSRasterizerData& data);
+	void Draw(GSRasterizerData& data, const GSVector4i& scissor);
 	int GetPixels(bool reset);
 };
 
@@ -130,6 +134,7 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+	virtual GSDrawScanline* GetDrawScanline() = 0;
 };
 
 class GSSingleRasterizer final : public IRasterizer
@@ -143,6 +148,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
+	GSDrawScanline* GetDrawScanline() override { return &m_ds; }
 
 	void Draw(GSRasterizerData& data);
 
@@ -153,6 +159,8 @@ private:
 
 class GSRasterizerList final : public IRasterizer
 {
+	friend class GSTiledRasterizerList;
+
 protected:
 	using GSWorker = GSJobQueue<GSRingHeap::SharedPtr<GSRasterizerData>, 65536>;
 
@@ -181,6 +189,61 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
+	GSDrawScanline* GetDrawScanline() override { return &m_ds; }
+};
+
+/// Splits the screen into bands of rows, and queues each draw on every band it touches. Each band is
+/// handed to one worker at a time, which keeps draws in order within it, and idle workers steal bands
+/// from busy ones. Unlike GSRasterizerList, a worker only walks the draws for bands it actually runs.
+/// A band walks every primitive of the draw, so there are only about two bands per worker.
+class GSTiledRasterizerList final : public IRasterizer
+{
+protected:
+	struct Tile
+	{
+		std::mutex lock;
+		std::deque<GSRingHeap::SharedPtr<GSRasterizerData>> queue;
+		bool scheduled = false;
+	};
+
+	struct alignas(64) Worker
+	{
+		std::mutex lock;
+		std::deque<int> tiles;
+		Threading::WorkSema sema;
+		std::unique_ptr<GSRasterizer> r;
+		std::thread thread;
+	};
+
+	GSDrawScanline m_ds;
+
+	std::unique_ptr<Tile[]> m_tiles;
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	int m_tile_height;
+	bool m_exit = false;
+
+	std::atomic<int> m_pending{0};
+	std::atomic<u32> m_steals{0};
+
+	GSTiledRasterizerList(int threads);
+
+	int TakeTile(int id);
+	void RunTile(GSRasterizer& r, int tile);
+	void WorkerThread(int id, u64 affinity);
+
+public:
+	~GSTiledRasterizerList() override;
+
+	static std::unique_ptr<IRasterizer> Create(int threads);
+
+	// IRasterizer
+
+	void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
+	void Sync() override;
+	bool IsSynced() const override;
+	int GetPixels(bool reset) override;
+	void PrintStats() override;
+	GSDrawScanline* GetDrawScanline() override { return &m_ds; }
 };
 
 MULTI_ISA_UNSHARED_END
@@ -6,7 +6,10 @@
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
 
+#include "VMManager.h"
+
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 MULTI_ISA_UNSHARED_IMPL;
 
@@ -28,6 +31,10 @@ GSRendererSW::GSRendererSW(int threads)
 
 	m_tc = std::make_unique<GSTextureCacheSW>();
 	m_rl = GSRasterizerList::Create(threads);
+	m_rl->GetDrawScanline()->SetGameCRC(VMManager::GetDiscCRC());
+
+	if (GSConfig.SWParallelDrawSetup && threads > 0)
+		m_vc = std::make_unique<VertexConverter>(threads);
 
 	m_output = (u8*)_aligned_malloc(1024 * 1024 * sizeof(u32), VECTOR_ALIGNMENT);
 
@@ -52,10 +59,17 @@ void GSRendererSW::Reset(bool hardware_reset)
 	GSRenderer::Reset(hardware_reset);
 }
 
+void GSRendererSW::GameChanged()
+{
+	if (m_rl)
+		m_rl->GetDrawScanline()->SetGameCRC(VMManager::GetDiscCRC());
+}
+
 void GSRendererSW::Destroy()
 {
 	// Need to destroy worker queue first to stop any pending thread work
 	m_rl.reset();
+	m_vc.reset();
 	m_tc.reset();
 
 	for (GSTexture*& tex : m_texture)
@@ -68,7 +82,7 @@ void GSRendererSW::Destroy()
 	m_output = nullptr;
 }
 
-void GSRendererSW::VSync(u32 field, bool registers_written, bool idle_frame)
+void GSRendererSW::VSync(u32 field, bool registers_written, bool idle_frame, bool skip_present)
 {
 	Sync(0); // IncAge might delete a cached texture in use
 
@@ -89,7 +103,7 @@ void GSRendererSW::VSync(u32 field, bool registers_written, bool idle_frame)
 	//
 	*/
 
-	GSRenderer::VSync(field, registers_written, idle_frame);
+	GSRenderer::VSync(field, registers_written, idle_frame, skip_present);
 
 	m_tc->IncAge();
 
@@ -346,7 +360,12 @@ void GSRendererSW::Draw()
 	// If you have both GS_SPRITE_CLASS && m_vt.m_eq.q, it will depends on the first part of the 'OR'
 	u32 q_div = !IsMipMapActive() && ((m_vt.m_eq.q && m_vt.m_min.t.z != 1.0f) || (!m_vt.m_eq.q && m_vt.m_primclass == GS_SPRITE_CLASS));
 
-	GSVertexSW::s_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div](m_context, sd->vertex, m_vertex.buff, m_vertex.next);
+	const GSVertexSW::ConvertVertexBufferPtr cvb = GSVertexSW::s_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div];
+	const bool parallel_convert = (m_vc && m_vertex.next >= VertexConverter::MIN_VERTICES);
+	if (parallel_convert)
+		m_vc->Start(cvb, m_context, sd->vertex, m_vertex.buff, m_vertex.next);
+	else
+		cvb(m_context, sd->vertex, m_vertex.buff, m_vertex.next);
 
 	std::memcpy(sd->index, m_index.buff, sizeof(u16) * m_index.tail);
 
@@ -367,7 +386,12 @@ void GSRendererSW::Draw()
 	sd->bbox = bbox;
 	sd->frame = g_perfmon.GetFrame();
 
-	if (!GetScanlineGlobalData(sd))
+	// Texture lookups overlap with the vertex conversion, the vertices aren't needed until the draw is queued.
+	const bool gd_valid = GetScanlineGlobalData(sd);
+	if (parallel_convert)
+		m_vc->Wait();
+
+	if (!gd_valid)
 	{
 		return;
 	}
@@ -524,6 +548,97 @@ void GSRendererSW::Draw()
 	*/
 }
 
+GSRendererSW::VertexConverter::VertexConverter(int threads)
+{
+	// Conversion is mostly memory bound, more helpers than this don't help.
+	const int count = std::min(threads, 4);
+	for (int i = 0; i < count; i++)
+		m_threads.emplace_back(&VertexConverter::WorkerThread, this);
+}
+
+GSRendererSW::VertexConverter::~VertexConverter()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_exit = true;
+	}
+	m_start_cv.notify_all();
+
+	for (std::thread& thread : m_threads)
+		thread.join();
+}
+
+void GSRendererSW::VertexConverter::Start(GSVertexSW::ConvertVertexBufferPtr cvb, const GSDrawingContext* ctx, GSVertexSW* dst, const GSVertex* src, u32 count)
+{
+	{
+		// A helper which woke up late for the last draw could still be looking at the old one.
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done_cv.wait(lock, [this]() { return m_active == 0; });
+
+		m_cvb = cvb;
+		m_ctx = ctx;
+		m_dst = dst;
+		m_src = src;
+		m_count = count;
+		m_num_chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		m_next_chunk.store(0, std::memory_order_relaxed);
+		m_generation++;
+		m_pending = true;
+	}
+	m_start_cv.notify_all();
+}
+
+void GSRendererSW::VertexConverter::Wait()
+{
+	if (!m_pending)
+		return;
+
+	while (ConvertChunk())
+		;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done_cv.wait(lock, [this]() { return m_active == 0; });
+	m_pending = false;
+}
+
+bool GSRendererSW::VertexConverter::ConvertChunk()
+{
+	const u32 chunk = m_next_chunk.fetch_add(1, std::memory_order_relaxed);
+	if (chunk >= m_num_chunks)
+		return false;
+
+	const u32 start = chunk * CHUNK_SIZE;
+	m_cvb(m_ctx, m_dst + start, m_src + start, std::min(CHUNK_SIZE, m_count - start));
+	return true;
+}
+
+void GSRendererSW::VertexConverter::WorkerThread()
+{
+	Threading::SetNameOfCurrentThread("GS-SW-Convert");
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	u32 generation = m_generation;
+	for (;;)
+	{
+		m_start_cv.wait(lock, [this, generation]() { return m_exit || m_generation != generation; });
+		if (m_exit)
+			break;
+
+		generation = m_generation;
+		m_active++;
+		lock.unlock();
+
+		while (ConvertChunk())
+			;
+
+		lock.lock();
+		if (--m_active == 0)
+			m_done_cv.notify_all();
+	}
+}
+
 void GSRendererSW::Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item)
 {
 	SharedData* sd = (SharedData*)item.get();
@@ -1186,6 +1301,9 @@ bool GSRendererSW::GetScanlineGlobalData(SharedData* data)
 
 					GSVector4 half(0x8000, 0x8000);
 
+					if (m_vc)
+						m_vc->Wait();
+
 					GSVertexSW* RESTRICT v = data->vertex;
 
 					for (int i = 0, j = data->vertex_count; i < j; i++)
@@ -8,6 +8,10 @@
 #include "GS/GSRingHeap.h"
 #include "GS/MultiISA.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 MULTI_ISA_UNSHARED_START
 
 class GSRendererSW final : public GSRenderer
@@ -46,8 +50,48 @@ public:
 		void UpdateSource();
 	};
 
+	/// Converts the vertices of large draws in chunks on helper threads, while the GS thread carries on
+	/// setting up the draw. The GS thread picks up any chunks the helpers haven't got to when it waits.
+	class VertexConverter
+	{
+	public:
+		/// Draws with fewer vertices than this are converted on the GS thread, it's not worth waking the helpers.
+		static constexpr u32 MIN_VERTICES = 4096;
+
+		explicit VertexConverter(int threads);
+		~VertexConverter();
+
+		void Start(GSVertexSW::ConvertVertexBufferPtr cvb, const GSDrawingContext* ctx, GSVertexSW* dst, const GSVertex* src, u32 count);
+		void Wait();
+
+	private:
+		/// Even, so sprite pairs never straddle a chunk.
+		static constexpr u32 CHUNK_SIZE = 1024;
+
+		void WorkerThread();
+		bool ConvertChunk();
+
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::condition_variable m_start_cv;
+		std::condition_variable m_done_cv;
+		u32 m_generation = 0;
+		u32 m_active = 0;
+		bool m_pending = false;
+		bool m_exit = false;
+
+		GSVertexSW::ConvertVertexBufferPtr m_cvb = nullptr;
+		const GSDrawingContext* m_ctx = nullptr;
+		GSVertexSW* m_dst = nullptr;
+		const GSVertex* m_src = nullptr;
+		u32 m_count = 0;
+		u32 m_num_chunks = 0;
+		std::atomic<u32> m_next_chunk{0};
+	};
+
 protected:
 	std::unique_ptr<IRasterizer> m_rl;
+	std::unique_ptr<VertexConverter> m_vc;
 	std::unique_ptr<GSTextureCacheSW> m_tc;
 	GSRingHeap m_vertex_heap;
 	std::array<GSTexture*, 3> m_texture = {};
@@ -61,7 +105,8 @@ protected:
 	GSVector4i m_dimx[8] = {};
 
 	void Reset(bool hardware_reset) override;
-	void VSync(u32 field, bool registers_written, bool idle_frame) override;
+	void GameChanged() override;
+	void VSync(u32 field, bool registers_written, bool idle_frame, bool skip_present) override;
 	GSTexture* GetOutput(int i, float& scale, int& y_offset) override;
 	GSTexture* GetFeedbackOutput(float& scale) override;
 
@@ -198,8 +198,9 @@ struct Gif_Path_MTVU
 	GS_Packet fakePacket;
 	// Set a size based on MTGS but keep a factor 2 to avoid too waste to much
 	// memory overhead. Note the struct is instantied 3 times (for each gif
-	// path)
-	ringbuffer_base<GS_Packet, MTGS::RingBufferSize / 2> gsPackQueue;
+	// path). Sized off the default ring capacity rather than the full ring,
+	// a full queue only makes the VU thread wait in FinishGSPacketMTVU().
+	ringbuffer_base<GS_Packet, MTGS::RingBufferDefaultCapacity / 2> gsPackQueue;
 	Gif_Path_MTVU() { Reset(); }
 	void Reset()
 	{
@@ -260,6 +260,11 @@ DEFINE_HOTKEY("SelectNextSlotAndSaveState", TRANSLATE_NOOP("Hotkeys", "Save Stat
 			SaveStateSelectorUI::SaveCurrentSlot();
 		}
 	})
+DEFINE_HOTKEY("Rewind", TRANSLATE_NOOP("Hotkeys", "Save States"), TRANSLATE_NOOP("Hotkeys", "Rewind (Hold)"),
+	[](s32 pressed) {
+		if (pressed >= 0 && VMManager::HasValidVM())
+			VMManager::SetRewinding(pressed > 0);
+	})
 
 #define DEFINE_HOTKEY_SAVESTATE_X(slotnum, title) \
 	DEFINE_HOTKEY("SaveStateToSlot" #slotnum, "Save States", title, [](s32 pressed) { \
@@ -3401,6 +3401,10 @@ void FullscreenUI::DrawEmulationSettingsPage()
 
 	DrawToggleSetting(bsi, FSUI_CSTR("Enable CDVD Precaching"), FSUI_CSTR("Loads the disc image into RAM before starting the virtual machine."),
 		"EmuCore", "CdvdPrecache", false);
+	DrawToggleSetting(bsi, FSUI_CSTR("Map Disc Images Into Memory"),
+		FSUI_CSTR("Reads uncompressed disc images through a file mapping. Can cause stutter, or a crash on read errors, with "
+				  "images on slow or network drives."),
+		"EmuCore", "CdvdMapImages", false);
 
 	MenuHeading(FSUI_CSTR("Frame Pacing/Latency Control"));
 
@@ -3760,6 +3764,10 @@ void FullscreenUI::DrawGraphicsSettingsPage(SettingsInterface* bsi, bool show_ad
 			10);
 		DrawToggleSetting(bsi, FSUI_CSTR("Auto Flush (Software)"),
 			FSUI_CSTR("Force a primitive flush when a framebuffer is also an input texture."), "EmuCore/GS", "autoflush_sw", true);
+		DrawToggleSetting(bsi, FSUI_CSTR("Tile Scheduling (Software)"),
+			FSUI_CSTR("Splits the screen into bands which idle threads can steal from busy ones. May scale better with many threads."), "EmuCore/GS", "sw_tile_scheduling", false);
+		DrawToggleSetting(bsi, FSUI_CSTR("Parallel Draw Setup (Software)"),
+			FSUI_CSTR("Converts the vertices of large draws on several threads. May help when the main GS thread is the bottleneck."), "EmuCore/GS", "sw_parallel_draw_setup", false);
 		DrawToggleSetting(bsi, FSUI_CSTR("Edge AA (AA1)"), FSUI_CSTR("Enables emulation of the GS's edge anti-aliasing (AA1)."),
 			"EmuCore/GS", "aa1", true);
 		DrawToggleSetting(
@@ -3920,6 +3928,9 @@ void FullscreenUI::DrawGraphicsSettingsPage(SettingsInterface* bsi, bool show_ad
 		DrawToggleSetting(bsi, FSUI_CSTR("Precache Replacements"),
 			FSUI_CSTR("Preloads all replacement textures to memory. Not necessary with asynchronous loading."), "EmuCore/GS",
 			"PrecacheTextureReplacements", false, replacement_active);
+		DrawToggleSetting(bsi, FSUI_CSTR("Persistent Texture Cache"),
+			FSUI_CSTR("Keeps decoded textures in the cache directory between sessions, so they don't have to be decoded again the next time they are used."),
+			"EmuCore/GS", "TextureDiskCache", false);
 
 		if (!IsEditingGameSettings(bsi))
 		{
@@ -4767,7 +4778,8 @@ void FullscreenUI::DrawAdvancedSettingsPage()
 		FSUI_NSTR("Uncompressed"),
 		FSUI_NSTR("Deflate64"),
 		FSUI_NSTR("Zstandard"),
-		FSUI_NSTR("LZMA2")
+		FSUI_NSTR("LZMA2"),
+		FSUI_NSTR("Zstandard (Parallel)")
 	};
 
 	static constexpr const char* s_savestate_compression_ratio[] = {
@@ -4797,6 +4809,9 @@ void FullscreenUI::DrawAdvancedSettingsPage()
 			"EnableEE", true);
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable EE Cache"), FSUI_CSTR("Enables simulation of the EE's cache. Slow."),
 			"EmuCore/CPU/Recompiler", "EnableEECache", false);
+		DrawToggleSetting(bsi, FSUI_CSTR("Enable Persistent EE Block Cache"),
+			FSUI_CSTR("Remembers which code was compiled, and compiles it ahead of time on the next boot to reduce stutter."),
+			"EmuCore/CPU/Recompiler", "EnableEEBlockCache", false);
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable INTC Spin Detection"),
 			FSUI_CSTR("Huge speedup for some games, with almost no compatibility side effects."), "EmuCore/Speedhacks", "IntcStat", true);
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable Wait Loop Detection"),
@@ -4829,6 +4844,9 @@ void FullscreenUI::DrawAdvancedSettingsPage()
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable Instant VU1"),
 			FSUI_CSTR("Runs VU1 instantly. Provides a modest speed improvement in most games. Safe for most games, but a few games may exhibit graphical errors."),
 			"EmuCore/Speedhacks", "vu1Instant", true);
+		DrawToggleSetting(bsi, FSUI_CSTR("Enable Persistent VU Program Cache"),
+			FSUI_CSTR("Keeps compiled microprograms between sessions, and compiles them ahead of time on the next boot to reduce stutter."),
+			"EmuCore/CPU/Recompiler", "EnableVUProgramCache", false);
 
 		MenuHeading(FSUI_CSTR("I/O Processor"));
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable IOP Recompiler"),
@@ -7028,6 +7046,8 @@ TRANSLATE_NOOP("FullscreenUI", "Enable Fast CDVD");
 TRANSLATE_NOOP("FullscreenUI", "Fast disc access, less loading times. Not recommended.");
 TRANSLATE_NOOP("FullscreenUI", "Enable CDVD Precaching");
 TRANSLATE_NOOP("FullscreenUI", "Loads the disc image into RAM before starting the virtual machine.");
+TRANSLATE_NOOP("FullscreenUI", "Map Disc Images Into Memory");
+TRANSLATE_NOOP("FullscreenUI", "Reads uncompressed disc images through a file mapping. Can cause stutter, or a crash on read errors, with images on slow or network drives.");
 TRANSLATE_NOOP("FullscreenUI", "Frame Pacing/Latency Control");
 TRANSLATE_NOOP("FullscreenUI", "Maximum Frame Latency");
 TRANSLATE_NOOP("FullscreenUI", "Sets the number of frames which can be queued.");
@@ -7092,6 +7112,10 @@ TRANSLATE_NOOP("FullscreenUI", "Software Rendering Threads");
 TRANSLATE_NOOP("FullscreenUI", "Number of threads to use in addition to the main GS thread for rasterization.");
 TRANSLATE_NOOP("FullscreenUI", "Auto Flush (Software)");
 TRANSLATE_NOOP("FullscreenUI", "Force a primitive flush when a framebuffer is also an input texture.");
+TRANSLATE_NOOP("FullscreenUI", "Tile Scheduling (Software)");
+TRANSLATE_NOOP("FullscreenUI", "Splits the screen into bands which idle threads can steal from busy ones. May scale better with many threads.");
+TRANSLATE_NOOP("FullscreenUI", "Parallel Draw Setup (Software)");
+TRANSLATE_NOOP("FullscreenUI", "Converts the vertices of large draws on several threads. May help when the main GS thread is the bottleneck.");
 TRANSLATE_NOOP("FullscreenUI", "Edge AA (AA1)");
 TRANSLATE_NOOP("FullscreenUI", "Enables emulation of the GS's edge anti-aliasing (AA1).");
 TRANSLATE_NOOP("FullscreenUI", "Hardware Fixes");
@@ -7154,6 +7178,8 @@ TRANSLATE_NOOP("FullscreenUI", "Asynchronous Texture Loading");
 TRANSLATE_NOOP("FullscreenUI", "Loads replacement textures on a worker thread, reducing microstutter when replacements are enabled.");
 TRANSLATE_NOOP("FullscreenUI", "Precache Replacements");
 TRANSLATE_NOOP("FullscreenUI", "Preloads all replacement textures to memory. Not necessary with asynchronous loading.");
+TRANSLATE_NOOP("FullscreenUI", "Persistent Texture Cache");
+TRANSLATE_NOOP("FullscreenUI", "Keeps decoded textures in the cache directory between sessions, so they don't have to be decoded again the next time they are used.");
 TRANSLATE_NOOP("FullscreenUI", "Replacements Directory");
 TRANSLATE_NOOP("FullscreenUI", "Folders");
 TRANSLATE_NOOP("FullscreenUI", "Texture Dumping");
@@ -7263,6 +7289,10 @@ TRANSLATE_NOOP("FullscreenUI", "Enable EE Recompiler");
 TRANSLATE_NOOP("FullscreenUI", "Performs just-in-time binary translation of 64-bit MIPS-IV machine code to native code.");
 TRANSLATE_NOOP("FullscreenUI", "Enable EE Cache");
 TRANSLATE_NOOP("FullscreenUI", "Enables simulation of the EE's cache. Slow.");
+TRANSLATE_NOOP("FullscreenUI", "Enable Persistent EE Block Cache");
+TRANSLATE_NOOP("FullscreenUI", "Enable Persistent VU Program Cache");
+TRANSLATE_NOOP("FullscreenUI", "Keeps compiled microprograms between sessions, and compiles them ahead of time on the next boot to reduce stutter.");
+TRANSLATE_NOOP("FullscreenUI", "Remembers which code was compiled, and compiles it ahead of time on the next boot to reduce stutter.");
 TRANSLATE_NOOP("FullscreenUI", "Enable INTC Spin Detection");
 TRANSLATE_NOOP("FullscreenUI", "Huge speedup for some games, with almost no compatibility side effects.");
 TRANSLATE_NOOP("FullscreenUI", "Enable Wait Loop Detection");
@@ -7587,6 +7617,7 @@ TRANSLATE_NOOP("FullscreenUI", "Chop/Zero (Default)");
 TRANSLATE_NOOP("FullscreenUI", "Deflate64");
 TRANSLATE_NOOP("FullscreenUI", "Zstandard");
 TRANSLATE_NOOP("FullscreenUI", "LZMA2");
+TRANSLATE_NOOP("FullscreenUI", "Zstandard (Parallel)");
 TRANSLATE_NOOP("FullscreenUI", "Low (Fast)");
 TRANSLATE_NOOP("FullscreenUI", "Medium (Recommended)");
 TRANSLATE_NOOP("FullscreenUI", "Very High (Slow, Not Recommended)");
@@ -204,6 +204,24 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				PerformanceMetrics::GetAverageFrameTime(),
 				PerformanceMetrics::GetMaximumFrameTime());
 			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+
+			text.clear();
+			text.append_format("Ring: {}MB | Avg: {:.0f}% | Peak: {:.0f}% | {:.1f} stalls/s | {:.2f}ms/frame",
+				MTGS::GetRingCapacity() * 16 / 1048576,
+				PerformanceMetrics::GetGSRingAverageOccupancy(),
+				PerformanceMetrics::GetGSRingPeakOccupancy(),
+				PerformanceMetrics::GetGSRingStallsPerSecond(),
+				PerformanceMetrics::GetGSRingStallTime());
+			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+
+			if (PerformanceMetrics::GetGSRingStallsPerSecond() > 0.0f)
+			{
+				const PerformanceMetrics::GSRingStallHistogram& stalls = PerformanceMetrics::GetGSRingStallHistogram();
+				text.clear();
+				text.append_format("Stalls | <10us: {} | <100us: {} | <1ms: {} | <10ms: {} | More: {}",
+					stalls[0], stalls[1], stalls[2], stalls[3], stalls[4]);
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
 		}
 
 		if (GSConfig.OsdShowResolution)
@@ -268,6 +286,24 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				FormatProcessorStat(text, PerformanceMetrics::GetCaptureThreadUsage(), PerformanceMetrics::GetCaptureThreadAverageTime());
 				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 			}
+
+			if (const u32 runahead_frames = VMManager::GetRunaheadFrameCount(); runahead_frames > 0)
+			{
+				text.clear();
+				text.append_format("RA[{}]: {:.2f}ms/frame, {:.2f}ms save, {:.2f}ms load", runahead_frames,
+					PerformanceMetrics::GetRunaheadFrameTime(), PerformanceMetrics::GetMemorySaveStateSaveTime(),
+					PerformanceMetrics::GetMemorySaveStateLoadTime());
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
+			if (VMManager::IsRewindEnabled())
+			{
+				text.clear();
+				text.append_format("RW: {} states, {:.1f} MB, {:.2f}ms save, {:.2f}ms load", VMManager::GetRewindStateCount(),
+					static_cast<double>(VMManager::GetRewindMemoryUsage()) / 1048576.0,
+					PerformanceMetrics::GetMemorySaveStateSaveTime(), PerformanceMetrics::GetMemorySaveStateLoadTime());
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
 		}
 
 		if (GSConfig.OsdShowGPU)
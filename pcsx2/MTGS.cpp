@@ -7,11 +7,13 @@
 #include "MTVU.h"
 #include "Host.h"
 #include "IconsFontAwesome5.h"
+#include "PerformanceMetrics.h"
 #include "VMManager.h"
 
 #include "common/FPControl.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 #include "common/WrappedMemCopy.h"
 
 #include <list>
@@ -48,6 +50,8 @@ namespace MTGS
 	static void MainLoop();
 
 	static void GenericStall(uint size);
+	static uint GetFreeRoom(uint writepos, uint readpos);
+	static void UpdateRingCapacity();
 
 	static void PrepDataPacket(Command cmd, u32 size);
 	static void PrepDataPacket(GIF_PATH pathidx, u32 size);
@@ -99,6 +103,22 @@ namespace MTGS
 	static std::atomic_bool s_shutdown_flag{false};
 	static std::atomic_bool s_run_idle_flag{false};
 	static Threading::UserspaceSemaphore s_open_or_close_done;
+
+	// Ring capacity (GSOptions::DynamicMTGSRing). The EE only fills the first s_ring_capacity qwords worth of
+	// the ring, if it spends too long stalled on a full ring over a window of vsyncs it's doubled, and halved
+	// again once the ring has been mostly empty for a while. Apart from the capacity, which the OSD reads,
+	// these are only touched by the EE thread.
+	static constexpr uint RingWindowVsyncs = 30;
+	static constexpr double RingGrowStallFraction = 0.05;
+	static constexpr uint RingShrinkIdleWindows = 20;
+	static std::atomic<uint> s_ring_capacity{RingBufferDefaultCapacity};
+	static uint s_ring_peak_used; // since the last vsync
+	static uint s_ring_window_peak_used;
+	static uint s_ring_window_vsyncs;
+	static uint s_ring_window_stalls;
+	static Common::Timer::Value s_ring_window_stall_ticks;
+	static Common::Timer s_ring_window_timer;
+	static uint s_ring_idle_windows;
 } // namespace MTGS
 
 // =====================================================================================================
@@ -228,10 +248,11 @@ struct RingCmdPacket_Vsync
 
 	// must be 16 byte aligned
 	u32 registers_written;
-	u32 pad[3];
+	u32 skip_present;
+	u32 pad[2];
 };
 
-void MTGS::PostVsyncStart(bool registers_written)
+void MTGS::PostVsyncStart(bool registers_written, bool skip_present)
 {
 	// Optimization note: Typically regset1 isn't needed.  The regs in that area are typically
 	// changed infrequently, usually during video mode changes.  However, on modern systems the
@@ -247,9 +268,11 @@ void MTGS::PostVsyncStart(bool registers_written)
 	remainder[1] = GSIMR._u32;
 	(GSRegSIGBLID&)remainder[2] = GSSIGLBLID;
 	remainder[4] = static_cast<u32>(registers_written);
+	remainder[5] = static_cast<u32>(skip_present);
 	s_packet_writepos = (s_packet_writepos + 2) & RingBufferMask;
 
 	SendDataPacket();
+	UpdateRingCapacity();
 
 	// Vsyncs should always start the GS thread, regardless of how little has actually be queued.
 	if (s_CopyDataTally != 0)
@@ -495,7 +518,7 @@ void MTGS::MainLoop()
 							((GSRegSIGBLID&)RingBuffer.Regs[0x1080]) = (GSRegSIGBLID&)remainder[2];
 
 							// CSR & 0x2000; is the pageflip id.
-							GSvsync((((u32&)RingBuffer.Regs[0x1000]) & 0x2000) ? 0 : 1, remainder[4] != 0);
+							GSvsync((((u32&)RingBuffer.Regs[0x1000]) & 0x2000) ? 0 : 1, remainder[4] != 0, remainder[5] != 0);
 
 							s_QueuedFrameCount.fetch_sub(1);
 							if (s_VsyncSignalListener.exchange(false))
@@ -705,7 +728,7 @@ void MTGS::GenericStall(uint size)
 	const uint writepos = s_WritePos.load(std::memory_order_relaxed);
 
 	// Sanity checks! (within the confines of our ringbuffer please!)
-	pxAssert(size < RingBufferSize);
+	pxAssert(size < s_ring_capacity.load(std::memory_order_relaxed));
 	pxAssert(writepos < RingBufferSize);
 
 	// generic gs wait/stall.
@@ -716,10 +739,8 @@ void MTGS::GenericStall(uint size)
 	uint readpos = s_ReadPos.load(std::memory_order_acquire);
 	uint freeroom;
 
-	if (writepos < readpos)
-		freeroom = readpos - writepos;
-	else
-		freeroom = RingBufferSize - (writepos - readpos);
+	freeroom = GetFreeRoom(writepos, readpos);
+	s_ring_peak_used = std::max(s_ring_peak_used, (writepos - readpos) & RingBufferMask);
 
 	if (freeroom <= size)
 	{
@@ -731,7 +752,8 @@ void MTGS::GenericStall(uint size)
 		// the next packet will likely stall up too.  So lets set a condition for the MTGS
 		// thread to wake up the EE once there's a sizable chunk of the ringbuffer emptied.
 
-		uint somedone = (RingBufferSize - freeroom) / 4;
+		const Common::Timer::Value stall_start = Common::Timer::GetCurrentValue();
+		uint somedone = ((writepos - readpos) & RingBufferMask) / 4;
 		if (somedone < size + 1)
 			somedone = size + 1;
 
@@ -754,10 +776,7 @@ void MTGS::GenericStall(uint size)
 				readpos = s_ReadPos.load(std::memory_order_acquire);
 				//Console.WriteLn( Color_Blue, "(EEcore Awake) Report!\tringpos=0x%06x", readpos );
 
-				if (writepos < readpos)
-					freeroom = readpos - writepos;
-				else
-					freeroom = RingBufferSize - (writepos - readpos);
+				freeroom = GetFreeRoom(writepos, readpos);
 
 				if (freeroom > size)
 					break;
@@ -774,18 +793,84 @@ void MTGS::GenericStall(uint size)
 				Threading::SpinWait();
 				readpos = s_ReadPos.load(std::memory_order_acquire);
 
-				if (writepos < readpos)
-					freeroom = readpos - writepos;
-				else
-					freeroom = RingBufferSize - (writepos - readpos);
+				freeroom = GetFreeRoom(writepos, readpos);
 
 				if (freeroom > size)
 					break;
 			}
 		}
+
+		const Common::Timer::Value stall_ticks = Common::Timer::GetCurrentValue() - stall_start;
+		s_ring_window_stall_ticks += stall_ticks;
+		s_ring_window_stalls++;
+		PerformanceMetrics::OnGSRingStall(static_cast<float>(Common::Timer::ConvertValueToMilliseconds(stall_ticks)));
 	}
 }
 
+uint MTGS::GetFreeRoom(uint writepos, uint readpos)
+{
+	// Anything past the current capacity counts as used, so a shrunk ring drains before it fills again.
+	const uint used = (writepos - readpos) & RingBufferMask;
+	const uint capacity = s_ring_capacity.load(std::memory_order_relaxed);
+	return (used < capacity) ? (capacity - used) : 0;
+}
+
+uint MTGS::GetRingCapacity()
+{
+	return s_ring_capacity.load(std::memory_order_relaxed);
+}
+
+void MTGS::UpdateRingCapacity()
+{
+	const uint capacity = s_ring_capacity.load(std::memory_order_relaxed);
+	const uint used = (s_WritePos.load(std::memory_order_relaxed) - s_ReadPos.load(std::memory_order_acquire)) & RingBufferMask;
+	const uint peak_used = std::max(std::exchange(s_ring_peak_used, 0u), used);
+	PerformanceMetrics::OnGSRingSample(static_cast<float>(used) * 100.0f / static_cast<float>(capacity),
+		static_cast<float>(peak_used) * 100.0f / static_cast<float>(capacity));
+
+	s_ring_window_peak_used = std::max(s_ring_window_peak_used, peak_used);
+	if (++s_ring_window_vsyncs < RingWindowVsyncs)
+		return;
+
+	const double window_time = s_ring_window_timer.GetTimeSecondsAndReset();
+	const double stall_time = Common::Timer::ConvertValueToSeconds(std::exchange(s_ring_window_stall_ticks, 0));
+	const uint stalls = std::exchange(s_ring_window_stalls, 0u);
+	const uint window_peak_used = std::exchange(s_ring_window_peak_used, 0u);
+	s_ring_window_vsyncs = 0;
+
+	uint new_capacity = capacity;
+	if (!EmuConfig.GS.DynamicMTGSRing)
+	{
+		new_capacity = RingBufferDefaultCapacity;
+		s_ring_idle_windows = 0;
+	}
+	else if (stall_time > window_time * RingGrowStallFraction)
+	{
+		new_capacity = std::min(capacity * 2, RingBufferSize);
+		s_ring_idle_windows = 0;
+	}
+	else if (stalls == 0 && window_peak_used < capacity / 4)
+	{
+		// Don't bounce between sizes, wait until it's been quiet for a while.
+		if (++s_ring_idle_windows >= RingShrinkIdleWindows)
+		{
+			new_capacity = std::max(capacity / 2, RingBufferDefaultCapacity);
+			s_ring_idle_windows = 0;
+		}
+	}
+	else
+	{
+		s_ring_idle_windows = 0;
+	}
+
+	if (new_capacity == capacity)
+		return;
+
+	DevCon.WriteLn("MTGS: Ring capacity %u -> %u KB (%u stalls, %.2f ms stalled in the last %.2f s)",
+		capacity * 16 / 1024, new_capacity * 16 / 1024, stalls, stall_time * 1000.0, window_time);
+	s_ring_capacity.store(new_capacity, std::memory_order_relaxed);
+}
+
 void MTGS::PrepDataPacket(Command cmd, u32 size)
 {
 	s_packet_size = size;
@@ -63,7 +63,7 @@ namespace MTGS
 	void Freeze(FreezeAction mode, FreezeData& data);
 
 	int GetCurrentVsyncQueueSize();
-	void PostVsyncStart(bool registers_written);
+	void PostVsyncStart(bool registers_written, bool skip_present);
 	void InitAndReadFIFO(u8* mem, u32 qwc);
 
 	void RunOnGSThread(AsyncCallType func);
@@ -79,11 +79,16 @@ namespace MTGS
 		u32* width, u32* height, std::vector<u32>* pixels);
 	void SetRunIdle(bool enabled);
 
+	/// Returns the current capacity of the ringbuffer (the most it will be filled to), in simd128's.
+	/// Safe to call from any thread.
+	uint GetRingCapacity();
+
 	// Size of the ringbuffer as a power of 2 -- size is a multiple of simd128s.
 	// (actual size is 1<<m_RingBufferSizeFactor simd vectors [128-bit values])
 	// A value of 19 is a 8meg ring buffer.  18 would be 4 megs, and 20 would be 16 megs.
-	// Default was 2mb, but some games with lots of MTGS activity want 8mb to run fast (rama)
-	static const uint RingBufferSizeFactor = 19;
+	// Only RingBufferDefaultCapacity of it is filled, unless DynamicMTGSRing grows it because the EE keeps
+	// stalling on a full ring.
+	static const uint RingBufferSizeFactor = 20;
 
 	// size of the ringbuffer in simd128's.
 	static const uint RingBufferSize = 1 << RingBufferSizeFactor;
@@ -91,4 +96,8 @@ namespace MTGS
 	// Mask to apply to ring buffer indices to wrap the pointer from end to
 	// start (the wrapping is what makes it a ringbuffer, yo!)
 	static const uint RingBufferMask = RingBufferSize - 1;
+
+	// Amount of the ringbuffer which is normally used, 8 megs.
+	// Default was 2mb, but some games with lots of MTGS activity want 8mb to run fast (rama)
+	static const uint RingBufferDefaultCapacity = 1 << 19;
 }
@@ -448,6 +448,8 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 
 	EnableEE = true;
 	EnableEECache = false;
+	EnableEEBlockCache = false;
+	EnableVUProgramCache = false;
 	EnableIOP = true;
 	EnableVU0 = true;
 	EnableVU1 = true;
@@ -527,8 +529,10 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableEE);
 	SettingsWrapBitBool(EnableIOP);
 	SettingsWrapBitBool(EnableEECache);
+	SettingsWrapBitBool(EnableEEBlockCache);
 	SettingsWrapBitBool(EnableVU0);
 	SettingsWrapBitBool(EnableVU1);
+	SettingsWrapBitBool(EnableVUProgramCache);
 	SettingsWrapBitBool(EnableFastmem);
 	SettingsWrapBitBool(PauseOnTLBMiss);
 
@@ -683,6 +687,7 @@ const char* Pcsx2Config::GSOptions::GetRendererName(GSRendererType type)
 		case GSRendererType::VK:    return "Vulkan";
 		case GSRendererType::SW:    return "Software";
 		case GSRendererType::Null:  return "Null";
+		case GSRendererType::Headless: return "Headless";
 		default:                    return "";
 			// clang-format on
 	}
@@ -732,6 +737,9 @@ Pcsx2Config::GSOptions::GSOptions()
 	HWSpinCPUForReadbacks = false;
 	GPUPaletteConversion = false;
 	AutoFlushSW = true;
+	SWTileScheduling = false;
+	SWParallelDrawSetup = false;
+	DynamicMTGSRing = false;
 	PreloadFrameWithGSData = false;
 	Mipmap = true;
 	HWMipmap = true;
@@ -758,6 +766,7 @@ Pcsx2Config::GSOptions::GSOptions()
 	LoadTextureReplacements = false;
 	LoadTextureReplacementsAsync = true;
 	PrecacheTextureReplacements = false;
+	TextureDiskCache = false;
 
 	EnableVideoCapture = true;
 	EnableVideoCaptureParameters = false;
@@ -838,6 +847,8 @@ bool Pcsx2Config::GSOptions::OptionsAreEqual(const GSOptions& right) const
 		OpEqu(ShadeBoost_Contrast) &&
 		OpEqu(ShadeBoost_Saturation) &&
 		OpEqu(PNGCompressionLevel) &&
+		OpEqu(TextureDiskCache) && // Doesn't fit in bitset.
+		OpEqu(TextureDiskCacheSize) &&
 		OpEqu(SaveN) &&
 		OpEqu(SaveL) &&
 
@@ -888,6 +899,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 #ifdef PCSX2_DEVBUILD
 	SettingsWrapBitBool(SynchronousMTGS);
 #endif
+	SettingsWrapBitBoolEx(DynamicMTGSRing, "dynamic_mtgs_ring");
 
 	SettingsWrapBitBool(VsyncEnable);
 	SettingsWrapBitBool(DisableMailboxPresentation);
@@ -942,6 +954,8 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(HWSpinCPUForReadbacks);
 	SettingsWrapBitBoolEx(GPUPaletteConversion, "paltex");
 	SettingsWrapBitBoolEx(AutoFlushSW, "autoflush_sw");
+	SettingsWrapBitBoolEx(SWTileScheduling, "sw_tile_scheduling");
+	SettingsWrapBitBoolEx(SWParallelDrawSetup, "sw_parallel_draw_setup");
 	SettingsWrapBitBoolEx(PreloadFrameWithGSData, "preload_frame_with_gs_data");
 	SettingsWrapBitBoolEx(Mipmap, "mipmap");
 	SettingsWrapBitBoolEx(ManualUserHacks, "UserHacks");
@@ -974,6 +988,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(LoadTextureReplacements);
 	SettingsWrapBitBool(LoadTextureReplacementsAsync);
 	SettingsWrapBitBool(PrecacheTextureReplacements);
+	SettingsWrapBitBool(TextureDiskCache);
 	SettingsWrapBitBool(EnableVideoCapture);
 	SettingsWrapBitBool(EnableVideoCaptureParameters);
 	SettingsWrapBitBool(VideoCaptureAutoResolution);
@@ -1024,6 +1039,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitfield(ShadeBoost_Saturation);
 	SettingsWrapBitfield(ExclusiveFullscreenControl);
 	SettingsWrapBitfieldEx(PNGCompressionLevel, "png_compression_level");
+	SettingsWrapEntry(TextureDiskCacheSize);
 	SettingsWrapBitfieldEx(SaveN, "saven");
 	SettingsWrapBitfieldEx(SaveL, "savel");
 
@@ -1635,6 +1651,7 @@ void Pcsx2Config::DebugAnalysisOptions::LoadSave(SettingsWrapper& wrap)
 
 Pcsx2Config::SavestateOptions::SavestateOptions()
 {
+	bitset = 0;
 }
 
 void Pcsx2Config::SavestateOptions::LoadSave(SettingsWrapper& wrap)
@@ -1643,6 +1660,22 @@ void Pcsx2Config::SavestateOptions::LoadSave(SettingsWrapper& wrap)
 
 	SettingsWrapIntEnumEx(CompressionType, "SavestateCompressionType");
 	SettingsWrapIntEnumEx(CompressionRatio, "SavestateCompressionRatio");
+
+	SettingsWrapBitBool(RewindEnable);
+	SettingsWrapBitBoolEx(LogTimings, "SavestateLogTimings");
+	SettingsWrapEntry(RewindSaveFrequency);
+	SettingsWrapEntry(RewindBufferSize);
+	SettingsWrapEntry(RunaheadFrameCount);
+
+	if (wrap.IsLoading())
+		SanityCheck();
+}
+
+void Pcsx2Config::SavestateOptions::SanityCheck()
+{
+	RewindSaveFrequency = std::max(RewindSaveFrequency, 1u);
+	RewindBufferSize = std::clamp(RewindBufferSize, MIN_REWIND_BUFFER_SIZE, MAX_REWIND_BUFFER_SIZE);
+	RunaheadFrameCount = std::min(RunaheadFrameCount, MAX_RUNAHEAD_FRAMES);
 }
 
 bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) const
@@ -1652,7 +1685,8 @@ bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) co
 
 bool Pcsx2Config::SavestateOptions::operator==(const SavestateOptions& right) const
 {
-	return OpEqu(CompressionType) && OpEqu(CompressionRatio);
+	return OpEqu(bitset) && OpEqu(CompressionType) && OpEqu(CompressionRatio) && OpEqu(RewindSaveFrequency) &&
+		   OpEqu(RewindBufferSize) && OpEqu(RunaheadFrameCount);
 };
 
 Pcsx2Config::FilenameOptions::FilenameOptions()
@@ -1909,6 +1943,7 @@ Pcsx2Config::Pcsx2Config()
 	}
 
 	GzipIsoIndexTemplate = "$(f).pindex.tmp";
+	GzipIsoIndexSpan = 2048;
 	PINESlot = 28011;
 }
 
@@ -1919,6 +1954,7 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 	SettingsWrapBitBool(CdvdVerboseReads);
 	SettingsWrapBitBool(CdvdDumpBlocks);
 	SettingsWrapBitBool(CdvdPrecache);
+	SettingsWrapBitBool(CdvdMapImages);
 	SettingsWrapBitBool(EnablePatches);
 	SettingsWrapBitBool(EnableCheats);
 	SettingsWrapBitBool(EnablePINE);
@@ -1958,6 +1994,7 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 	Achievements.LoadSave(wrap);
 
 	SettingsWrapEntry(GzipIsoIndexTemplate);
+	SettingsWrapEntry(GzipIsoIndexSpan);
 	SettingsWrapEntry(PINESlot);
 
 	// For now, this in the derived config for backwards ini compatibility.
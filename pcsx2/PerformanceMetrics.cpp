@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include <atomic>
 #include <chrono>
 #include <vector>
 
@@ -71,6 +72,28 @@ static float s_accumulated_gpu_time = 0.0f;
 static float s_gpu_usage = 0.0f;
 static u32 s_presents_since_last_update = 0;
 
+// memory save state timings, accumulated by the CPU thread
+static float s_memory_save_state_save_time = 0.0f;
+static std::atomic<float> s_memory_save_state_save_time_accumulator{0.0f};
+static float s_memory_save_state_load_time = 0.0f;
+static std::atomic<float> s_memory_save_state_load_time_accumulator{0.0f};
+static std::atomic<u32> s_memory_save_state_loads_since_last_update{0};
+static float s_runahead_frame_time = 0.0f;
+static std::atomic<float> s_runahead_frame_time_accumulator{0.0f};
+static std::atomic<u32> s_runahead_frames_since_last_update{0};
+
+// GS ring telemetry, accumulated by the CPU thread
+static float s_gs_ring_average_occupancy = 0.0f;
+static float s_gs_ring_peak_occupancy = 0.0f;
+static float s_gs_ring_stalls_per_second = 0.0f;
+static float s_gs_ring_stall_time = 0.0f;
+static PerformanceMetrics::GSRingStallHistogram s_gs_ring_stall_histogram = {};
+static std::atomic<float> s_gs_ring_occupancy_accumulator{0.0f};
+static std::atomic<float> s_gs_ring_peak_occupancy_accumulator{0.0f};
+static std::atomic<u32> s_gs_ring_samples_since_last_update{0};
+static std::atomic<float> s_gs_ring_stall_time_accumulator{0.0f};
+static std::array<std::atomic<u32>, PerformanceMetrics::NUM_GS_RING_STALL_BUCKETS> s_gs_ring_stall_accumulators = {};
+
 void PerformanceMetrics::Clear()
 {
 	Reset();
@@ -94,6 +117,16 @@ void PerformanceMetrics::Clear()
 	s_average_gpu_time = 0.0f;
 	s_gpu_usage = 0.0f;
 
+	s_memory_save_state_save_time = 0.0f;
+	s_memory_save_state_load_time = 0.0f;
+	s_runahead_frame_time = 0.0f;
+
+	s_gs_ring_average_occupancy = 0.0f;
+	s_gs_ring_peak_occupancy = 0.0f;
+	s_gs_ring_stalls_per_second = 0.0f;
+	s_gs_ring_stall_time = 0.0f;
+	s_gs_ring_stall_histogram.fill(0);
+
 	s_frame_number = 0;
 
 	s_frame_time_history.fill(0.0f);
@@ -113,6 +146,18 @@ void PerformanceMetrics::Reset()
 	s_accumulated_gpu_time = 0.0f;
 	s_presents_since_last_update = 0;
 
+	s_memory_save_state_save_time_accumulator.store(0.0f, std::memory_order_relaxed);
+	s_memory_save_state_load_time_accumulator.store(0.0f, std::memory_order_relaxed);
+	s_memory_save_state_loads_since_last_update.store(0, std::memory_order_relaxed);
+	s_runahead_frame_time_accumulator.store(0.0f, std::memory_order_relaxed);
+	s_runahead_frames_since_last_update.store(0, std::memory_order_relaxed);
+	s_gs_ring_occupancy_accumulator.store(0.0f, std::memory_order_relaxed);
+	s_gs_ring_peak_occupancy_accumulator.store(0.0f, std::memory_order_relaxed);
+	s_gs_ring_samples_since_last_update.store(0, std::memory_order_relaxed);
+	s_gs_ring_stall_time_accumulator.store(0.0f, std::memory_order_relaxed);
+	for (std::atomic<u32>& bucket : s_gs_ring_stall_accumulators)
+		bucket.store(0, std::memory_order_relaxed);
+
 	s_last_update_time.Reset();
 	s_last_frame_time.Reset();
 
@@ -159,6 +204,35 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 	s_gpu_usage = s_accumulated_gpu_time / (time * 10.0f);
 	s_accumulated_gpu_time = 0.0f;
 
+	s_memory_save_state_save_time = s_memory_save_state_save_time_accumulator.exchange(0.0f, std::memory_order_relaxed) /
+									static_cast<float>(s_frames_since_last_update);
+	if (const u32 loads = s_memory_save_state_loads_since_last_update.exchange(0, std::memory_order_relaxed); loads > 0)
+	{
+		s_memory_save_state_load_time =
+			s_memory_save_state_load_time_accumulator.exchange(0.0f, std::memory_order_relaxed) / static_cast<float>(loads);
+	}
+	if (const u32 frames = s_runahead_frames_since_last_update.exchange(0, std::memory_order_relaxed); frames > 0)
+	{
+		s_runahead_frame_time =
+			s_runahead_frame_time_accumulator.exchange(0.0f, std::memory_order_relaxed) / static_cast<float>(frames);
+	}
+
+	if (const u32 samples = s_gs_ring_samples_since_last_update.exchange(0, std::memory_order_relaxed); samples > 0)
+	{
+		s_gs_ring_average_occupancy =
+			s_gs_ring_occupancy_accumulator.exchange(0.0f, std::memory_order_relaxed) / static_cast<float>(samples);
+		s_gs_ring_peak_occupancy = s_gs_ring_peak_occupancy_accumulator.exchange(0.0f, std::memory_order_relaxed);
+	}
+	u32 gs_ring_stalls = 0;
+	for (u32 i = 0; i < NUM_GS_RING_STALL_BUCKETS; i++)
+	{
+		s_gs_ring_stall_histogram[i] = s_gs_ring_stall_accumulators[i].exchange(0, std::memory_order_relaxed);
+		gs_ring_stalls += s_gs_ring_stall_histogram[i];
+	}
+	s_gs_ring_stalls_per_second = static_cast<float>(gs_ring_stalls) / time;
+	s_gs_ring_stall_time =
+		s_gs_ring_stall_time_accumulator.exchange(0.0f, std::memory_order_relaxed) / static_cast<float>(s_frames_since_last_update);
+
 	// prefer privileged register write based framerate detection, it's less likely to have false positives
 	if (s_gs_privileged_register_writes_since_last_update > 0 && !EmuConfig.Gamefixes.BlitInternalFPSHack)
 	{
@@ -362,6 +436,82 @@ float PerformanceMetrics::GetGPUAverageTime()
 	return s_average_gpu_time;
 }
 
+void PerformanceMetrics::OnMemorySaveStateSaved(float time_ms)
+{
+	s_memory_save_state_save_time_accumulator.fetch_add(time_ms, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::OnMemorySaveStateLoaded(float time_ms)
+{
+	s_memory_save_state_load_time_accumulator.fetch_add(time_ms, std::memory_order_relaxed);
+	s_memory_save_state_loads_since_last_update.fetch_add(1, std::memory_order_relaxed);
+}
+
+float PerformanceMetrics::GetMemorySaveStateSaveTime()
+{
+	return s_memory_save_state_save_time;
+}
+
+float PerformanceMetrics::GetMemorySaveStateLoadTime()
+{
+	return s_memory_save_state_load_time;
+}
+
+void PerformanceMetrics::OnRunaheadFrame(float time_ms)
+{
+	s_runahead_frame_time_accumulator.fetch_add(time_ms, std::memory_order_relaxed);
+	s_runahead_frames_since_last_update.fetch_add(1, std::memory_order_relaxed);
+}
+
+float PerformanceMetrics::GetRunaheadFrameTime()
+{
+	return s_runahead_frame_time;
+}
+
+void PerformanceMetrics::OnGSRingStall(float time_ms)
+{
+	const u32 bucket = (time_ms < 0.01f) ? 0 : (time_ms < 0.1f) ? 1 : (time_ms < 1.0f) ? 2 : (time_ms < 10.0f) ? 3 : 4;
+	s_gs_ring_stall_accumulators[bucket].fetch_add(1, std::memory_order_relaxed);
+	s_gs_ring_stall_time_accumulator.fetch_add(time_ms, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::OnGSRingSample(float occupancy, float peak_occupancy)
+{
+	s_gs_ring_occupancy_accumulator.fetch_add(occupancy, std::memory_order_relaxed);
+	s_gs_ring_samples_since_last_update.fetch_add(1, std::memory_order_relaxed);
+
+	float peak = s_gs_ring_peak_occupancy_accumulator.load(std::memory_order_relaxed);
+	while (peak < peak_occupancy &&
+		   !s_gs_ring_peak_occupancy_accumulator.compare_exchange_weak(peak, peak_occupancy, std::memory_order_relaxed))
+	{
+	}
+}
+
+float PerformanceMetrics::GetGSRingAverageOccupancy()
+{
+	return s_gs_ring_average_occupancy;
+}
+
+float PerformanceMetrics::GetGSRingPeakOccupancy()
+{
+	return s_gs_ring_peak_occupancy;
+}
+
+float PerformanceMetrics::GetGSRingStallsPerSecond()
+{
+	return s_gs_ring_stalls_per_second;
+}
+
+float PerformanceMetrics::GetGSRingStallTime()
+{
+	return s_gs_ring_stall_time;
+}
+
+const PerformanceMetrics::GSRingStallHistogram& PerformanceMetrics::GetGSRingStallHistogram()
+{
+	return s_gs_ring_stall_histogram;
+}
+
 const PerformanceMetrics::FrameTimeHistory& PerformanceMetrics::GetFrameTimeHistory()
 {
 	return s_frame_time_history;
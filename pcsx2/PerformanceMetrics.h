@@ -18,6 +18,10 @@ namespace PerformanceMetrics
 	static constexpr u32 NUM_FRAME_TIME_SAMPLES = 150;
 	using FrameTimeHistory = std::array<float, NUM_FRAME_TIME_SAMPLES>;
 
+	/// GS ring stalls bucketed by duration: <10us, <100us, <1ms, <10ms, and anything longer.
+	static constexpr u32 NUM_GS_RING_STALL_BUCKETS = 5;
+	using GSRingStallHistogram = std::array<u32, NUM_GS_RING_STALL_BUCKETS>;
+
 	void Clear();
 	void Reset();
 	void Update(bool gs_register_write, bool fb_blit, bool is_skipping_present);
@@ -58,6 +62,41 @@ namespace PerformanceMetrics
 	float GetGPUUsage();
 	float GetGPUAverageTime();
 
+	/// Memory save state (rewind/run-ahead) timings, called on the CPU thread.
+	void OnMemorySaveStateSaved(float time_ms);
+	void OnMemorySaveStateLoaded(float time_ms);
+
+	/// Returns the average time spent creating memory save states per frame, in milliseconds.
+	float GetMemorySaveStateSaveTime();
+
+	/// Returns the average time spent restoring a memory save state, in milliseconds.
+	float GetMemorySaveStateLoadTime();
+
+	/// Called on the CPU thread for each frame which is replayed by run-ahead.
+	void OnRunaheadFrame(float time_ms);
+
+	/// Returns the average time spent executing a speculative run-ahead frame, in milliseconds.
+	float GetRunaheadFrameTime();
+
+	/// Called on the CPU thread each time it had to wait for the GS thread to make room in the ring.
+	void OnGSRingStall(float time_ms);
+
+	/// Called on the CPU thread each vsync with the ring usage, as a percentage of its current capacity.
+	void OnGSRingSample(float occupancy, float peak_occupancy);
+
+	/// Returns the average and highest ring usage, as a percentage of its capacity.
+	float GetGSRingAverageOccupancy();
+	float GetGSRingPeakOccupancy();
+
+	/// Returns the number of times the CPU thread stalled on a full ring, per second.
+	float GetGSRingStallsPerSecond();
+
+	/// Returns the average time the CPU thread spent stalled on a full ring per frame, in milliseconds.
+	float GetGSRingStallTime();
+
+	/// Returns the number of stalls since the last update, by duration.
+	const GSRingStallHistogram& GetGSRingStallHistogram();
+
 	const FrameTimeHistory& GetFrameTimeHistory();
 	u32 GetFrameTimeHistoryPos();
 } // namespace PerformanceMetrics
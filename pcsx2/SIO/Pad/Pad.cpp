@@ -540,6 +540,9 @@ void Pad::SetControllerState(u32 controller, u32 bind, float value)
 		return;
 
 	s_controllers[controller]->Set(bind, value);
+
+	// The frames run ahead were executed with the old input, so they have to be replayed.
+	VMManager::Internal::SetRunaheadReplayPending();
 }
 
 bool Pad::Freeze(StateWrapper& sw)
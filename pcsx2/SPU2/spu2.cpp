@@ -27,6 +27,7 @@ namespace SPU2
 u32 lClocks = 0;
 
 static bool s_audio_capture_active = false;
+static bool s_output_muted = false;
 static bool s_psxmode = false;
 
 static std::unique_ptr<AudioStream> s_output_stream;
@@ -163,6 +164,11 @@ void SPU2::SetOutputPaused(bool paused)
 	s_output_stream->SetPaused(paused);
 }
 
+void SPU2::SetOutputMuted(bool muted)
+{
+	s_output_muted = muted;
+}
+
 void SPU2::SetAudioCaptureActive(bool active)
 {
 	s_audio_capture_active = active;
@@ -421,6 +427,9 @@ __forceinline void spu2Output(StereoOut32 out)
 	{
 		s_current_chunk_pos = 0;
 
+		if (s_output_muted) [[unlikely]]
+			return;
+
 		s_output_stream->WriteChunk(s_current_chunk.data());
 
 		if (SPU2::IsAudioCaptureActive()) [[unlikely]]
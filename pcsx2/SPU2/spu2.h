@@ -42,6 +42,9 @@ u32 GetResetVolume();
 /// Pauses/resumes the output stream.
 void SetOutputPaused(bool paused);
 
+/// Discards any generated audio instead of sending it to the output stream, e.g. for replayed frames.
+void SetOutputMuted(bool muted);
+
 /// Clears output buffers in no-sync mode, prevents long delays after fast forwarding.
 void OnTargetSpeedChanged();
 
@@ -34,12 +34,21 @@
 #include "common/Path.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 #include "common/ZipHelpers.h"
 
 #include "fmt/core.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <csetjmp>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <png.h>
+#include <span>
+#include <thread>
+#include <zstd.h>
 
 using namespace R5900;
 
@@ -339,8 +348,20 @@ struct SysState_Component
 
 static int SysState_MTGSFreeze(FreezeAction mode, freezeData* fP)
 {
+	// The GS state is a fixed size, so there's no need to round-trip through the GS thread
+	// every time we want to know it. That's one less full sync per save/load.
+	static int s_gs_freeze_size = 0;
+	if (mode == FreezeAction::Size && s_gs_freeze_size != 0)
+	{
+		fP->size = s_gs_freeze_size;
+		return 0;
+	}
+
 	MTGS::FreezeData sstate = { fP, 0 };
 	MTGS::Freeze(mode, sstate);
+	if (mode == FreezeAction::Size && sstate.retval == 0)
+		s_gs_freeze_size = fP->size;
+
 	return sstate.retval;
 }
 
@@ -380,6 +401,32 @@ static bool SysState_ComponentFreezeIn(zip_file_t* zf, SysState_Component comp)
 	return true;
 }
 
+static bool SysState_ComponentFreezeIn(std::span<const u8> data, SysState_Component comp)
+{
+	if (data.empty())
+		return true;
+
+	freezeData fP = { 0, nullptr };
+	if (comp.freeze(FreezeAction::Size, &fP) != 0)
+		fP.size = 0;
+
+	if (data.size() < static_cast<size_t>(fP.size))
+	{
+		Console.Error(fmt::format("* {}: Save data is incomplete", comp.name));
+		return false;
+	}
+
+	// Loading doesn't modify the source buffer, so we can skip the copy here.
+	fP.data = const_cast<u8*>(data.data());
+	if (comp.freeze(FreezeAction::Load, &fP) != 0)
+	{
+		Console.Error(fmt::format("* {}: Failed to load freeze data", comp.name));
+		return false;
+	}
+
+	return true;
+}
+
 static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Component comp)
 {
 	freezeData fP = {};
@@ -425,6 +472,14 @@ static bool SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool
 	return do_state_func(sw);
 }
 
+static bool SysState_ComponentFreezeInNew(std::span<const u8> data, const char* name, bool(*do_state_func)(StateWrapper&))
+{
+	StateWrapper::ReadOnlyMemoryStream stream(data.empty() ? nullptr : data.data(), static_cast<u32>(data.size()));
+	StateWrapper sw(&stream, StateWrapper::Mode::Read, g_SaveVersion);
+
+	return do_state_func(sw);
+}
+
 static bool SysState_ComponentFreezeOutNew(SaveStateBase& writer, const char* name, u32 reserve, bool (*do_state_func)(StateWrapper&))
 {
 	StateWrapper::VectorMemoryStream stream(reserve);
@@ -457,8 +512,14 @@ public:
 
 	virtual const char* GetFilename() const = 0;
 	virtual bool FreezeIn(zip_file_t* zf) const = 0;
+	virtual bool FreezeIn(std::span<const u8> data) const = 0;
 	virtual bool FreezeOut(SaveStateBase& writer) const = 0;
 	virtual bool IsRequired() const = 0;
+
+	// Largest amount of data a state can hold for this entry, anything bigger is corrupt.
+	virtual u32 GetMaxDataSize() const { return MAX_ENTRY_DATA_SIZE; }
+
+	static constexpr u32 MAX_ENTRY_DATA_SIZE = 64 * _1mb;
 };
 
 class MemorySavestateEntry : public BaseSavestateEntry
@@ -469,8 +530,10 @@ protected:
 
 public:
 	virtual bool FreezeIn(zip_file_t* zf) const;
+	virtual bool FreezeIn(std::span<const u8> data) const;
 	virtual bool FreezeOut(SaveStateBase& writer) const;
 	virtual bool IsRequired() const { return true; }
+	virtual u32 GetMaxDataSize() const { return GetDataSize(); }
 
 protected:
 	virtual u8* GetDataPtr() const = 0;
@@ -490,6 +553,20 @@ bool MemorySavestateEntry::FreezeIn(zip_file_t* zf) const
 	return true;
 }
 
+bool MemorySavestateEntry::FreezeIn(std::span<const u8> data) const
+{
+	const u32 expectedSize = GetDataSize();
+	const u32 bytesRead = std::min(expectedSize, static_cast<u32>(data.size()));
+	if (bytesRead != expectedSize)
+	{
+		Console.WriteLn(Color_Yellow, " '%s' is incomplete (expected 0x%x bytes, loading only 0x%x bytes)",
+			GetFilename(), expectedSize, bytesRead);
+	}
+
+	std::memcpy(GetDataPtr(), data.data(), bytesRead);
+	return true;
+}
+
 bool MemorySavestateEntry::FreezeOut(SaveStateBase& writer) const
 {
 	writer.FreezeMem(GetDataPtr(), GetDataSize());
@@ -518,6 +595,11 @@ public:
 	{
 		return MemorySavestateEntry::FreezeIn(zf);
 	}
+
+	virtual bool FreezeIn(std::span<const u8> data) const override
+	{
+		return MemorySavestateEntry::FreezeIn(data);
+	}
 };
 
 class SavestateEntry_IopMemory final : public MemorySavestateEntry
@@ -607,6 +689,7 @@ public:
 
 	const char* GetFilename() const override { return "SPU2.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeIn(zf, SPU2_); }
+	bool FreezeIn(std::span<const u8> data) const override { return SysState_ComponentFreezeIn(data, SPU2_); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOut(writer, SPU2_); }
 	bool IsRequired() const override { return true; }
 };
@@ -618,6 +701,7 @@ public:
 
 	const char* GetFilename() const override { return "USB.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "USB", &USB::DoState); }
+	bool FreezeIn(std::span<const u8> data) const override { return SysState_ComponentFreezeInNew(data, "USB", &USB::DoState); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "USB", 16 * 1024, &USB::DoState); }
 	bool IsRequired() const override { return false; }
 };
@@ -629,6 +713,7 @@ public:
 
 	const char* GetFilename() const override { return "PAD.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "PAD", &Pad::Freeze); }
+	bool FreezeIn(std::span<const u8> data) const override { return SysState_ComponentFreezeInNew(data, "PAD", &Pad::Freeze); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "PAD", 16 * 1024, &Pad::Freeze); }
 	bool IsRequired() const override { return true; }
 };
@@ -640,6 +725,7 @@ public:
 
 	const char* GetFilename() const { return "GS.bin"; }
 	bool FreezeIn(zip_file_t* zf) const { return SysState_ComponentFreezeIn(zf, GS); }
+	bool FreezeIn(std::span<const u8> data) const { return SysState_ComponentFreezeIn(data, GS); }
 	bool FreezeOut(SaveStateBase& writer) const { return SysState_ComponentFreezeOut(writer, GS); }
 	bool IsRequired() const { return true; }
 };
@@ -666,6 +752,14 @@ class SaveStateEntry_Achievements final : public BaseSavestateEntry
 		return true;
 	}
 
+	bool FreezeIn(std::span<const u8> data) const override
+	{
+		if (Achievements::IsActive())
+			Achievements::LoadState(data);
+
+		return true;
+	}
+
 	bool FreezeOut(SaveStateBase& writer) const override
 	{
 		if (!Achievements::IsActive())
@@ -705,6 +799,16 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 	std::unique_ptr<ArchiveEntryList> destlist = std::make_unique<ArchiveEntryList>();
 	destlist->GetBuffer().resize(1024 * 1024 * 64);
 
+	if (!SaveState_DownloadState(destlist.get(), error))
+		destlist.reset();
+
+	return destlist;
+}
+
+bool SaveState_DownloadState(ArchiveEntryList* destlist, Error* error)
+{
+	destlist->Clear();
+
 	memSavingState saveme(destlist->GetBuffer());
 	ArchiveEntry internals(EntryFilename_InternalStructures);
 	internals.SetDataIndex(saveme.GetCurrentPos());
@@ -712,7 +816,7 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 	if (!saveme.FreezeBios())
 	{
 		Error::SetString(error, "FreezeBios() failed");
-		return nullptr;
+		return false;
 	}
 
 	if (!saveme.FreezeInternals(error))
@@ -720,7 +824,7 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 		if (!error->IsValid())
 			Error::SetString(error, "FreezeInternals() failed");
 
-		return nullptr;
+		return false;
 	}
 
 	internals.SetDataSize(saveme.GetCurrentPos() - internals.GetDataIndex());
@@ -732,8 +836,7 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 		if (!entry->FreezeOut(saveme))
 		{
 			Error::SetString(error, fmt::format("FreezeOut() failed for {}.", entry->GetFilename()));
-			destlist.reset();
-			break;
+			return false;
 		}
 
 		destlist->Add(
@@ -742,7 +845,65 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 				.SetDataSize(saveme.GetCurrentPos() - startpos));
 	}
 
-	return destlist;
+	return true;
+}
+
+// Loads a state which has already been decompressed. The internal structures are read from the start
+// of internals, and entries must be in the same order as SavestateEntries, empty if not present.
+// If entry_times is provided, the time taken to load each entry is written to it, in milliseconds.
+static bool SaveState_LoadEntries(const SaveStateBase::VmStateBuffer& internals,
+	std::span<const std::span<const u8>> entries, Error* error, double* entry_times = nullptr)
+{
+	pxAssert(entries.size() == std::size(SavestateEntries));
+
+	PreLoadPrep();
+
+	memLoadingState state(internals);
+	if (!state.FreezeBios() || !state.FreezeInternals(error))
+	{
+		if (!error->IsValid())
+			Error::SetString(error, "Save state corruption in internal structures.");
+
+		VMManager::Reset();
+		return false;
+	}
+
+	for (u32 i = 0; i < std::size(SavestateEntries); ++i)
+	{
+		Common::Timer timer;
+		if (!SavestateEntries[i]->FreezeIn(entries[i]))
+		{
+			Error::SetString(error, fmt::format("Save state corruption in {}.", SavestateEntries[i]->GetFilename()));
+			VMManager::Reset();
+			return false;
+		}
+
+		if (entry_times)
+			entry_times[i] = timer.GetTimeMilliseconds();
+	}
+
+	PostLoadPrep();
+	return true;
+}
+
+bool SaveState_LoadFromMemory(const ArchiveEntryList& srclist, Error* error)
+{
+	// Internal structures are always first, followed by each of the entries in order.
+	if (srclist.GetLength() != (std::size(SavestateEntries) + 1) || srclist[0].GetDataIndex() != 0)
+	{
+		Error::SetString(error, "Memory save state is incomplete.");
+		return false;
+	}
+
+	std::array<std::span<const u8>, std::size(SavestateEntries)> entries;
+	for (u32 i = 0; i < std::size(SavestateEntries); ++i)
+	{
+		const ArchiveEntry& entry = srclist[i + 1];
+		if (entry.GetDataSize())
+			entries[i] = std::span<const u8>(srclist.GetPtr(entry.GetDataIndex()), entry.GetDataSize());
+	}
+
+	return SaveState_LoadEntries(srclist.GetBuffer(), entries, error);
 }
 
 std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot()
@@ -765,21 +926,8 @@ std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot()
 	return data;
 }
 
-static bool SaveState_CompressScreenshot(SaveStateScreenshotData* data, zip_t* zf)
+static bool SaveState_CompressScreenshot(SaveStateScreenshotData* data, std::vector<u8>* png)
 {
-	zip_error_t ze = {};
-	zip_source_t* const zs = zip_source_buffer_create(nullptr, 0, 0, &ze);
-	if (!zs)
-		return false;
-
-	if (zip_source_begin_write(zs) != 0)
-	{
-		zip_source_free(zs);
-		return false;
-	}
-
-	ScopedGuard zs_free([zs]() { zip_source_free(zs); });
-
 	png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
 	png_infop info_ptr = nullptr;
 	if (!png_ptr)
@@ -797,8 +945,9 @@ static bool SaveState_CompressScreenshot(SaveStateScreenshotData* data, zip_t* z
 	if (setjmp(png_jmpbuf(png_ptr)))
 		return false;
 
-	png_set_write_fn(png_ptr, zs, [](png_structp png_ptr, png_bytep data_ptr, png_size_t size) {
-		zip_source_write(static_cast<zip_source_t*>(png_get_io_ptr(png_ptr)), data_ptr, size);
+	png_set_write_fn(png_ptr, png, [](png_structp png_ptr, png_bytep data_ptr, png_size_t size) {
+		std::vector<u8>* const out = static_cast<std::vector<u8>*>(png_get_io_ptr(png_ptr));
+		out->insert(out->end(), data_ptr, data_ptr + size);
 	}, [](png_structp png_ptr) {});
 	png_set_compression_level(png_ptr, 5);
 	png_set_IHDR(png_ptr, info_ptr, data->width, data->height, 8, PNG_COLOR_TYPE_RGBA,
@@ -816,28 +965,42 @@ static bool SaveState_CompressScreenshot(SaveStateScreenshotData* data, zip_t* z
 	}
 
 	png_write_end(png_ptr, nullptr);
+	return true;
+}
+
+static bool SaveState_CompressScreenshot(SaveStateScreenshotData* data, zip_t* zf)
+{
+	std::vector<u8> png;
+	if (!SaveState_CompressScreenshot(data, &png))
+		return false;
+
+	void* const png_data = std::malloc(png.size());
+	if (!png_data)
+		return false;
+
+	std::memcpy(png_data, png.data(), png.size());
 
-	if (zip_source_commit_write(zs) != 0)
+	zip_source_t* const zs = zip_source_buffer(zf, png_data, png.size(), 1);
+	if (!zs)
+	{
+		std::free(png_data);
 		return false;
+	}
 
 	const s64 file_index = zip_file_add(zf, EntryFilename_Screenshot, zs, 0);
 	if (file_index < 0)
+	{
+		zip_source_free(zs);
 		return false;
+	}
 
 	// png is already compressed, no point doing it twice
 	zip_set_file_compression(zf, file_index, ZIP_CM_STORE, 0);
-
-	// source is now owned by the zip file for later compression
-	zs_free.Cancel();
 	return true;
 }
 
-static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height, std::vector<u32>* out_pixels)
+static bool SaveState_DecodeScreenshot(std::span<const u8> png, u32* out_width, u32* out_height, std::vector<u32>* out_pixels)
 {
-	auto zff = zip_fopen_managed(zf, EntryFilename_Screenshot, 0);
-	if (!zff)
-		return false;
-
 	png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
 	if (!png_ptr)
 		return false;
@@ -856,8 +1019,13 @@ static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height,
 	if (setjmp(png_jmpbuf(png_ptr)))
 		return false;
 
-	png_set_read_fn(png_ptr, zff.get(), [](png_structp png_ptr, png_bytep data_ptr, png_size_t size) {
-		zip_fread(static_cast<zip_file_t*>(png_get_io_ptr(png_ptr)), data_ptr, size);
+	png_set_read_fn(png_ptr, &png, [](png_structp png_ptr, png_bytep data_ptr, png_size_t size) {
+		std::span<const u8>* const in = static_cast<std::span<const u8>*>(png_get_io_ptr(png_ptr));
+		if (in->size() < size)
+			png_error(png_ptr, "Screenshot is truncated");
+
+		std::memcpy(data_ptr, in->data(), size);
+		*in = in->subspan(size);
 	});
 
 	png_read_info(png_ptr, info_ptr);
@@ -911,6 +1079,544 @@ static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height,
 	return true;
 }
 
+static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height, std::vector<u32>* out_pixels)
+{
+	zip_stat_t zst;
+	const zip_int64_t index = zip_name_locate(zf, EntryFilename_Screenshot, 0);
+	if (index < 0 || zip_stat_index(zf, index, 0, &zst) != 0)
+		return false;
+
+	auto zff = zip_fopen_index_managed(zf, index, 0);
+	if (!zff)
+		return false;
+
+	std::vector<u8> png(zst.size);
+	if (zip_fread(zff.get(), png.data(), png.size()) != static_cast<zip_int64_t>(png.size()))
+		return false;
+
+	return SaveState_DecodeScreenshot(png, out_width, out_height, out_pixels);
+}
+
+static bool CheckSaveVersion(u32 savever, const char* version_string, Error* error)
+{
+	// Major version mismatch.  Means we can't load this savestate at all.  Support for it
+	// was removed entirely.
+	// check for a "minor" version incompatibility; which happens if the savestate being loaded is a newer version
+	// than the emulator recognizes.  99% chance that trying to load it will just corrupt emulation or crash.
+	if (savever > g_SaveVersion || (savever >> 16) != (g_SaveVersion >> 16))
+	{
+		Error::SetString(error, fmt::format(TRANSLATE_FS("SaveState","This save state is outdated and is no longer compatible "
+											"with the current version of PCSX2.\n\n"
+											"If you have any unsaved progress on this save state, you can download the compatible version (PCSX2 {}) "
+											"from pcsx2.net, load the save state, and save your progress to the memory card."),
+											version_string));
+		return false;
+	}
+
+	return true;
+}
+
+static void SaveState_GetVersionString(char (&version)[STATE_PCSX2_VERSION_SIZE])
+{
+	if (BuildVersion::GitTaggedCommit)
+		StringUtil::Strlcpy(version, BuildVersion::GitTag, std::size(version));
+	else
+		StringUtil::Strlcpy(version, "Unknown", std::size(version));
+}
+
+// --------------------------------------------------------------------------------------
+//  Parallel zstd container
+// --------------------------------------------------------------------------------------
+// Rather than a zip, each component is split into chunks which are compressed as independent
+// zstd frames. All chunks are compressed (or decompressed) at the same time, and written out in
+// order as soon as they're ready, so saving EE memory no longer holds up everything else.
+//
+// Layout: ParallelStateHeader, then for each component a ParallelStateComponentHeader followed by
+// num_chunks of ParallelStateChunkHeader + data. A chunk which didn't compress is stored as-is,
+// in which case compressed_size is equal to size.
+
+static constexpr u32 PARALLEL_STATE_MAGIC = 0x5A533250; // P2SZ
+static constexpr u32 PARALLEL_STATE_CHUNK_SIZE = 4 * _1mb;
+static constexpr u32 PARALLEL_STATE_NAME_LENGTH = 64;
+
+struct ParallelStateHeader
+{
+	u32 magic;
+	u32 save_version;
+	char version[STATE_PCSX2_VERSION_SIZE];
+	u32 num_components;
+};
+
+struct ParallelStateComponentHeader
+{
+	char name[PARALLEL_STATE_NAME_LENGTH];
+	u32 size;
+	u32 num_chunks;
+};
+
+struct ParallelStateChunkHeader
+{
+	u32 size;
+	u32 compressed_size;
+};
+
+namespace
+{
+	/// Runs (de)compression jobs for the parallel state container on a set of worker threads.
+	class ParallelStateJobQueue
+	{
+	public:
+		explicit ParallelStateJobQueue(u32 max_jobs)
+		{
+			const u32 num_threads = std::clamp(std::min(std::thread::hardware_concurrency(), max_jobs), 1u, 16u);
+			for (u32 i = 0; i < num_threads; i++)
+				m_threads.emplace_back(&ParallelStateJobQueue::WorkerThread, this);
+		}
+
+		~ParallelStateJobQueue()
+		{
+			{
+				std::unique_lock lock(m_mutex);
+				m_shutdown = true;
+				m_work_cv.notify_all();
+			}
+
+			for (std::thread& thread : m_threads)
+				thread.join();
+		}
+
+		void Push(std::function<void()> job)
+		{
+			std::unique_lock lock(m_mutex);
+			m_jobs.push_back(std::move(job));
+			m_pending_jobs++;
+			m_work_cv.notify_one();
+		}
+
+		void WaitForAll()
+		{
+			std::unique_lock lock(m_mutex);
+			m_done_cv.wait(lock, [this]() { return (m_pending_jobs == 0); });
+		}
+
+	private:
+		void WorkerThread()
+		{
+			std::unique_lock lock(m_mutex);
+			for (;;)
+			{
+				m_work_cv.wait(lock, [this]() { return (m_shutdown || !m_jobs.empty()); });
+				if (m_jobs.empty())
+					break;
+
+				std::function<void()> job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+				lock.unlock();
+				job();
+				lock.lock();
+
+				m_pending_jobs--;
+				m_done_cv.notify_all();
+			}
+		}
+
+		std::vector<std::thread> m_threads;
+		std::deque<std::function<void()>> m_jobs;
+		std::mutex m_mutex;
+		std::condition_variable m_work_cv;
+		std::condition_variable m_done_cv;
+		u32 m_pending_jobs = 0;
+		bool m_shutdown = false;
+	};
+} // namespace
+
+static int SaveState_GetZstdCompressionLevel()
+{
+	switch (EmuConfig.Savestate.CompressionRatio)
+	{
+		case SavestateCompressionLevel::Low:
+			return 1;
+		case SavestateCompressionLevel::High:
+			return 10;
+		case SavestateCompressionLevel::VeryHigh:
+			return 22;
+		case SavestateCompressionLevel::Medium:
+		default:
+			return 3;
+	}
+}
+
+static bool SaveState_WriteParallelState(ArchiveEntryList* srclist, SaveStateScreenshotData* screenshot, const char* filename)
+{
+	struct Component
+	{
+		const char* name;
+		const u8* data;
+		u32 size;
+		u32 first_chunk;
+		u32 num_chunks;
+	};
+
+	struct Chunk
+	{
+		const u8* data;
+		u32 size;
+		std::vector<u8> compressed;
+		double time_ms;
+		bool done;
+	};
+
+	std::vector<u8> png;
+	if (screenshot && !SaveState_CompressScreenshot(screenshot, &png))
+		return false;
+
+	std::vector<Component> components;
+	std::vector<Chunk> chunks;
+	const auto add_component = [&components, &chunks](const char* name, const u8* data, u32 size) {
+		Component& comp = components.emplace_back(Component{name, data, size, static_cast<u32>(chunks.size()), 0});
+		for (u32 offset = 0; offset < size; offset += PARALLEL_STATE_CHUNK_SIZE)
+		{
+			chunks.push_back(Chunk{data + offset, std::min(size - offset, PARALLEL_STATE_CHUNK_SIZE), {}, 0.0, false});
+			comp.num_chunks++;
+		}
+	};
+
+	for (uint i = 0; i < srclist->GetLength(); ++i)
+	{
+		const ArchiveEntry& entry = (*srclist)[i];
+		if (entry.GetDataSize())
+			add_component(entry.GetFilename().c_str(), srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize());
+	}
+	if (!png.empty())
+		add_component(EntryFilename_Screenshot, png.data(), static_cast<u32>(png.size()));
+
+	// Write to a temporary file, so a failed save doesn't destroy the old state.
+	const std::string temp_filename = fmt::format("{}.tmp", filename);
+	auto fp = FileSystem::OpenManagedCFile(temp_filename.c_str(), "wb");
+	if (!fp)
+	{
+		Console.Error("Failed to open '%s' for save state.", temp_filename.c_str());
+		return false;
+	}
+
+	ParallelStateHeader header = {};
+	header.magic = PARALLEL_STATE_MAGIC;
+	header.save_version = g_SaveVersion;
+	SaveState_GetVersionString(header.version);
+	header.num_components = static_cast<u32>(components.size());
+	bool result = (std::fwrite(&header, sizeof(header), 1, fp.get()) == 1);
+
+	{
+		const int level = SaveState_GetZstdCompressionLevel();
+		std::mutex done_mutex;
+		std::condition_variable done_cv;
+
+		ParallelStateJobQueue queue(static_cast<u32>(chunks.size()));
+		for (Chunk& chunk : chunks)
+		{
+			queue.Push([&chunk, &done_mutex, &done_cv, level]() {
+				Common::Timer timer;
+				chunk.compressed.resize(ZSTD_compressBound(chunk.size));
+				const size_t compressed_size =
+					ZSTD_compress(chunk.compressed.data(), chunk.compressed.size(), chunk.data, chunk.size, level);
+				if (ZSTD_isError(compressed_size) || compressed_size >= chunk.size)
+					chunk.compressed.clear();
+				else
+					chunk.compressed.resize(compressed_size);
+
+				std::unique_lock lock(done_mutex);
+				chunk.time_ms = timer.GetTimeMilliseconds();
+				chunk.done = true;
+				done_cv.notify_one();
+			});
+		}
+
+		// Stream each chunk out as soon as it, and everything before it, has been compressed.
+		for (const Component& comp : components)
+		{
+			ParallelStateComponentHeader comp_header = {};
+			StringUtil::Strlcpy(comp_header.name, comp.name, std::size(comp_header.name));
+			comp_header.size = comp.size;
+			comp_header.num_chunks = comp.num_chunks;
+			result = result && (std::fwrite(&comp_header, sizeof(comp_header), 1, fp.get()) == 1);
+
+			double comp_time = 0.0;
+			u32 comp_compressed_size = 0;
+			for (u32 i = 0; i < comp.num_chunks; i++)
+			{
+				Chunk& chunk = chunks[comp.first_chunk + i];
+				{
+					std::unique_lock lock(done_mutex);
+					done_cv.wait(lock, [&chunk]() { return chunk.done; });
+				}
+
+				// Empty compressed data means the chunk is stored uncompressed.
+				const bool stored = chunk.compressed.empty();
+				const ParallelStateChunkHeader chunk_header = {
+					chunk.size, stored ? chunk.size : static_cast<u32>(chunk.compressed.size())};
+				result = result && (std::fwrite(&chunk_header, sizeof(chunk_header), 1, fp.get()) == 1) &&
+						 (std::fwrite(stored ? chunk.data : chunk.compressed.data(), chunk_header.compressed_size, 1,
+							  fp.get()) == 1);
+
+				comp_time += chunk.time_ms;
+				comp_compressed_size += chunk_header.compressed_size;
+				chunk.compressed = {};
+			}
+
+			if (EmuConfig.Savestate.LogTimings)
+			{
+				Console.WriteLn("  %-32s %10u -> %10u bytes, compressed in %.2f ms", comp.name, comp.size,
+					comp_compressed_size, comp_time);
+			}
+		}
+
+		// Don't let the jobs outlive the data they're pointing to.
+		queue.WaitForAll();
+	}
+
+	result = result && (std::fflush(fp.get()) == 0);
+	fp.reset();
+
+	Error error;
+	if (!result || !FileSystem::RenamePath(temp_filename.c_str(), filename, &error))
+	{
+		Console.Error(fmt::format("Failed to write save state to '{}': {}", filename, error.GetDescription()));
+		FileSystem::DeleteFilePath(temp_filename.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+// Reads the next component from a parallel state, returning false on error. If dest is null, the
+// component is skipped. Otherwise, chunks are decompressed by the queue, or on this thread if it's null.
+static bool SaveState_ReadParallelStateComponent(std::FILE* fp, const ParallelStateComponentHeader& header,
+	u8* dest, ParallelStateJobQueue* queue, std::deque<std::vector<u8>>* compressed_chunks,
+	std::atomic<double>* time_ms, std::atomic_bool* failed)
+{
+	u32 offset = 0;
+	for (u32 i = 0; i < header.num_chunks; i++)
+	{
+		ParallelStateChunkHeader chunk_header;
+		if (std::fread(&chunk_header, sizeof(chunk_header), 1, fp) != 1 || chunk_header.size > header.size - offset ||
+			chunk_header.size > PARALLEL_STATE_CHUNK_SIZE ||
+			chunk_header.compressed_size > ZSTD_compressBound(PARALLEL_STATE_CHUNK_SIZE))
+		{
+			return false;
+		}
+
+		if (!dest)
+		{
+			if (FileSystem::FSeek64(fp, chunk_header.compressed_size, SEEK_CUR) != 0)
+				return false;
+
+			offset += chunk_header.size;
+			continue;
+		}
+
+		u8* const chunk_dest = dest + offset;
+		offset += chunk_header.size;
+
+		// Stored chunks can go straight to their destination.
+		if (chunk_header.compressed_size == chunk_header.size)
+		{
+			if (std::fread(chunk_dest, chunk_header.size, 1, fp) != 1)
+				return false;
+
+			continue;
+		}
+
+		std::vector<u8>& compressed = compressed_chunks->emplace_back(chunk_header.compressed_size);
+		if (std::fread(compressed.data(), compressed.size(), 1, fp) != 1)
+			return false;
+
+		const auto decompress = [&compressed, chunk_dest, size = chunk_header.size, time_ms, failed]() {
+			Common::Timer timer;
+			const size_t result = ZSTD_decompress(chunk_dest, size, compressed.data(), compressed.size());
+			if (ZSTD_isError(result) || result != size)
+				failed->store(true, std::memory_order_release);
+
+			compressed = {};
+			time_ms->fetch_add(timer.GetTimeMilliseconds(), std::memory_order_relaxed);
+		};
+
+		if (queue)
+			queue->Push(decompress);
+		else
+			decompress();
+	}
+
+	return (offset == header.size);
+}
+
+static bool SaveState_IsValidParallelStateComponent(const ParallelStateComponentHeader& header, u32 max_size)
+{
+	// Sizes come from the file, so check them before allocating anything.
+	return (header.size <= max_size &&
+			header.num_chunks == (header.size + PARALLEL_STATE_CHUNK_SIZE - 1) / PARALLEL_STATE_CHUNK_SIZE);
+}
+
+static bool SaveState_ReadParallelState(std::FILE* fp, Error* error)
+{
+	ParallelStateHeader header;
+	if (std::fread(&header, sizeof(header), 1, fp) != 1 || header.magic != PARALLEL_STATE_MAGIC)
+	{
+		Error::SetString(error, "Savestate file does not contain version indicator.");
+		return false;
+	}
+
+	header.version[STATE_PCSX2_VERSION_SIZE - 1] = 0;
+	if (!CheckSaveVersion(header.save_version, header.version, error))
+		return false;
+
+	// Component 0 is the internal structures, the rest follow SavestateEntries.
+	static constexpr u32 NUM_COMPONENTS = std::size(SavestateEntries) + 1;
+	std::array<SaveStateBase::VmStateBuffer, NUM_COMPONENTS> data;
+	std::array<bool, NUM_COMPONENTS> present = {};
+	std::array<std::atomic<double>, NUM_COMPONENTS> decompress_times = {};
+	std::array<double, std::size(SavestateEntries)> load_times = {};
+	std::atomic_bool decompress_failed{false};
+	std::deque<std::vector<u8>> compressed_chunks;
+
+	{
+		ParallelStateJobQueue queue(std::numeric_limits<u32>::max());
+
+		for (u32 i = 0; i < header.num_components; i++)
+		{
+			ParallelStateComponentHeader comp_header;
+			if (std::fread(&comp_header, sizeof(comp_header), 1, fp) != 1)
+			{
+				Error::SetString(error, "Save state is truncated.");
+				return false;
+			}
+			comp_header.name[PARALLEL_STATE_NAME_LENGTH - 1] = 0;
+
+			u32 index = NUM_COMPONENTS;
+			if (std::strcmp(comp_header.name, EntryFilename_InternalStructures) == 0)
+			{
+				index = 0;
+			}
+			else
+			{
+				for (u32 j = 0; j < std::size(SavestateEntries); j++)
+				{
+					if (std::strcmp(comp_header.name, SavestateEntries[j]->GetFilename()) == 0)
+					{
+						index = j + 1;
+						break;
+					}
+				}
+			}
+
+			// Skip over anything we don't know about, e.g. the screenshot.
+			u8* dest = nullptr;
+			if (index < NUM_COMPONENTS && !present[index])
+			{
+				const u32 max_size =
+					(index == 0) ? BaseSavestateEntry::MAX_ENTRY_DATA_SIZE : SavestateEntries[index - 1]->GetMaxDataSize();
+				if (!SaveState_IsValidParallelStateComponent(comp_header, max_size))
+				{
+					Error::SetString(error, fmt::format("Save state corruption in {}.", comp_header.name));
+					return false;
+				}
+
+				present[index] = true;
+				data[index].resize(comp_header.size);
+				dest = data[index].data();
+			}
+
+			if (!SaveState_ReadParallelStateComponent(fp, comp_header, dest, &queue, &compressed_chunks,
+					dest ? &decompress_times[index] : nullptr, &decompress_failed))
+			{
+				Error::SetString(error, fmt::format("Save state corruption in {}.", comp_header.name));
+				return false;
+			}
+		}
+
+		queue.WaitForAll();
+	}
+
+	if (decompress_failed.load(std::memory_order_acquire))
+	{
+		Error::SetString(error, "Failed to decompress save state.");
+		return false;
+	}
+
+	// Log any parts and pieces that are missing, and then generate an exception.
+	bool all_present = present[0];
+	std::array<std::span<const u8>, std::size(SavestateEntries)> entries;
+	for (u32 i = 0; i < std::size(SavestateEntries); i++)
+	{
+		if (present[i + 1])
+			entries[i] = data[i + 1];
+		else if (SavestateEntries[i]->IsRequired())
+			all_present = false;
+	}
+	if (!all_present)
+	{
+		Error::SetString(error, "Some required components were not found or are incomplete.");
+		return false;
+	}
+
+	if (!SaveState_LoadEntries(data[0], entries, error, load_times.data()))
+		return false;
+
+	if (EmuConfig.Savestate.LogTimings)
+	{
+		for (u32 i = 0; i < std::size(SavestateEntries); i++)
+		{
+			Console.WriteLn("  %-32s %10zu bytes, decompressed in %.2f ms, loaded in %.2f ms",
+				SavestateEntries[i]->GetFilename(), data[i + 1].size(),
+				decompress_times[i + 1].load(std::memory_order_relaxed), load_times[i]);
+		}
+	}
+
+	return true;
+}
+
+static bool SaveState_ReadParallelStateScreenshot(std::FILE* fp, u32* out_width, u32* out_height, std::vector<u32>* out_pixels)
+{
+	ParallelStateHeader header;
+	if (std::fread(&header, sizeof(header), 1, fp) != 1 || header.magic != PARALLEL_STATE_MAGIC)
+		return false;
+
+	for (u32 i = 0; i < header.num_components; i++)
+	{
+		ParallelStateComponentHeader comp_header;
+		if (std::fread(&comp_header, sizeof(comp_header), 1, fp) != 1)
+			return false;
+		comp_header.name[PARALLEL_STATE_NAME_LENGTH - 1] = 0;
+
+		const bool is_screenshot = (std::strcmp(comp_header.name, EntryFilename_Screenshot) == 0);
+		if (is_screenshot && !SaveState_IsValidParallelStateComponent(comp_header, BaseSavestateEntry::MAX_ENTRY_DATA_SIZE))
+			return false;
+
+		std::vector<u8> png(is_screenshot ? comp_header.size : 0);
+		std::deque<std::vector<u8>> compressed_chunks;
+		std::atomic<double> time_ms{0.0};
+		std::atomic_bool failed{false};
+		if (!SaveState_ReadParallelStateComponent(fp, comp_header, is_screenshot ? png.data() : nullptr, nullptr,
+				&compressed_chunks, &time_ms, &failed) ||
+			failed.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		if (is_screenshot)
+			return SaveState_DecodeScreenshot(png, out_width, out_height, out_pixels);
+	}
+
+	return false;
+}
+
+static bool SaveState_IsParallelState(std::FILE* fp)
+{
+	u32 magic;
+	const bool result = (std::fread(&magic, sizeof(magic), 1, fp) == 1 && magic == PARALLEL_STATE_MAGIC);
+	FileSystem::FSeek64(fp, 0, SEEK_SET);
+	return result;
+}
+
 // --------------------------------------------------------------------------------------
 //  CompressThread_VmState
 // --------------------------------------------------------------------------------------
@@ -972,14 +1678,7 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 
 		VersionIndicator* vi = static_cast<VersionIndicator*>(std::malloc(sizeof(VersionIndicator)));
 		vi->save_version = g_SaveVersion;
-		if (BuildVersion::GitTaggedCommit)
-		{
-			StringUtil::Strlcpy(vi->version, BuildVersion::GitTag, std::size(vi->version));
-		}
-		else
-		{
-			StringUtil::Strlcpy(vi->version, "Unknown", std::size(vi->version));
-		}
+		SaveState_GetVersionString(vi->version);
 
 		zip_source_t* const zs = zip_source_buffer(zf, vi, sizeof(*vi), 1);
 		if (!zs)
@@ -1031,6 +1730,17 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 
 bool SaveState_ZipToDisk(std::unique_ptr<ArchiveEntryList> srclist, std::unique_ptr<SaveStateScreenshotData> screenshot, const char* filename)
 {
+	if (EmuConfig.Savestate.CompressionType == SavestateCompressionMethod::ZstandardParallel)
+	{
+		Common::Timer timer;
+		if (!SaveState_WriteParallelState(srclist.get(), screenshot.get(), filename))
+			return false;
+
+		if (EmuConfig.Savestate.LogTimings)
+			Console.WriteLn("Parallel save state written in %.2f ms", timer.GetTimeMilliseconds());
+		return true;
+	}
+
 	zip_error_t ze = {};
 	zip_source_t* zs = zip_source_file_create(filename, 0, 0, &ze);
 	zip_t* zf = nullptr;
@@ -1058,6 +1768,9 @@ bool SaveState_ZipToDisk(std::unique_ptr<ArchiveEntryList> srclist, std::unique_
 
 bool SaveState_ReadScreenshot(const std::string& filename, u32* out_width, u32* out_height, std::vector<u32>* out_pixels)
 {
+	if (auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb"); fp && SaveState_IsParallelState(fp.get()))
+		return SaveState_ReadParallelStateScreenshot(fp.get(), out_width, out_height, out_pixels);
+
 	zip_error_t ze = {};
 	auto zf = zip_open_managed(filename.c_str(), ZIP_RDONLY, &ze);
 	if (!zf)
@@ -1086,21 +1799,7 @@ static bool CheckVersion(const std::string& filename, zip_t* zf, Error* error)
 	else
 		StringUtil::Strlcpy(version_string, "Unknown", std::size(version_string));
 
-	// Major version mismatch.  Means we can't load this savestate at all.  Support for it
-	// was removed entirely.
-	// check for a "minor" version incompatibility; which happens if the savestate being loaded is a newer version
-	// than the emulator recognizes.  99% chance that trying to load it will just corrupt emulation or crash.
-	if (savever > g_SaveVersion || (savever >> 16) != (g_SaveVersion >> 16))
-	{
-		Error::SetString(error, fmt::format(TRANSLATE_FS("SaveState","This save state is outdated and is no longer compatible "
-											"with the current version of PCSX2.\n\n"
-											"If you have any unsaved progress on this save state, you can download the compatible version (PCSX2 {}) "
-											"from pcsx2.net, load the save state, and save your progress to the memory card."),
-											version_string));
-		return false;
-	}
-
-	return true;
+	return CheckSaveVersion(savever, version_string, error);
 }
 
 static zip_int64_t CheckFileExistsInState(zip_t* zf, const char* name, bool required)
@@ -1147,6 +1846,17 @@ static bool LoadInternalStructuresState(zip_t* zf, s64 index, Error* error)
 
 bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 {
+	if (auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb"); fp && SaveState_IsParallelState(fp.get()))
+	{
+		Common::Timer timer;
+		if (!SaveState_ReadParallelState(fp.get(), error))
+			return false;
+
+		if (EmuConfig.Savestate.LogTimings)
+			Console.WriteLn("Parallel save state loaded in %.2f ms", timer.GetTimeMilliseconds());
+		return true;
+	}
+
 	zip_error_t ze = {};
 	auto zf = zip_open_managed(filename.c_str(), ZIP_RDONLY, &ze);
 	if (!zf)
@@ -52,6 +52,8 @@ class ArchiveEntryList;
 // Wrappers to generate a save state compatible across all frontends.
 // These functions assume that the caller has paused the core thread.
 extern std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error);
+extern bool SaveState_DownloadState(ArchiveEntryList* destlist, Error* error);
+extern bool SaveState_LoadFromMemory(const ArchiveEntryList& srclist, Error* error);
 extern std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot();
 extern bool SaveState_ZipToDisk(std::unique_ptr<ArchiveEntryList> srclist, std::unique_ptr<SaveStateScreenshotData> screenshot, const char* filename);
 extern bool SaveState_ReadScreenshot(const std::string& filename, u32* out_width, u32* out_height, std::vector<u32>* out_pixels);
@@ -312,6 +314,12 @@ public:
 		return *this;
 	}
 
+	// Removes all entries, but keeps the buffer around so it can be reused.
+	void Clear()
+	{
+		m_list.clear();
+	}
+
 	size_t GetLength() const
 	{
 		return m_list.size();
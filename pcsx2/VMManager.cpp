@@ -58,8 +58,10 @@
 #include "cpuinfo.h"
 #include "discord_rpc.h"
 #include "fmt/core.h"
+#include "zstd.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <sstream>
 
@@ -121,6 +123,19 @@ namespace VMManager
 		std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, std::string filename,
 		s32 slot_for_message);
 
+	static void UpdateRewindState();
+	static void ClearRewindStates();
+	static bool CountRewindFrame();
+	static void ProcessRewindOnCPUThread();
+	static void SaveRewindState();
+	static void DoRewind();
+	static void WaitForRewindThread();
+	static void RewindThreadEntryPoint();
+
+	static void UpdateRunaheadState();
+	static void ClearRunaheadStates();
+	static void ProcessRunaheadOnCPUThread();
+
 	static void LoadSettings();
 	static void LoadCoreSettings(SettingsInterface& si);
 	static void ApplyCoreSettings();
@@ -154,11 +169,56 @@ static bool s_log_force_file_log = false;
 
 static std::atomic<VMState> s_state{VMState::Shutdown};
 static bool s_cpu_implementation_changed = false;
+static bool s_memory_states_pending = false;
 static Threading::ThreadHandle s_vm_thread_handle;
 
 static std::deque<std::thread> s_save_state_threads;
 static std::mutex s_save_state_threads_mutex;
 
+namespace
+{
+	/// Reconstructs a rewind state from the state which was captured after it.
+	struct RewindDelta
+	{
+		std::vector<std::pair<u32, u32>> layout; // data index and size of each entry in the older state
+		u32 uncompressed_size;
+		std::vector<u8> data;
+	};
+} // namespace
+
+static constexpr u32 REWIND_PAGE_SIZE = 4096;
+static constexpr u32 REWIND_DELTA_END = 0xFFFFFFFFu;
+
+static bool s_rewind_enabled = false;
+static std::atomic_bool s_rewinding{false};
+static u32 s_rewind_save_frequency = 0;
+static u32 s_rewind_save_counter = 0;
+static size_t s_rewind_buffer_budget = 0;
+
+// The most recent state is kept uncompressed, every older state is a chain of deltas from it.
+static std::unique_ptr<ArchiveEntryList> s_rewind_head;
+static std::unique_ptr<ArchiveEntryList> s_rewind_spare;
+static bool s_rewind_head_valid = false;
+static bool s_rewind_head_loaded = false;
+static std::vector<u8> s_rewind_decompress_buffer;
+
+static std::thread s_rewind_thread;
+static std::mutex s_rewind_mutex;
+static std::condition_variable s_rewind_cv;
+static bool s_rewind_thread_shutdown = false;
+static ArchiveEntryList* s_rewind_job_older = nullptr;
+static ArchiveEntryList* s_rewind_job_newer = nullptr;
+static std::deque<RewindDelta> s_rewind_deltas;
+static size_t s_rewind_deltas_size = 0;
+static size_t s_rewind_states_size = 0; // the two uncompressed states, counted against the budget too
+
+static u32 s_runahead_frames = 0;
+static u32 s_runahead_replay_frames = 0;
+static bool s_runahead_replay_pending = false;
+static Common::Timer s_runahead_frame_timer;
+static std::deque<std::unique_ptr<ArchiveEntryList>> s_runahead_states;
+static std::vector<std::unique_ptr<ArchiveEntryList>> s_runahead_free_states;
+
 static std::recursive_mutex s_info_mutex;
 static std::string s_disc_serial;
 static std::string s_disc_elf;
@@ -273,6 +333,7 @@ void VMManager::SetState(VMState state)
 				vu1Thread.WaitVU();
 			MTGS::WaitGS(false);
 			InputManager::PauseVibration();
+			DEV9flushHDD();
 		}
 		else
 		{
@@ -1449,6 +1510,7 @@ bool VMManager::Initialize(VMBootParameters boot_params)
 	s_use_vsync_for_timing = false;
 
 	s_cpu_implementation_changed = false;
+	s_memory_states_pending = false;
 	UpdateCPUImplementations();
 	mmap_ResetBlockTracking();
 	memSetExtraMemMode(EmuConfig.Cpu.ExtraMemory);
@@ -1562,6 +1624,8 @@ bool VMManager::Initialize(VMBootParameters boot_params)
 	UpdateInhibitScreensaver(EmuConfig.InhibitScreensaver);
 
 	SetEmuThreadAffinities();
+	UpdateRewindState();
+	UpdateRunaheadState();
 
 	// do we want to load state?
 	if (!GSDumpReplayer::IsReplayingDump() && !state_to_load.empty())
@@ -1589,6 +1653,8 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (THREAD_VU1)
 		vu1Thread.WaitVU();
 	MTGS::WaitGS();
+	UpdateRewindState();
+	UpdateRunaheadState();
 
 	if (!GSDumpReplayer::IsReplayingDump() && save_resume_state)
 	{
@@ -1707,6 +1773,8 @@ void VMManager::Reset()
 	SysMemory::Reset();
 	cpuReset();
 	hwReset();
+	ClearRewindStates();
+	ClearRunaheadStates();
 
 	if (g_InputRecording.isActive())
 	{
@@ -1812,6 +1880,8 @@ bool VMManager::DoLoadState(const char* filename)
 	}
 
 	Host::OnSaveStateLoaded(filename, true);
+	ClearRewindStates();
+	ClearRunaheadStates();
 	if (g_InputRecording.isActive())
 	{
 		g_InputRecording.handleLoadingSavestate();
@@ -1829,6 +1899,9 @@ bool VMManager::DoSaveState(const char* filename, s32 slot_for_message, bool zip
 	std::string osd_key(fmt::format("SaveStateSlot{}", slot_for_message));
 	Error error;
 
+	// The HDD image isn't part of the state, but make sure it matches the state when it was saved.
+	DEV9flushHDD();
+
 	std::unique_ptr<ArchiveEntryList> elist = SaveState_DownloadState(&error);
 	if (!elist)
 	{
@@ -2046,6 +2119,502 @@ bool VMManager::SaveStateToSlot(s32 slot, bool zip_on_thread)
 	return DoSaveState(filename.c_str(), slot, zip_on_thread, EmuConfig.BackupSavestate);
 }
 
+bool VMManager::IsRewindEnabled()
+{
+	return s_rewind_enabled;
+}
+
+void VMManager::SetRewinding(bool rewinding)
+{
+	if (!s_rewind_enabled)
+		rewinding = false;
+
+	// The next rewind should start from the newest state again, not where we left off.
+	if (!s_rewinding.exchange(rewinding, std::memory_order_acq_rel) && rewinding)
+		s_rewind_head_loaded = false;
+}
+
+bool VMManager::IsRewinding()
+{
+	return s_rewinding.load(std::memory_order_acquire);
+}
+
+u32 VMManager::GetRewindStateCount()
+{
+	std::unique_lock lock(s_rewind_mutex);
+	return static_cast<u32>(s_rewind_deltas.size()) + static_cast<u32>(s_rewind_head_valid);
+}
+
+size_t VMManager::GetRewindMemoryUsage()
+{
+	std::unique_lock lock(s_rewind_mutex);
+	return s_rewind_deltas_size + s_rewind_states_size;
+}
+
+static size_t GetRewindStateSize(const ArchiveEntryList& list)
+{
+	const ArchiveEntry& last = list[static_cast<uint>(list.GetLength() - 1)];
+	return last.GetDataIndex() + last.GetDataSize();
+}
+
+static void PadRewindStateBuffer(ArchiveEntryList& list, size_t used_size, size_t padded_size)
+{
+	// Anything past the end of the state has to read as zeros, otherwise deltas between states of
+	// different sizes won't reconstruct the same bytes when they're applied.
+	std::vector<u8>& buffer = list.GetBuffer();
+	if (buffer.size() < padded_size)
+		buffer.resize(padded_size);
+	std::memset(buffer.data() + used_size, 0, padded_size - used_size);
+}
+
+void VMManager::UpdateRewindState()
+{
+	// Run-ahead is already loading states every time the input changes, the two don't mix.
+	const bool enable = EmuConfig.Savestate.RewindEnable && EmuConfig.Savestate.RunaheadFrameCount == 0 &&
+						HasValidVM() && !GSDumpReplayer::IsReplayingDump();
+	const size_t budget = static_cast<size_t>(EmuConfig.Savestate.RewindBufferSize) * _1mb;
+	if (enable == s_rewind_enabled && s_rewind_save_frequency == EmuConfig.Savestate.RewindSaveFrequency &&
+		s_rewind_buffer_budget == budget)
+	{
+		return;
+	}
+
+	ClearRewindStates();
+
+	if (!enable)
+	{
+		if (s_rewind_thread.joinable())
+		{
+			{
+				std::unique_lock lock(s_rewind_mutex);
+				s_rewind_thread_shutdown = true;
+				s_rewind_cv.notify_one();
+			}
+			s_rewind_thread.join();
+		}
+
+		s_rewind_head.reset();
+		s_rewind_spare.reset();
+		s_rewind_decompress_buffer = {};
+		s_rewind_enabled = false;
+		s_rewind_save_frequency = 0;
+		s_rewind_buffer_budget = 0;
+		s_rewinding.store(false, std::memory_order_release);
+		return;
+	}
+
+	Console.WriteLn(fmt::format(
+		"Rewind enabled, saving every {} frames with a {} MB buffer.", EmuConfig.Savestate.RewindSaveFrequency,
+		EmuConfig.Savestate.RewindBufferSize));
+
+	s_rewind_enabled = true;
+	s_rewind_save_frequency = EmuConfig.Savestate.RewindSaveFrequency;
+	s_rewind_buffer_budget = budget;
+	if (!s_rewind_head)
+	{
+		s_rewind_head = std::make_unique<ArchiveEntryList>();
+		s_rewind_spare = std::make_unique<ArchiveEntryList>();
+	}
+
+	if (!s_rewind_thread.joinable())
+	{
+		s_rewind_thread_shutdown = false;
+		s_rewind_thread = std::thread(&VMManager::RewindThreadEntryPoint);
+	}
+}
+
+void VMManager::ClearRewindStates()
+{
+	WaitForRewindThread();
+
+	std::unique_lock lock(s_rewind_mutex);
+	s_rewind_deltas.clear();
+	s_rewind_deltas_size = 0;
+	s_rewind_head_valid = false;
+	s_rewind_head_loaded = false;
+	s_rewind_save_counter = 0;
+	s_memory_states_pending = false;
+}
+
+bool VMManager::CountRewindFrame()
+{
+	if (!s_rewind_enabled)
+		return false;
+
+	if (s_rewinding.load(std::memory_order_acquire) && s_rewind_head_valid)
+		return true;
+
+	if (s_rewind_save_counter > 0)
+	{
+		s_rewind_save_counter--;
+		return false;
+	}
+
+	return true;
+}
+
+void VMManager::ProcessRewindOnCPUThread()
+{
+	if (!s_rewind_enabled)
+		return;
+
+	if (s_rewinding.load(std::memory_order_acquire) && s_rewind_head_valid)
+		DoRewind();
+	else
+		SaveRewindState();
+}
+
+void VMManager::SaveRewindState()
+{
+	{
+		// If the worker is still compressing the last delta, try again next frame. We can't touch
+		// either buffer until it's done, and stalling the CPU thread defeats the point.
+		std::unique_lock lock(s_rewind_mutex);
+		if (s_rewind_job_newer)
+			return;
+	}
+
+	Common::Timer timer;
+
+	Error error;
+	if (!SaveState_DownloadState(s_rewind_spare.get(), &error))
+	{
+		Console.Error(fmt::format("Failed to save rewind state: {}", error.GetDescription()));
+		return;
+	}
+
+	std::swap(s_rewind_head, s_rewind_spare);
+	s_rewind_save_counter = s_rewind_save_frequency - 1;
+	s_rewind_head_loaded = false;
+
+	{
+		std::unique_lock lock(s_rewind_mutex);
+		s_rewind_states_size = s_rewind_head->GetBuffer().capacity() + s_rewind_spare->GetBuffer().capacity();
+		if (s_rewind_head_valid)
+		{
+			s_rewind_job_older = s_rewind_spare.get();
+			s_rewind_job_newer = s_rewind_head.get();
+			s_rewind_cv.notify_one();
+		}
+	}
+
+	s_rewind_head_valid = true;
+	PerformanceMetrics::OnMemorySaveStateSaved(static_cast<float>(timer.GetTimeMilliseconds()));
+}
+
+void VMManager::DoRewind()
+{
+	WaitForRewindThread();
+
+	Common::Timer timer;
+
+	// The first step goes back to the newest state, after that we walk back through the deltas.
+	// Once we run out of deltas, we stay on the oldest state.
+	if (s_rewind_head_loaded && !s_rewind_deltas.empty())
+	{
+		RewindDelta delta;
+		{
+			std::unique_lock lock(s_rewind_mutex);
+			delta = std::move(s_rewind_deltas.back());
+			s_rewind_deltas.pop_back();
+			s_rewind_deltas_size -= delta.data.size();
+		}
+
+		if (s_rewind_decompress_buffer.size() < delta.uncompressed_size)
+			s_rewind_decompress_buffer.resize(delta.uncompressed_size);
+
+		const size_t decompressed_size = ZSTD_decompress(
+			s_rewind_decompress_buffer.data(), delta.uncompressed_size, delta.data.data(), delta.data.size());
+		if (ZSTD_isError(decompressed_size) || decompressed_size != delta.uncompressed_size ||
+			delta.layout.size() != s_rewind_head->GetLength())
+		{
+			Console.Error("Rewind delta is corrupted, clearing rewind buffer.");
+			ClearRewindStates();
+			return;
+		}
+
+		ArchiveEntryList& head = *s_rewind_head;
+		const size_t current_size = GetRewindStateSize(head);
+		for (size_t i = 0; i < delta.layout.size(); i++)
+		{
+			head[static_cast<uint>(i)]
+				.SetDataIndex(delta.layout[i].first)
+				.SetDataSize(delta.layout[i].second);
+		}
+
+		const size_t older_size = GetRewindStateSize(head);
+		PadRewindStateBuffer(head, current_size,
+			Common::AlignUpPow2(std::max(current_size, older_size), REWIND_PAGE_SIZE));
+
+		const u8* ptr = s_rewind_decompress_buffer.data();
+		for (;;)
+		{
+			u32 page;
+			std::memcpy(&page, ptr, sizeof(page));
+			ptr += sizeof(page);
+			if (page == REWIND_DELTA_END)
+				break;
+
+			u8* dst = head.GetPtr(page * REWIND_PAGE_SIZE);
+			for (u32 i = 0; i < REWIND_PAGE_SIZE; i += sizeof(u64))
+			{
+				u64 a, b;
+				std::memcpy(&a, dst + i, sizeof(a));
+				std::memcpy(&b, ptr + i, sizeof(b));
+				a ^= b;
+				std::memcpy(dst + i, &a, sizeof(a));
+			}
+
+			ptr += REWIND_PAGE_SIZE;
+		}
+	}
+
+	Error error;
+	if (!SaveState_LoadFromMemory(*s_rewind_head, &error))
+	{
+		Console.Error(fmt::format("Failed to load rewind state: {}", error.GetDescription()));
+		ClearRewindStates();
+		return;
+	}
+
+	s_rewind_head_loaded = true;
+	s_rewind_save_counter = s_rewind_save_frequency - 1;
+	PerformanceMetrics::OnMemorySaveStateLoaded(static_cast<float>(timer.GetTimeMilliseconds()));
+}
+
+void VMManager::WaitForRewindThread()
+{
+	std::unique_lock lock(s_rewind_mutex);
+	s_rewind_cv.wait(lock, []() { return (s_rewind_job_newer == nullptr); });
+}
+
+void VMManager::RewindThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Rewind Compression");
+
+	ZSTD_CCtx* cctx = ZSTD_createCCtx();
+	std::vector<u8> delta_buffer;
+
+	std::unique_lock lock(s_rewind_mutex);
+	for (;;)
+	{
+		s_rewind_cv.wait(lock, []() { return (s_rewind_thread_shutdown || s_rewind_job_newer); });
+		if (s_rewind_thread_shutdown)
+			break;
+
+		ArchiveEntryList& older = *s_rewind_job_older;
+		ArchiveEntryList& newer = *s_rewind_job_newer;
+		lock.unlock();
+
+		// Only pages which differ between the two states get written, as the XOR of both.
+		// Applying the delta to the newer state gives back the older one.
+		const size_t older_size = GetRewindStateSize(older);
+		const size_t newer_size = GetRewindStateSize(newer);
+		const size_t padded_size = Common::AlignUpPow2(std::max(older_size, newer_size), REWIND_PAGE_SIZE);
+		PadRewindStateBuffer(older, older_size, padded_size);
+		PadRewindStateBuffer(newer, newer_size, padded_size);
+
+		const u32 num_pages = static_cast<u32>(Common::AlignUpPow2(older_size, REWIND_PAGE_SIZE) / REWIND_PAGE_SIZE);
+		delta_buffer.clear();
+		for (u32 page = 0; page < num_pages; page++)
+		{
+			const u8* older_page = older.GetPtr(page * REWIND_PAGE_SIZE);
+			const u8* newer_page = newer.GetPtr(page * REWIND_PAGE_SIZE);
+			if (std::memcmp(older_page, newer_page, REWIND_PAGE_SIZE) == 0)
+				continue;
+
+			const size_t pos = delta_buffer.size();
+			delta_buffer.resize(pos + sizeof(page) + REWIND_PAGE_SIZE);
+			std::memcpy(&delta_buffer[pos], &page, sizeof(page));
+			u8* dst = &delta_buffer[pos + sizeof(page)];
+			for (u32 i = 0; i < REWIND_PAGE_SIZE; i += sizeof(u64))
+			{
+				u64 a, b;
+				std::memcpy(&a, older_page + i, sizeof(a));
+				std::memcpy(&b, newer_page + i, sizeof(b));
+				a ^= b;
+				std::memcpy(dst + i, &a, sizeof(a));
+			}
+		}
+		delta_buffer.resize(delta_buffer.size() + sizeof(REWIND_DELTA_END));
+		std::memcpy(&delta_buffer[delta_buffer.size() - sizeof(REWIND_DELTA_END)], &REWIND_DELTA_END,
+			sizeof(REWIND_DELTA_END));
+
+		RewindDelta delta;
+		delta.layout.reserve(older.GetLength());
+		for (size_t i = 0; i < older.GetLength(); i++)
+		{
+			const ArchiveEntry& entry = older[static_cast<uint>(i)];
+			delta.layout.emplace_back(static_cast<u32>(entry.GetDataIndex()), static_cast<u32>(entry.GetDataSize()));
+		}
+
+		// Most of the state is unchanged zero bytes after the XOR, so the fastest level is plenty.
+		delta.uncompressed_size = static_cast<u32>(delta_buffer.size());
+		delta.data.resize(ZSTD_compressBound(delta_buffer.size()));
+		const size_t compressed_size =
+			ZSTD_compressCCtx(cctx, delta.data.data(), delta.data.size(), delta_buffer.data(), delta_buffer.size(), 1);
+
+		lock.lock();
+
+		// Padding may have grown either buffer.
+		s_rewind_states_size = older.GetBuffer().capacity() + newer.GetBuffer().capacity();
+
+		if (ZSTD_isError(compressed_size))
+		{
+			// Without this delta the chain is broken, so the older states are unreachable.
+			Console.Error(fmt::format("Failed to compress rewind state: {}", ZSTD_getErrorName(compressed_size)));
+			s_rewind_deltas.clear();
+			s_rewind_deltas_size = 0;
+		}
+		else
+		{
+			delta.data.resize(compressed_size);
+			delta.data.shrink_to_fit();
+			s_rewind_deltas_size += delta.data.size();
+			s_rewind_deltas.push_back(std::move(delta));
+
+			while ((s_rewind_deltas_size + s_rewind_states_size) > s_rewind_buffer_budget && !s_rewind_deltas.empty())
+			{
+				s_rewind_deltas_size -= s_rewind_deltas.front().data.size();
+				s_rewind_deltas.pop_front();
+			}
+		}
+
+		s_rewind_job_older = nullptr;
+		s_rewind_job_newer = nullptr;
+		s_rewind_cv.notify_all();
+	}
+
+	ZSTD_freeCCtx(cctx);
+}
+
+u32 VMManager::GetRunaheadFrameCount()
+{
+	return s_runahead_frames;
+}
+
+bool VMManager::Internal::IsReplayingRunaheadFrames()
+{
+	return (s_runahead_replay_frames > 0);
+}
+
+void VMManager::Internal::SetRunaheadReplayPending()
+{
+	s_runahead_replay_pending = true;
+}
+
+void VMManager::UpdateRunaheadState()
+{
+	// Input recordings count frames, replaying them would throw the recording out of sync.
+	const u32 frames = (HasValidVM() && !GSDumpReplayer::IsReplayingDump() && !EmuConfig.EnableRecordingTools) ?
+						   EmuConfig.Savestate.RunaheadFrameCount :
+						   0;
+	if (frames == s_runahead_frames)
+		return;
+
+	ClearRunaheadStates();
+	s_runahead_frames = frames;
+
+	if (frames == 0)
+	{
+		s_runahead_free_states.clear();
+		return;
+	}
+
+	Console.WriteLn(fmt::format("Run-ahead enabled, running {} frames ahead.", frames));
+}
+
+void VMManager::ClearRunaheadStates()
+{
+	while (!s_runahead_states.empty())
+	{
+		s_runahead_free_states.push_back(std::move(s_runahead_states.front()));
+		s_runahead_states.pop_front();
+	}
+
+	if (s_runahead_replay_frames > 0)
+	{
+		s_runahead_replay_frames = 0;
+		SPU2::SetOutputMuted(false);
+	}
+
+	s_runahead_replay_pending = false;
+	s_memory_states_pending = false;
+}
+
+void VMManager::ProcessRunaheadOnCPUThread()
+{
+	if (s_runahead_frames == 0)
+		return;
+
+	if (s_runahead_replay_frames > 0)
+		PerformanceMetrics::OnRunaheadFrame(static_cast<float>(s_runahead_frame_timer.GetTimeMillisecondsAndReset()));
+
+	if (s_runahead_replay_pending && !s_runahead_states.empty())
+	{
+		s_runahead_replay_pending = false;
+
+		Common::Timer load_timer;
+		Error error;
+		if (!SaveState_LoadFromMemory(*s_runahead_states.front(), &error))
+		{
+			Console.Error(fmt::format("Failed to load run-ahead state: {}", error.GetDescription()));
+			ClearRunaheadStates();
+			return;
+		}
+
+		PerformanceMetrics::OnMemorySaveStateLoaded(static_cast<float>(load_timer.GetTimeMilliseconds()));
+
+		// Catch back up to where we were, with the new input applied. None of these frames are
+		// presented or throttled, and their audio has already been played, so it's thrown away.
+		s_runahead_replay_frames = static_cast<u32>(s_runahead_states.size());
+		while (!s_runahead_states.empty())
+		{
+			s_runahead_free_states.push_back(std::move(s_runahead_states.front()));
+			s_runahead_states.pop_front();
+		}
+
+		SPU2::SetOutputMuted(true);
+		s_runahead_frame_timer.Reset();
+		return;
+	}
+
+	s_runahead_replay_pending = false;
+
+	// Keep one state per frame, the oldest is where we'll roll back to.
+	Common::Timer save_timer;
+	std::unique_ptr<ArchiveEntryList> state;
+	if (s_runahead_states.size() >= s_runahead_frames)
+	{
+		state = std::move(s_runahead_states.front());
+		s_runahead_states.pop_front();
+	}
+	else if (!s_runahead_free_states.empty())
+	{
+		state = std::move(s_runahead_free_states.back());
+		s_runahead_free_states.pop_back();
+	}
+	else
+	{
+		state = std::make_unique<ArchiveEntryList>();
+	}
+
+	Error error;
+	if (SaveState_DownloadState(state.get(), &error))
+	{
+		s_runahead_states.push_back(std::move(state));
+		PerformanceMetrics::OnMemorySaveStateSaved(static_cast<float>(save_timer.GetTimeMilliseconds()));
+	}
+	else
+	{
+		Console.Error(fmt::format("Failed to save run-ahead state: {}", error.GetDescription()));
+		s_runahead_free_states.push_back(std::move(state));
+	}
+
+	if (s_runahead_replay_frames > 0 && --s_runahead_replay_frames == 0)
+		SPU2::SetOutputMuted(false);
+}
+
 LimiterModeType VMManager::GetLimiterMode()
 {
 	return s_limiter_mode;
@@ -2158,7 +2727,8 @@ void VMManager::ResetFrameLimiter()
 
 void VMManager::Internal::Throttle()
 {
-	if (s_target_speed == 0.0f || s_use_vsync_for_timing)
+	// Replayed run-ahead frames have to complete within the time of the frame which triggered the replay.
+	if (s_target_speed == 0.0f || s_use_vsync_for_timing || s_runahead_replay_frames > 0)
 		return;
 
 	const u64 uExpectedEnd =
@@ -2635,6 +3205,14 @@ void VMManager::Execute()
 		vtlb_ResetFastmem();
 	}
 
+	// Rewind and run-ahead states are saved and loaded here rather than at vsync, so the counters aren't
+	// left half-updated. Rolling back for run-ahead replays from this point as well.
+	if (std::exchange(s_memory_states_pending, false))
+	{
+		ProcessRunaheadOnCPUThread();
+		ProcessRewindOnCPUThread();
+	}
+
 	// Execute until we're asked to stop.
 	Cpu->Execute();
 }
@@ -2725,7 +3303,8 @@ const std::string& VMManager::Internal::GetELFOverride()
 
 bool VMManager::Internal::IsExecutionInterrupted()
 {
-	return s_state.load(std::memory_order_relaxed) != VMState::Running || s_cpu_implementation_changed;
+	return s_state.load(std::memory_order_relaxed) != VMState::Running || s_cpu_implementation_changed ||
+		   s_memory_states_pending;
 }
 
 void VMManager::Internal::ELFLoadingOnCPUThread(std::string elf_path)
@@ -2819,6 +3398,13 @@ void VMManager::Internal::PollInputOnCPUThread()
 		// so we can either read from it, or overwrite it!
 		g_InputRecording.handleControllerDataUpdate();
 	}
+
+	// Loading a state in the middle of the vsync event would leave it running against the new state.
+	// VSyncStart() leaves the CPU loop once it's done, and Execute() handles the state before resuming.
+	if (s_runahead_frames > 0)
+		s_memory_states_pending = true;
+	if (CountRewindFrame())
+		s_memory_states_pending = true;
 }
 
 void VMManager::CheckForCPUConfigChanges(const Pcsx2Config& old_config)
@@ -2976,6 +3562,13 @@ void VMManager::CheckForMiscConfigChanges(const Pcsx2Config& old_config)
 			ShutdownDiscordPresence();
 	}
 
+	if (HasValidVM() &&
+		(EmuConfig.Savestate != old_config.Savestate || EmuConfig.EnableRecordingTools != old_config.EnableRecordingTools))
+	{
+		UpdateRewindState();
+		UpdateRunaheadState();
+	}
+
 	if (HasValidVM() && (EmuConfig.EnableThreadPinning != old_config.EnableThreadPinning ||
 							(s_thread_affinities_set && EmuConfig.Speedhacks.vuThread != old_config.Speedhacks.vuThread)))
 	{
@@ -3054,6 +3647,10 @@ void VMManager::EnforceAchievementsChallengeModeSettings()
 	EmuConfig.EnableRecordingTools = false;
 	EmuConfig.EnablePINE = false;
 
+	// Rewinding and run-ahead are loading state.
+	EmuConfig.Savestate.RewindEnable = false;
+	EmuConfig.Savestate.RunaheadFrameCount = 0;
+
 	// Framerates should be at default.
 	EmuConfig.GS.FramerateNTSC = Pcsx2Config::GSOptions::DEFAULT_FRAME_RATE_NTSC;
 	EmuConfig.GS.FrameratePAL = Pcsx2Config::GSOptions::DEFAULT_FRAME_RATE_PAL;
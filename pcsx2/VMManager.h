@@ -143,6 +143,22 @@ namespace VMManager
 	/// Removes all save states for the specified serial and crc. Returns the number of files deleted.
 	u32 DeleteSaveStates(const char* game_serial, u32 game_crc, bool also_backups = true);
 
+	/// Returns true if the rewind buffer is active for the running VM.
+	bool IsRewindEnabled();
+
+	/// Starts or stops stepping backwards through the rewind buffer. One state is restored per frame.
+	void SetRewinding(bool rewinding);
+
+	/// Returns true if the VM is currently rewinding.
+	bool IsRewinding();
+
+	/// Returns the number of states which can currently be rewound to, and the memory they occupy.
+	u32 GetRewindStateCount();
+	size_t GetRewindMemoryUsage();
+
+	/// Returns the number of frames run-ahead is speculatively executing, or zero if it is disabled.
+	u32 GetRunaheadFrameCount();
+
 	/// Returns the current limiter mode.
 	LimiterModeType GetLimiterMode();
 
@@ -290,6 +306,12 @@ namespace VMManager
 		void EntryPointCompilingOnCPUThread();
 		void VSyncOnCPUThread();
 		void PollInputOnCPUThread();
+
+		/// Returns true if the current frame is being replayed by run-ahead, and shouldn't be presented.
+		bool IsReplayingRunaheadFrames();
+
+		/// Called when controller input changes, the run-ahead frames are replayed with the new input.
+		void SetRunaheadReplayPending();
 	} // namespace Internal
 } // namespace VMManager
 
@@ -33,9 +33,15 @@
 #include "Zycore/Status.h"
 #endif
 
-#ifdef TRACE_BLOCKS
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Timer.h"
+
+#include "fmt/core.h"
+
+#include <deque>
+#include <map>
 #include <zlib.h>
-#endif
 
 using namespace x86Emitter;
 using namespace R5900;
@@ -44,6 +50,7 @@ static bool eeRecNeedsReset = false;
 static bool eeCpuExecuting = false;
 static bool eeRecExitRequested = false;
 static bool g_resetEeScalingStats = false;
+static bool s_block_profile_enabled = false;
 
 #define PC_GETBLOCK(x) PC_GETBLOCK_(x, recLUT)
 
@@ -344,6 +351,10 @@ void recCall(void (*func)())
 // =====================================================================================================
 
 static void recRecompile(const u32 startpc);
+static void recResetBlockCache(bool buffer_full);
+static void recSaveBlockCache();
+static void recBlockProfileResume();
+static void recDumpBlockProfile();
 static void dyna_block_discard(u32 start, u32 sz);
 static void dyna_page_reset(u32 start, u32 sz);
 
@@ -583,7 +594,12 @@ static void recResetRaw()
 		extraRam = !extraRam;
 	}
 
+	// Checked before recPtr is rewound below.
+	const bool buffer_full = (recPtr >= recPtrEnd);
+
 	EE::Profiler.Reset();
+	recDumpBlockProfile();
+	s_block_profile_enabled = (EmuConfig.Profiler.Enabled && EmuConfig.Profiler.RecBlocks_EE);
 
 	xSetPtr(SysMemory::GetEERec());
 	_DynGen_Dispatchers();
@@ -600,6 +616,7 @@ static void recResetRaw()
 
 	recBlocks.Reset();
 	vtlb_ClearLoadStoreInfo();
+	recResetBlockCache(buffer_full);
 
 	g_branch = 0;
 	g_resetEeScalingStats = true;
@@ -607,6 +624,9 @@ static void recResetRaw()
 
 void recShutdown()
 {
+	recSaveBlockCache();
+	recDumpBlockProfile();
+
 	recRAMCopy.deallocate();
 	recLutReserve_RAM.deallocate();
 
@@ -690,6 +710,9 @@ static void recExecute()
 	// but will return the longjmp 2nd parameter (here 1)
 	if (!fastjmp_set(&m_SetJmp_StateCheck))
 	{
+		if (s_block_profile_enabled)
+			recBlockProfileResume();
+
 		eeCpuExecuting = true;
 		((void (*)())EnterRecompiledCode)();
 
@@ -2171,6 +2194,342 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 	return true;
 }
 
+////////////////////////////////////////////////////
+// Block profiler
+//
+// When enabled, every block starts with a call which bumps its execution count, and charges the
+// host time since the previous block started to that block. Note that this includes any event
+// handling done on the way, e.g. IOP execution. Blocks compiled with it disabled carry no
+// instrumentation at all.
+
+struct BlockProfile
+{
+	u64 count;
+	u64 ticks;
+	u32 startpc;
+	u32 size; // in instructions
+};
+
+// Deque, since compiled blocks point directly at their entry.
+static std::deque<BlockProfile> s_block_profiles;
+static BlockProfile s_block_profile_none = {};
+static BlockProfile* s_block_profile_current = &s_block_profile_none;
+static Common::Timer::Value s_block_profile_last_time = 0;
+
+static void recBlockProfileEnter(BlockProfile* profile)
+{
+	const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
+	s_block_profile_current->ticks += current_time - s_block_profile_last_time;
+	s_block_profile_current = profile;
+	s_block_profile_last_time = current_time;
+	profile->count++;
+}
+
+static void recBlockProfileResume()
+{
+	// Don't charge whatever happened outside of execution to the last block.
+	s_block_profile_current = &s_block_profile_none;
+	s_block_profile_last_time = Common::Timer::GetCurrentValue();
+}
+
+static void recDumpBlockProfile()
+{
+	if (s_block_profiles.empty())
+		return;
+
+	// Blocks can be compiled multiple times, so merge anything covering the same range.
+	std::map<std::pair<u32, u32>, std::pair<u64, u64>> ranges;
+	u64 total_ticks = 0;
+	for (const BlockProfile& profile : s_block_profiles)
+	{
+		auto& range = ranges[std::make_pair(profile.startpc, profile.size)];
+		range.first += profile.count;
+		range.second += profile.ticks;
+		total_ticks += profile.ticks;
+	}
+
+	std::vector<std::pair<std::pair<u32, u32>, std::pair<u64, u64>>> sorted(ranges.begin(), ranges.end());
+	std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.second.second > rhs.second.second; });
+
+	const std::string path = Path::Combine(EmuFolders::Logs, "ee_block_profile.txt");
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "ab");
+	if (fp)
+	{
+		std::fprintf(fp.get(), "EE block profile: %zu blocks, %.3f ms\n", sorted.size(),
+			Common::Timer::ConvertValueToMilliseconds(total_ticks));
+		std::fprintf(fp.get(), "%-17s %16s %12s %8s %10s\n", "Range", "Executions", "Time (ms)", "Time", "ns/exec");
+	}
+
+	Console.WriteLn(Color_StrongBlack, "EE block profile (top 20 of %zu blocks, full report in %s):", sorted.size(), path.c_str());
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		const auto& [range, stats] = sorted[i];
+		const double ms = Common::Timer::ConvertValueToMilliseconds(stats.second);
+		const double percent = total_ticks ? (static_cast<double>(stats.second) * 100.0 / static_cast<double>(total_ticks)) : 0.0;
+		const double ns_per_exec = stats.first ? (ms * 1000000.0 / static_cast<double>(stats.first)) : 0.0;
+		const u32 endpc = range.first + range.second * 4;
+		if (fp)
+		{
+			std::fprintf(fp.get(), "%08X-%08X %16" PRIu64 " %12.3f %7.2f%% %10.1f\n", range.first, endpc, stats.first, ms,
+				percent, ns_per_exec);
+		}
+		if (i < 20)
+			Console.WriteLn("  %08X-%08X %12" PRIu64 " execs %10.3f ms %6.2f%%", range.first, endpc, stats.first, ms, percent);
+	}
+
+	if (fp)
+		std::fputc('\n', fp.get());
+
+	s_block_profiles.clear();
+	s_block_profile_current = &s_block_profile_none;
+}
+
+////////////////////////////////////////////////////
+// Persistent block cache
+//
+// Compiled blocks can't be written out as-is, since they're full of absolute pointers into
+// host memory (cpuRegs, vtlb, the dispatchers and other blocks). Instead, we remember which
+// blocks were compiled for each disc along with a hash of their guest code, and compile any
+// whose code matches up front the next time around. They still go through recRecompile(), so
+// recRAMCopy and page protection treat them like any other block. The list is written out when
+// the disc or settings change, and on shutdown.
+
+static constexpr u32 BLOCK_CACHE_MAGIC = 0x43424545; // EEBC
+static constexpr u32 BLOCK_CACHE_VERSION = 1;
+static constexpr u32 BLOCK_CACHE_MAX_ENTRIES = 256 * 1024;
+
+struct BlockCacheHeader
+{
+	u32 magic;
+	u32 version;
+	u32 config_hash;
+	u32 num_entries;
+};
+
+struct BlockCacheEntry
+{
+	u32 startpc;
+	u32 size; // in instructions
+	u32 hash;
+};
+
+// Keyed by startpc and hash, so overlays at the same address can all be kept.
+static std::unordered_map<u64, BlockCacheEntry> s_block_cache_entries;
+static std::vector<BlockCacheEntry> s_block_cache_pending;
+static std::string s_block_cache_path;
+static u32 s_block_cache_config_hash = 0;
+static bool s_block_cache_dirty = false;
+static bool s_block_cache_preload = false;
+static bool s_block_cache_preloading = false;
+static u32 s_block_cache_hits = 0;
+static u32 s_block_cache_misses = 0;
+
+static bool recGetBlockCacheHash(u32 startpc, u32 size, u32* hash)
+{
+	// A block can run into the next page, which isn't necessarily mapped, or next to this one in host memory.
+	u32 crc = 0;
+	u32 pc = startpc;
+	u32 remaining = size * 4;
+	while (remaining > 0)
+	{
+		const u8* ptr = static_cast<const u8*>(PSM(pc));
+		if (!ptr)
+			return false;
+
+		const u32 len = std::min(remaining, vtlb_private::VTLB_PAGE_SIZE - (pc & vtlb_private::VTLB_PAGE_MASK));
+		crc = crc32(crc, ptr, len);
+		pc += len;
+		remaining -= len;
+	}
+
+	*hash = crc;
+	return true;
+}
+
+static u32 recGetBlockCacheConfigHash()
+{
+	// Anything which changes the code we generate for a given block.
+	const u32 config[] = {
+		BLOCK_CACHE_VERSION,
+		EmuConfig.Cpu.bitset,
+		EmuConfig.Cpu.Recompiler.bitset,
+		EmuConfig.Cpu.FPUFPCR.bitmask,
+		EmuConfig.Cpu.FPUDivFPCR.bitmask,
+		EmuConfig.Gamefixes.bitset,
+		EmuConfig.Speedhacks.bitset,
+		static_cast<u32>(EmuConfig.Speedhacks.EECycleRate),
+		EmuConfig.Speedhacks.EECycleSkip,
+	};
+	return crc32(0, reinterpret_cast<const Bytef*>(config), sizeof(config));
+}
+
+static void recSaveBlockCache()
+{
+	if (!s_block_cache_dirty || s_block_cache_path.empty())
+		return;
+
+	s_block_cache_dirty = false;
+	Console.WriteLn("EE block cache: %u blocks preloaded, %u compiled on demand, %zu known",
+		s_block_cache_hits, s_block_cache_misses, s_block_cache_entries.size());
+
+	auto fp = FileSystem::OpenManagedCFile(s_block_cache_path.c_str(), "wb");
+	if (!fp)
+	{
+		Console.Error("Failed to open '%s' for writing.", s_block_cache_path.c_str());
+		return;
+	}
+
+	std::vector<BlockCacheEntry> entries;
+	entries.reserve(s_block_cache_entries.size());
+	for (const auto& it : s_block_cache_entries)
+		entries.push_back(it.second);
+
+	const BlockCacheHeader header = {BLOCK_CACHE_MAGIC, BLOCK_CACHE_VERSION, s_block_cache_config_hash,
+		static_cast<u32>(entries.size())};
+	if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+		(!entries.empty() && std::fwrite(entries.data(), sizeof(BlockCacheEntry), entries.size(), fp.get()) != entries.size()))
+	{
+		Console.Error("Failed to write EE block cache to '%s'.", s_block_cache_path.c_str());
+	}
+}
+
+static void recLoadBlockCache(const std::string& path, u32 config_hash)
+{
+	s_block_cache_entries.clear();
+	s_block_cache_path = path;
+	s_block_cache_config_hash = config_hash;
+	s_block_cache_hits = 0;
+	s_block_cache_misses = 0;
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "rb");
+	if (!fp)
+		return;
+
+	BlockCacheHeader header;
+	if (std::fread(&header, sizeof(header), 1, fp.get()) != 1 || header.magic != BLOCK_CACHE_MAGIC ||
+		header.version != BLOCK_CACHE_VERSION || header.config_hash != config_hash ||
+		header.num_entries > BLOCK_CACHE_MAX_ENTRIES)
+	{
+		DevCon.WriteLn("EE block cache '%s' is outdated, ignoring.", path.c_str());
+		return;
+	}
+
+	std::vector<BlockCacheEntry> entries(header.num_entries);
+	if (!entries.empty() && std::fread(entries.data(), sizeof(BlockCacheEntry), entries.size(), fp.get()) != entries.size())
+	{
+		Console.Error("EE block cache '%s' is truncated, ignoring.", path.c_str());
+		return;
+	}
+
+	for (const BlockCacheEntry& entry : entries)
+	{
+		if (entry.size > 0 && entry.size <= 0xffff)
+			s_block_cache_entries.emplace((static_cast<u64>(entry.startpc) << 32) | entry.hash, entry);
+	}
+
+	DevCon.WriteLn("EE block cache: loaded %zu blocks from '%s'", s_block_cache_entries.size(), path.c_str());
+}
+
+static void recResetBlockCache(bool buffer_full)
+{
+	s_block_cache_pending.clear();
+	s_block_cache_preload = false;
+
+	if (!EmuConfig.Cpu.Recompiler.EnableEEBlockCache)
+	{
+		recSaveBlockCache();
+		s_block_cache_entries.clear();
+		s_block_cache_path = {};
+		return;
+	}
+
+	const std::string path = Path::Combine(EmuFolders::Cache, fmt::format("eerec_{:08X}.bin", VMManager::GetDiscCRC()));
+	const u32 config_hash = recGetBlockCacheConfigHash();
+	if (path != s_block_cache_path || config_hash != s_block_cache_config_hash)
+	{
+		recSaveBlockCache();
+		recLoadBlockCache(path, config_hash);
+	}
+
+	// The code buffer filled up with what the game is running now. Preloading everything we've ever seen would
+	// only fill it up again, so leave it to blocks to be compiled as they're needed.
+	if (buffer_full)
+		return;
+
+	// Everything's been flushed, so all known blocks are candidates again.
+	s_block_cache_pending.reserve(s_block_cache_entries.size());
+	for (const auto& it : s_block_cache_entries)
+		s_block_cache_pending.push_back(it.second);
+	std::sort(s_block_cache_pending.begin(), s_block_cache_pending.end(),
+		[](const BlockCacheEntry& lhs, const BlockCacheEntry& rhs) { return lhs.startpc < rhs.startpc; });
+	s_block_cache_preload = !s_block_cache_pending.empty();
+}
+
+static void recPreloadBlockCache(u32 current_startpc)
+{
+	s_block_cache_preload = false;
+
+	Common::Timer timer;
+	const u8* preload_limit = SysMemory::GetEERec() + (recPtrEnd - SysMemory::GetEERec()) / 2;
+	const u32 entry_point = VMManager::Internal::GetCurrentELFEntryPoint();
+	u32 count = 0;
+
+	s_block_cache_preloading = true;
+	size_t out = 0;
+	for (size_t i = 0; i < s_block_cache_pending.size(); i++)
+	{
+		const BlockCacheEntry& entry = s_block_cache_pending[i];
+
+		// Leave some room for blocks which aren't cached, so we don't end up resetting straight away.
+		// Compiling the entry point kicks off ELF load handling, and the current block is next anyway.
+		bool keep = (recPtr >= preload_limit || entry.startpc == current_startpc || HWADDR(entry.startpc) == entry_point);
+		if (!keep)
+		{
+			// Skip anything which has already been compiled, or where the code isn't there (yet).
+			const uptr fnptr = PC_GETBLOCK(entry.startpc)->GetFnptr();
+			if (fnptr == (uptr)JITCompile || fnptr == (uptr)JITCompileInBlock)
+			{
+				u32 hash;
+				if (recGetBlockCacheHash(entry.startpc, entry.size, &hash) && hash == entry.hash)
+				{
+					recRecompile(entry.startpc);
+					count++;
+				}
+				else
+				{
+					keep = true;
+				}
+			}
+		}
+
+		if (keep)
+			s_block_cache_pending[out++] = entry;
+	}
+	s_block_cache_pending.resize(out);
+	s_block_cache_preloading = false;
+
+	s_block_cache_hits += count;
+	if (count > 0)
+		DevCon.WriteLn("EE block cache: preloaded %u blocks in %.2f ms", count, timer.GetTimeMilliseconds());
+}
+
+static void recAddToBlockCache(u32 startpc, u32 size)
+{
+	if (s_block_cache_path.empty() || s_block_cache_preloading)
+		return;
+
+	s_block_cache_misses++;
+	if (s_block_cache_entries.size() >= BLOCK_CACHE_MAX_ENTRIES)
+		return;
+
+	u32 hash;
+	if (!recGetBlockCacheHash(startpc, size, &hash))
+		return;
+
+	s_block_cache_dirty |= s_block_cache_entries.try_emplace((static_cast<u64>(startpc) << 32) | hash,
+		BlockCacheEntry{startpc, size, hash}).second;
+}
+
 static void recRecompile(const u32 startpc)
 {
 	u32 i = 0;
@@ -2191,6 +2550,9 @@ static void recRecompile(const u32 startpc)
 		recResetRaw();
 	}
 
+	if (s_block_cache_preload)
+		recPreloadBlockCache(startpc);
+
 	xSetPtr(recPtr);
 	recPtr = xGetAlignedCallTarget();
 
@@ -2205,6 +2567,13 @@ static void recRecompile(const u32 startpc)
 
 	pxAssert(s_pCurBlockEx);
 
+	BlockProfile* profile = nullptr;
+	if (s_block_profile_enabled)
+	{
+		profile = &s_block_profiles.emplace_back(BlockProfile{0, 0, startpc, 0});
+		xFastCall((void*)recBlockProfileEnter, profile);
+	}
+
 	if (HWADDR(startpc) == EELOAD_START)
 	{
 		// The EELOAD _start function is the same across all BIOS versions
@@ -2715,6 +3084,9 @@ StartRecomp:
 	pxAssert(xGetPtr() < recPtrEnd);
 
 	s_pCurBlockEx->x86size = static_cast<u32>(xGetPtr() - recPtr);
+	recAddToBlockCache(startpc, s_pCurBlockEx->size);
+	if (profile)
+		profile->size = s_pCurBlockEx->size;
 
 #if 0
 	// Example: Dump both x86/EE code
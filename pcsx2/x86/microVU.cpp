@@ -2,10 +2,18 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "microVU.h"
+#include "VMManager.h"
 
 #include "common/AlignedMalloc.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
 #include "common/Perf.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
+
+#include "fmt/core.h"
+
+#include <unordered_map>
 
 //------------------------------------------------------------------
 // Micro VU - Main Functions
@@ -42,6 +50,8 @@ void mVUreset(microVU& mVU, bool resetReserve)
 		VU0.VI[REG_VPU_STAT].UL &= ~0x100;
 	}
 
+	mVUstoreProgCache(mVU);
+
 	xSetPtr(mVU.cache);
 	mVUdispatcherAB(mVU);
 	mVUdispatcherCD(mVU);
@@ -80,11 +90,18 @@ void mVUreset(microVU& mVU, bool resetReserve)
 		mVU.prog.quick[i].block = NULL;
 		mVU.prog.quick[i].prog = NULL;
 	}
+
+	// Only touch the disk cache on real resets, not when the program cache fills up
+	if (resetReserve)
+		mVUresetProgCache(mVU);
 }
 
 // Free Allocated Resources
 void mVUclose(microVU& mVU)
 {
+	mVUstoreProgCache(mVU);
+	mVUsaveProgCache(mVU);
+
 	// Delete Programs and Block Managers
 	for (u32 i = 0; i < (mVU.progSize / 2); i++)
 	{
@@ -301,6 +318,323 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 	return mVUentryGet(mVU, quick.block, startPC, pState);
 }
 
+//------------------------------------------------------------------
+// Micro VU - Persistent Program Cache
+//------------------------------------------------------------------
+// Compiled code is full of absolute pointers (VU regs, dispatchers, other blocks), so it can't
+// be written out directly. Instead, we keep the recompiled ranges of each microprogram and the
+// pipeline states of every block compiled for it, then recompile them all up front on the next
+// run, before the game gets a chance to stall on them.
+
+static constexpr u32 mVUprogCacheMagic   = 0x4350564D; // MVPC
+static constexpr u32 mVUprogCacheVersion = 1;
+
+struct alignas(16) mVUcachedBlock
+{
+	microRegInfo pState; // Needs to stay aligned for mVU.compareState()
+	u32 startPC;
+};
+
+struct mVUcachedProg
+{
+	u32 startPC;
+	std::vector<microRange> ranges;
+	std::vector<u8> data; // Contents of each range, back to back
+	std::vector<mVUcachedBlock> blocks;
+};
+
+struct mVUprogCache
+{
+	std::unordered_map<u64, mVUcachedProg> progs;
+	std::string path;
+	u32 configHash;
+	bool dirty;
+	u32 hits;
+	u32 misses;
+};
+
+static mVUprogCache mVUprogCaches[2];
+
+// Same as mVUrangesHash(), for a program which hasn't been compiled yet
+static u64 mVUcachedProgHash(const mVUcachedProg& cached)
+{
+	union
+	{
+		u64 v64;
+		u32 v32[2];
+	} hash = {0};
+
+	for (size_t i = 0; i < cached.data.size(); i += 4)
+	{
+		u32 value;
+		std::memcpy(&value, &cached.data[i], sizeof(value));
+		hash.v32[0] -= value;
+		hash.v32[1] ^= value;
+	}
+	return hash.v64 ^ (static_cast<u64>(cached.startPC) << 48);
+}
+
+static u32 mVUgetProgCacheConfigHash(microVU& mVU)
+{
+	// Anything which changes the code we generate for a given pipeline state.
+	const u32 config[] = {
+		mVUprogCacheVersion,
+		mVU.index,
+		EmuConfig.Cpu.Recompiler.bitset,
+		mVU.index ? EmuConfig.Cpu.VU1FPCR.bitmask : EmuConfig.Cpu.VU0FPCR.bitmask,
+		EmuConfig.Gamefixes.bitset,
+		EmuConfig.Speedhacks.bitset,
+		static_cast<u32>(THREAD_VU1),
+	};
+	u32 hash = 0;
+	for (const u32 value : config)
+		hash = (hash * 0x01000193) ^ value;
+	return hash;
+}
+
+// Stores the currently compiled programs in the cache, before they get thrown away
+void mVUstoreProgCache(microVU& mVU)
+{
+	mVUprogCache& cache = mVUprogCaches[mVU.index];
+	if (cache.path.empty())
+		return;
+
+	for (u32 i = 0; i < (mVU.progSize / 2); i++)
+	{
+		if (!mVU.prog.prog[i])
+			continue;
+
+		for (microProgram* prog : *mVU.prog.prog[i])
+		{
+			if (prog->ranges->empty())
+				continue;
+
+			auto it = cache.progs.try_emplace(mVUrangesHash(mVU, *prog) ^ (static_cast<u64>(prog->startPC) << 48));
+			mVUcachedProg& cached = it.first->second;
+			if (it.second)
+			{
+				cached.startPC = prog->startPC;
+				for (const microRange& range : *prog->ranges)
+				{
+					if (range.start < 0 || range.end <= range.start || range.end > static_cast<s32>(mVU.microMemSize))
+						continue;
+
+					cached.ranges.push_back(range);
+					cached.data.insert(cached.data.end(), reinterpret_cast<const u8*>(prog->data) + range.start,
+						reinterpret_cast<const u8*>(prog->data) + range.end);
+				}
+				cache.dirty = true;
+				cache.misses++;
+			}
+
+			for (u32 j = 0; j < (mVU.progSize / 2); j++)
+			{
+				if (!prog->block[j])
+					continue;
+
+				prog->block[j]->forEachBlock([&](const microBlock& block) {
+					for (const mVUcachedBlock& cblock : cached.blocks)
+					{
+						if (cblock.startPC == j * 8 && !std::memcmp(&cblock.pState, &block.pState, sizeof(microRegInfo)))
+							return;
+					}
+					mVUcachedBlock& cblock = cached.blocks.emplace_back();
+					cblock.pState = block.pState;
+					cblock.startPC = j * 8;
+					cache.dirty = true;
+				});
+			}
+		}
+	}
+}
+
+// Writes the program cache to disk, if anything has been added to it
+void mVUsaveProgCache(microVU& mVU)
+{
+	mVUprogCache& cache = mVUprogCaches[mVU.index];
+	if (!cache.dirty || cache.path.empty())
+		return;
+
+	cache.dirty = false;
+	Console.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: %u programs preloaded, %u compiled on demand, %zu cached",
+		mVU.index, cache.hits, cache.misses, cache.progs.size());
+
+	auto fp = FileSystem::OpenManagedCFile(cache.path.c_str(), "wb");
+	if (!fp)
+	{
+		Console.Error("microVU%d: Failed to open '%s' for writing.", mVU.index, cache.path.c_str());
+		return;
+	}
+
+	const u32 header[] = {mVUprogCacheMagic, mVUprogCacheVersion, cache.configHash, static_cast<u32>(cache.progs.size())};
+	bool result = (std::fwrite(header, sizeof(header), 1, fp.get()) == 1);
+	for (const auto& it : cache.progs)
+	{
+		const mVUcachedProg& cached = it.second;
+		const u32 progHeader[] = {cached.startPC, static_cast<u32>(cached.ranges.size()), static_cast<u32>(cached.blocks.size())};
+		result = result && (std::fwrite(progHeader, sizeof(progHeader), 1, fp.get()) == 1);
+		result = result && (std::fwrite(cached.ranges.data(), sizeof(microRange), cached.ranges.size(), fp.get()) == cached.ranges.size());
+		result = result && (std::fwrite(cached.data.data(), 1, cached.data.size(), fp.get()) == cached.data.size());
+		for (const mVUcachedBlock& block : cached.blocks)
+		{
+			result = result && (std::fwrite(&block.startPC, sizeof(block.startPC), 1, fp.get()) == 1) &&
+			         (std::fwrite(&block.pState, sizeof(block.pState), 1, fp.get()) == 1);
+		}
+	}
+
+	if (!result)
+		Console.Error("microVU%d: Failed to write program cache to '%s'.", mVU.index, cache.path.c_str());
+}
+
+static bool mVUreadProgCache(microVU& mVU, std::FILE* fp, u32 configHash)
+{
+	mVUprogCache& cache = mVUprogCaches[mVU.index];
+
+	u32 header[4];
+	if (std::fread(header, sizeof(header), 1, fp) != 1 || header[0] != mVUprogCacheMagic ||
+		header[1] != mVUprogCacheVersion || header[2] != configHash)
+	{
+		return false;
+	}
+
+	for (u32 i = 0; i < header[3]; i++)
+	{
+		u32 progHeader[3];
+		if (std::fread(progHeader, sizeof(progHeader), 1, fp) != 1 || progHeader[0] >= (mVU.progSize / 2) ||
+			progHeader[1] > mVU.microMemSize / 8 || progHeader[2] > 0x10000)
+		{
+			return false;
+		}
+
+		mVUcachedProg cached;
+		cached.startPC = progHeader[0];
+		cached.ranges.resize(progHeader[1]);
+		if (std::fread(cached.ranges.data(), sizeof(microRange), cached.ranges.size(), fp) != cached.ranges.size())
+			return false;
+
+		size_t dataSize = 0;
+		for (const microRange& range : cached.ranges)
+		{
+			if (range.start < 0 || range.end <= range.start || range.end > static_cast<s32>(mVU.microMemSize))
+				return false;
+			dataSize += range.end - range.start;
+		}
+
+		cached.data.resize(dataSize);
+		if (std::fread(cached.data.data(), 1, dataSize, fp) != dataSize)
+			return false;
+
+		cached.blocks.resize(progHeader[2]);
+		for (mVUcachedBlock& block : cached.blocks)
+		{
+			if (std::fread(&block.startPC, sizeof(block.startPC), 1, fp) != 1 ||
+				std::fread(&block.pState, sizeof(block.pState), 1, fp) != 1 ||
+				(block.startPC & 7) != 0 || block.startPC > mVU.microMemSize - 8)
+			{
+				return false;
+			}
+		}
+
+		const u64 key = mVUcachedProgHash(cached);
+		cache.progs.emplace(key, std::move(cached));
+	}
+
+	return true;
+}
+
+// Recompiles every cached program into the (freshly reset) program lists
+static void mVUpreloadProgCache(microVU& mVU)
+{
+	mVUprogCache& cache = mVUprogCaches[mVU.index];
+	if (cache.progs.empty())
+		return;
+
+	Common::Timer timer;
+
+	// Programs get compiled from micro memory, so swap in each cached program in turn.
+	const std::vector<u8> microBackup(mVU.regs().Micro, mVU.regs().Micro + mVU.microMemSize);
+	const u32 startPCBackup = mVU.regs().start_pc;
+
+	// Leave some room for programs which aren't cached, so we don't end up resetting straight away.
+	const u8* preloadLimit = mVU.prog.x86start + (mVU.prog.x86end - mVU.prog.x86start) / 2;
+	u32 count = 0;
+
+	xSetPtr(mVU.prog.x86ptr);
+	for (const auto& it : cache.progs)
+	{
+		if (xGetPtr() >= preloadLimit)
+			break;
+
+		const mVUcachedProg& cached = it.second;
+		std::memset(mVU.regs().Micro, 0, mVU.microMemSize);
+		const u8* data = cached.data.data();
+		for (const microRange& range : cached.ranges)
+		{
+			std::memcpy(mVU.regs().Micro + range.start, data, range.end - range.start);
+			data += range.end - range.start;
+		}
+
+		mVU.regs().start_pc = cached.startPC * 8;
+		mVU.prog.cleared = 0;
+		mVU.prog.isSame  = -1;
+		mVU.prog.cur     = mVUcreateProg(mVU, cached.startPC);
+		for (const mVUcachedBlock& block : cached.blocks)
+			mVUblockFetch(mVU, block.startPC, (uptr)&block.pState);
+
+		// Anything compiled this session takes priority in the search.
+		mVU.prog.prog[cached.startPC]->push_back(mVU.prog.cur);
+		count++;
+	}
+	mVU.prog.x86ptr = xGetPtr();
+
+	std::memcpy(mVU.regs().Micro, microBackup.data(), mVU.microMemSize);
+	mVU.regs().start_pc = startPCBackup;
+	std::memset(&mVU.prog.lpState, 0, sizeof(mVU.prog.lpState));
+	mVU.prog.cleared = 1;
+	mVU.prog.isSame  = -1;
+	mVU.prog.cur     = NULL;
+
+	cache.hits += count;
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Preloaded %u programs in %.2f ms",
+		mVU.index, count, timer.GetTimeMilliseconds());
+}
+
+// Flushes the program cache, switches to the cache for the current disc/settings, and preloads it
+void mVUresetProgCache(microVU& mVU)
+{
+	mVUprogCache& cache = mVUprogCaches[mVU.index];
+	mVUsaveProgCache(mVU);
+
+	if (!EmuConfig.Cpu.Recompiler.EnableVUProgramCache)
+	{
+		cache.progs.clear();
+		cache.path = {};
+		return;
+	}
+
+	const std::string path = Path::Combine(EmuFolders::Cache, fmt::format("mvu{}_{:08X}.bin", mVU.index, VMManager::GetDiscCRC()));
+	const u32 configHash = mVUgetProgCacheConfigHash(mVU);
+	if (path != cache.path || configHash != cache.configHash)
+	{
+		cache.progs.clear();
+		cache.path = path;
+		cache.configHash = configHash;
+		cache.hits = 0;
+		cache.misses = 0;
+
+		if (auto fp = FileSystem::OpenManagedCFile(path.c_str(), "rb"))
+		{
+			if (!mVUreadProgCache(mVU, fp.get(), configHash))
+			{
+				DevCon.WriteLn("microVU%d: Program cache '%s' is outdated, ignoring.", mVU.index, path.c_str());
+				cache.progs.clear();
+			}
+		}
+	}
+
+	mVUpreloadProgCache(mVU);
+}
+
 //------------------------------------------------------------------
 // recMicroVU0 / recMicroVU1
 //------------------------------------------------------------------
@@ -146,6 +146,14 @@ private:
 
 public:
 	inline int getFullListCount() const { return fListI; }
+	template <typename T>
+	void forEachBlock(const T& func) const
+	{
+		for (const microBlockLink* linkI = qBlockList; linkI != nullptr; linkI = linkI->next)
+			func(linkI->block);
+		for (const microBlockLink* linkI = fBlockList; linkI != nullptr; linkI = linkI->next)
+			func(linkI->block);
+	}
 	microBlockManager()
 	{
 		qListI = fListI = 0;
@@ -288,6 +296,9 @@ mVUop(mVUopL);
 // Private Functions
 extern void mVUcacheProg(microVU& mVU, microProgram& prog);
 extern void mVUdeleteProg(microVU& mVU, microProgram*& prog);
+extern void mVUstoreProgCache(microVU& mVU);
+extern void mVUsaveProgCache(microVU& mVU);
+extern void mVUresetProgCache(microVU& mVU);
 _mVUt extern void* mVUsearchProg(u32 startPC, uptr pState);
 extern void* mVUexecuteVU0(u32 startPC, u32 cycles);
 extern void* mVUexecuteVU1(u32 startPC, u32 cycles);
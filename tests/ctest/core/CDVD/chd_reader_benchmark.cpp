@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "chd_reader_tests.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
+
+// Decode throughput against a single libchdr handle, for tuning the worker count and hunk cache size.
+TEST_F(ChdFileReaderTest, Throughput)
+{
+	std::vector<u8> buffer(TEST_HUNK_SIZE);
+	const double total_mb = static_cast<double>(s_data.size()) / static_cast<double>(_1mb);
+
+	chd_file* chd;
+	ASSERT_EQ(chd_open(s_path.c_str(), CHD_OPEN_READ, nullptr, &chd), CHDERR_NONE);
+	Common::Timer timer;
+	for (u32 i = 0; i < TEST_HUNK_COUNT; i++)
+		ASSERT_EQ(chd_read(chd, i, buffer.data()), CHDERR_NONE);
+	const double single_time = timer.GetTimeSeconds();
+	chd_close(chd);
+
+	timer.Reset();
+	for (u32 i = 0; i < TEST_HUNK_COUNT; i++)
+		ASSERT_EQ(m_reader.ReadSync(buffer.data(), i, 1), static_cast<int>(TEST_HUNK_SIZE));
+	const double reader_time = timer.GetTimeSeconds();
+
+	fmt::print("CHD decode: single handle {:.1f} MB/s, ChdFileReader {:.1f} MB/s ({:.2f}x)\n", total_mb / single_time,
+		total_mb / reader_time, single_time / reader_time);
+}
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "chd_reader_tests.h"
+
+#include <algorithm>
+
+TEST_F(ChdFileReaderTest, SequentialRead)
+{
+	std::vector<u8> buffer(TEST_HUNK_SIZE);
+	for (u32 i = 0; i < TEST_HUNK_COUNT; i++)
+		ASSERT_TRUE(ReadHunk(i, buffer.data())) << "hunk " << i;
+}
+
+TEST_F(ChdFileReaderTest, RandomRead)
+{
+	// Short sequential runs from random positions, so prefetches get thrown away part way through.
+	std::vector<u8> buffer(TEST_HUNK_SIZE);
+	std::mt19937 rng(54321);
+	for (u32 run = 0; run < 256; run++)
+	{
+		const u32 start = rng() % TEST_HUNK_COUNT;
+		const u32 length = std::min<u32>(rng() % 16 + 1, TEST_HUNK_COUNT - start);
+		for (u32 i = start; i < start + length; i++)
+			ASSERT_TRUE(ReadHunk(i, buffer.data())) << "hunk " << i;
+	}
+}
+
+TEST_F(ChdFileReaderTest, InterleavedStreams)
+{
+	// Two sequential streams and a strided one taking turns, like a game streaming audio and video while loading.
+	// Each stays in its own quarter/half of the image, so one can't be served by data read for another.
+	std::vector<u8> buffer(TEST_HUNK_SIZE);
+	u32 streams[3] = {0, TEST_HUNK_COUNT / 4, TEST_HUNK_COUNT / 2};
+	u64 strided_prefetch_hits = 0;
+	for (u32 i = 0; i < TEST_HUNK_COUNT / 4; i++)
+	{
+		ASSERT_TRUE(ReadHunk(streams[0]++, buffer.data()));
+		ASSERT_TRUE(ReadHunk(streams[1]++, buffer.data()));
+
+		// Give the prefetcher time to catch up, so whether it keeps up doesn't depend on how busy the machine is.
+		m_reader.WaitUntilIdle();
+		const u64 prefetch_hits = m_reader.GetReadStats().prefetchHits;
+		ASSERT_TRUE(ReadHunk(streams[2], buffer.data()));
+		strided_prefetch_hits += m_reader.GetReadStats().prefetchHits - prefetch_hits;
+		streams[2] += 2;
+	}
+
+	const ThreadedFileReader::ReadStats stats = m_reader.GetReadStats();
+	EXPECT_EQ(stats.requests, (TEST_HUNK_COUNT / 4) * 3);
+	EXPECT_EQ(stats.hits + stats.misses, stats.requests);
+
+	// Only the first few strided reads, before the stream is recognised, should have to wait for a decode.
+	EXPECT_GT(strided_prefetch_hits, 0u);
+	EXPECT_GE(strided_prefetch_hits, (TEST_HUNK_COUNT / 4) - 8);
+}
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "pcsx2/CDVD/ChdFileReader.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include "libchdr/chd.h"
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+static constexpr u32 TEST_HUNK_SIZE = 2048 * 8;
+static constexpr u32 TEST_HUNK_COUNT = 2048;
+
+inline void PutBE(u8* dst, u64 value, u32 bytes)
+{
+	for (u32 i = 0; i < bytes; i++)
+		dst[i] = static_cast<u8>(value >> ((bytes - 1 - i) * 8));
+}
+
+/// Fills the image with something that compresses like game data, rather than zeros.
+inline std::vector<u8> GenerateImage()
+{
+	std::vector<u8> data(static_cast<size_t>(TEST_HUNK_SIZE) * TEST_HUNK_COUNT);
+	std::mt19937 rng(12345);
+	for (size_t i = 0; i < data.size(); i += 4)
+	{
+		const u32 value = rng();
+		std::memcpy(&data[i], &value, sizeof(value));
+		data[i] &= 0x1f;
+		data[i + 1] &= 0x1f;
+	}
+	return data;
+}
+
+/// Writes a V4 CHD with zlib compressed hunks, which is the simplest format libchdr reads that still needs decompression.
+inline bool WriteCHD(const std::string& path, const std::vector<u8>& data)
+{
+	std::vector<std::vector<u8>> hunks(TEST_HUNK_COUNT);
+	for (u32 i = 0; i < TEST_HUNK_COUNT; i++)
+	{
+		z_stream zs = {};
+		if (deflateInit2(&zs, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			return false;
+
+		hunks[i].resize(deflateBound(&zs, TEST_HUNK_SIZE));
+		zs.next_in = const_cast<Bytef*>(&data[static_cast<size_t>(i) * TEST_HUNK_SIZE]);
+		zs.avail_in = TEST_HUNK_SIZE;
+		zs.next_out = hunks[i].data();
+		zs.avail_out = static_cast<uInt>(hunks[i].size());
+		const int res = deflate(&zs, Z_FINISH);
+		hunks[i].resize(zs.total_out);
+		deflateEnd(&zs);
+		if (res != Z_STREAM_END || hunks[i].size() >= TEST_HUNK_SIZE)
+			return false;
+	}
+
+	std::vector<u8> header(CHD_V4_HEADER_SIZE);
+	std::memcpy(&header[0], "MComprHD", 8);
+	PutBE(&header[8], CHD_V4_HEADER_SIZE, 4);
+	PutBE(&header[12], 4, 4);
+	PutBE(&header[20], CHDCOMPRESSION_ZLIB, 4);
+	PutBE(&header[24], TEST_HUNK_COUNT, 4);
+	PutBE(&header[28], data.size(), 8);
+	PutBE(&header[44], TEST_HUNK_SIZE, 4);
+
+	static constexpr u32 MAP_ENTRY_SIZE = 16;
+	std::vector<u8> map((TEST_HUNK_COUNT + 1) * MAP_ENTRY_SIZE);
+	u64 offset = CHD_V4_HEADER_SIZE + map.size();
+	for (u32 i = 0; i < TEST_HUNK_COUNT; i++)
+	{
+		u8* entry = &map[i * MAP_ENTRY_SIZE];
+		PutBE(&entry[0], offset, 8);
+		PutBE(&entry[12], hunks[i].size() & 0xffff, 2);
+		entry[14] = static_cast<u8>(hunks[i].size() >> 16);
+		entry[15] = 0x10 | 1; // no CRC, compressed
+		offset += hunks[i].size();
+	}
+	std::memcpy(&map[TEST_HUNK_COUNT * MAP_ENTRY_SIZE], "EndOfListCookie", MAP_ENTRY_SIZE);
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "wb");
+	if (!fp || std::fwrite(header.data(), header.size(), 1, fp.get()) != 1 ||
+		std::fwrite(map.data(), map.size(), 1, fp.get()) != 1)
+	{
+		return false;
+	}
+
+	for (const std::vector<u8>& hunk : hunks)
+	{
+		if (std::fwrite(hunk.data(), hunk.size(), 1, fp.get()) != 1)
+			return false;
+	}
+
+	return true;
+}
+
+class ChdFileReaderTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		s_path = Path::Combine(std::filesystem::temp_directory_path().string(), "pcsx2_chd_reader_test.chd");
+		s_data = GenerateImage();
+		s_written = WriteCHD(s_path, s_data);
+	}
+
+	static void TearDownTestSuite()
+	{
+		FileSystem::DeleteFilePath(s_path.c_str());
+		s_data = {};
+	}
+
+	void SetUp() override
+	{
+		ASSERT_TRUE(s_written);
+		ASSERT_TRUE(m_reader.Open(s_path, nullptr));
+		m_reader.SetBlockSize(TEST_HUNK_SIZE);
+	}
+
+	void TearDown() override { m_reader.Close(); }
+
+	bool ReadHunk(u32 hunk, u8* dst)
+	{
+		return m_reader.ReadSync(dst, hunk, 1) == static_cast<int>(TEST_HUNK_SIZE) &&
+			   std::memcmp(dst, &s_data[static_cast<size_t>(hunk) * TEST_HUNK_SIZE], TEST_HUNK_SIZE) == 0;
+	}
+
+	ChdFileReader m_reader;
+
+	static inline std::string s_path;
+	static inline std::vector<u8> s_data;
+	static inline bool s_written = false;
+};
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "hdd_io_tests.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
+
+// A synthetic guest workload of random sized reads like an HDD install streaming assets, comparing the old seek and
+// read through the image's FILE with the parallel reader.
+TEST_F(HddIOTest, RandomReads)
+{
+	static constexpr u32 NUM_READS = 2000;
+
+	std::vector<std::pair<u64, u32>> reads(NUM_READS);
+	std::mt19937 rng(8765);
+	for (auto& [sector, sectors] : reads)
+	{
+		sectors = (rng() % 4 == 0) ? 256 : (rng() % 32 + 1) * 8;
+		sector = rng() % (IMAGE_SECTORS - sectors);
+	}
+
+	std::vector<u8> buffer(256 * SECTOR_SIZE);
+	u64 total_bytes = 0;
+	for (const auto& [sector, sectors] : reads)
+		total_bytes += static_cast<u64>(sectors) * SECTOR_SIZE;
+
+	FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(s_path.c_str(), "rb");
+	ASSERT_TRUE(fp);
+	u32 file_ok = 0;
+	Common::Timer timer;
+	for (const auto& [sector, sectors] : reads)
+	{
+		file_ok += FileSystem::FSeek64(fp.get(), sector * SECTOR_SIZE, SEEK_SET) == 0 &&
+				   std::fread(buffer.data(), SECTOR_SIZE, sectors, fp.get()) == sectors;
+	}
+	const double file_time = timer.GetTimeSeconds();
+
+	HddIOEngine engine;
+	ASSERT_TRUE(engine.Open(s_path));
+	u32 engine_ok = 0;
+	timer.Reset();
+	for (const auto& [sector, sectors] : reads)
+		engine_ok += engine.Read(buffer.data(), sector * SECTOR_SIZE, static_cast<u64>(sectors) * SECTOR_SIZE);
+	const double engine_time = timer.GetTimeSeconds();
+
+	EXPECT_EQ(file_ok, NUM_READS);
+	EXPECT_EQ(engine_ok, NUM_READS);
+
+	const HddIOEngine::Stats& stats = engine.GetStats();
+	fmt::print("{} reads ({} MiB): FILE {:.0f} IOPS ({:.1f} us avg), engine {:.0f} IOPS ({:.1f} us avg, {} us worst, "
+			   "{} of {} chunks on workers)\n",
+		NUM_READS, total_bytes / (1024 * 1024), NUM_READS / file_time, file_time * 1e6 / NUM_READS,
+		NUM_READS / engine_time, static_cast<double>(stats.totalLatencyUs) / stats.requests, stats.maxLatencyUs,
+		stats.workerChunks, stats.chunks);
+
+	// Writes of the same workload, to see how many image writes the cache saves.
+	HddWriteCache cache;
+	u64 write_sector = 0;
+	for (const auto& [sector, sectors] : reads)
+	{
+		// Games tend to write sequentially, with the odd jump elsewhere.
+		if (rng() % 16 == 0)
+			write_sector = sector;
+		cache.Write(write_sector, buffer.data(), sectors);
+		write_sector += sectors;
+	}
+	fmt::print("{} writes coalesced into {} extents\n", cache.GetWriteCount(), cache.GetExtentCount());
+}
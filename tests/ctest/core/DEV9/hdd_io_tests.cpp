@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "hdd_io_tests.h"
+
+TEST_F(HddIOTest, ReadsMatchImage)
+{
+	HddIOEngine engine;
+	ASSERT_TRUE(engine.Open(s_path));
+
+	std::mt19937 rng(4321);
+	std::vector<u8> buffer;
+	for (u32 i = 0; i < 200; i++)
+	{
+		// Up to the largest LBA28 transfer, so requests are split across the workers.
+		const u32 sectors = rng() % 256 + 1;
+		const u64 sector = rng() % (IMAGE_SECTORS - sectors);
+		buffer.assign(static_cast<size_t>(sectors) * SECTOR_SIZE, 0);
+		ASSERT_TRUE(engine.Read(buffer.data(), sector * SECTOR_SIZE, buffer.size()));
+		ASSERT_EQ(std::memcmp(buffer.data(), &s_data[sector * SECTOR_SIZE], buffer.size()), 0) << "read " << i;
+	}
+
+	// Past the end of the image.
+	buffer.resize(SECTOR_SIZE * 2);
+	EXPECT_FALSE(engine.Read(buffer.data(), static_cast<u64>(IMAGE_SECTORS - 1) * SECTOR_SIZE, buffer.size()));
+	EXPECT_EQ(engine.GetStats().requests, 201u);
+
+	// Most of those reads were bigger than a chunk, so the workers must have had some of them.
+	EXPECT_GT(engine.GetStats().workerChunks, 0u);
+	EXPECT_GT(engine.GetStats().chunks, engine.GetStats().requests);
+}
+
+TEST(HddWriteCache, MatchesFlatImage)
+{
+	static constexpr u32 SECTORS = 4096;
+	std::vector<u8> expected(SECTORS * SECTOR_SIZE, 0);
+	std::vector<u8> flushed(SECTORS * SECTOR_SIZE, 0);
+	HddWriteCache cache;
+
+	std::mt19937 rng(5678);
+	std::vector<u8> data;
+	for (u32 i = 0; i < 5000; i++)
+	{
+		// Mostly small writes near each other, so they overlap and touch.
+		const u32 sectors = rng() % 16 + 1;
+		const u32 sector = (rng() % 4 == 0) ? rng() % (SECTORS - sectors) : (i * 7) % (SECTORS - sectors);
+		data.resize(sectors * SECTOR_SIZE);
+		for (u8& b : data)
+			b = static_cast<u8>(rng());
+
+		cache.Write(sector, data.data(), sectors);
+		std::memcpy(&expected[sector * SECTOR_SIZE], data.data(), data.size());
+
+		// Occasionally write some out, like the drive going idle.
+		if (rng() % 64 == 0)
+		{
+			std::vector<HddWriteCache::Extent> extents;
+			cache.Take(rng() % (64 * 1024), &extents);
+			for (const HddWriteCache::Extent& extent : extents)
+				std::memcpy(&flushed[extent.sector * SECTOR_SIZE], extent.data.data(), extent.data.size());
+		}
+
+		// Reads see the image with the cache on top.
+		const u32 read_sectors = rng() % 64 + 1;
+		const u32 read_sector = rng() % (SECTORS - read_sectors);
+		std::vector<u8> read(flushed.begin() + read_sector * SECTOR_SIZE,
+			flushed.begin() + (read_sector + read_sectors) * SECTOR_SIZE);
+		cache.Overlay(read_sector, read.data(), read_sectors);
+		ASSERT_EQ(std::memcmp(read.data(), &expected[read_sector * SECTOR_SIZE], read.size()), 0) << "write " << i;
+	}
+
+	std::vector<HddWriteCache::Extent> extents;
+	cache.Take(UINT64_MAX, &extents);
+	EXPECT_TRUE(cache.IsEmpty());
+	EXPECT_EQ(cache.GetDirtyBytes(), 0u);
+
+	u64 last_end = 0;
+	for (const HddWriteCache::Extent& extent : extents)
+	{
+		// Extents never overlap or touch, they would have been merged.
+		EXPECT_TRUE(last_end == 0 || extent.sector > last_end);
+		last_end = extent.sector + extent.data.size() / SECTOR_SIZE;
+		std::memcpy(&flushed[extent.sector * SECTOR_SIZE], extent.data.data(), extent.data.size());
+	}
+	EXPECT_EQ(flushed, expected);
+}
+
+TEST(HddWriteCache, CoalescesSequentialWrites)
+{
+	HddWriteCache cache;
+	std::vector<u8> data(128 * SECTOR_SIZE, 0x55);
+	for (u32 i = 0; i < 64; i++)
+		cache.Write(1000 + i * 128, data.data(), 128);
+	// And one out of the way.
+	cache.Write(0, data.data(), 1);
+
+	EXPECT_EQ(cache.GetExtentCount(), 2u);
+	EXPECT_EQ(cache.GetDirtyBytes(), (64 * 128 + 1) * SECTOR_SIZE);
+
+	// Lowest first, and at least the requested amount.
+	std::vector<HddWriteCache::Extent> extents;
+	cache.Take(1, &extents);
+	ASSERT_EQ(extents.size(), 1u);
+	EXPECT_EQ(extents[0].sector, 0u);
+	cache.Take(1, &extents);
+	ASSERT_EQ(extents.size(), 2u);
+	EXPECT_EQ(extents[1].sector, 1000u);
+	EXPECT_EQ(extents[1].data.size(), 64 * 128 * SECTOR_SIZE);
+}
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "pcsx2/DEV9/ATA/HddIOEngine.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+static constexpr u32 SECTOR_SIZE = HddWriteCache::SECTOR_SIZE;
+
+class HddIOTest : public ::testing::Test
+{
+protected:
+	static constexpr u32 IMAGE_SECTORS = 64 * 1024 * 1024 / SECTOR_SIZE;
+
+	static void SetUpTestSuite()
+	{
+		s_path = Path::Combine(std::filesystem::temp_directory_path().string(), "pcsx2_hdd_io_test.raw");
+		s_data.resize(static_cast<size_t>(IMAGE_SECTORS) * SECTOR_SIZE);
+		std::mt19937 rng(1234);
+		for (size_t i = 0; i < s_data.size(); i += 4)
+		{
+			const u32 value = rng();
+			std::memcpy(&s_data[i], &value, sizeof(value));
+		}
+		s_written = FileSystem::WriteBinaryFile(s_path.c_str(), s_data.data(), s_data.size());
+	}
+
+	static void TearDownTestSuite()
+	{
+		FileSystem::DeleteFilePath(s_path.c_str());
+		s_data = {};
+	}
+
+	void SetUp() override { ASSERT_TRUE(s_written); }
+
+	static inline std::string s_path;
+	static inline std::vector<u8> s_data;
+	static inline bool s_written = false;
+};
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "socket_poller_tests.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+
+using namespace Sessions;
+
+// Echoes packets between two sockets while lots of others sit idle, against checking every socket each time like
+// the sessions used to.
+TEST_F(SocketPollerTest, Echo)
+{
+	static constexpr u32 NUM_SOCKETS = 500;
+	static constexpr u32 NUM_PACKETS = 5000;
+	static constexpr int PACKET_SIZE = 1024;
+
+	CreateSockets(NUM_SOCKETS);
+	SocketPoller poller;
+	ASSERT_TRUE(poller.IsInitialised());
+	for (u32 i = 0; i < sockets.size(); i++)
+		poller.Add(sockets[i], MakeKey(i));
+
+	std::vector<u8> packet(PACKET_SIZE, 0xAA);
+	std::vector<u8> buffer(PACKET_SIZE);
+
+	// Bounce one packet off the echo socket, polling for readiness each way.
+	const auto echo = [&](auto&& find_ready) {
+		Send(0, 1, packet.data(), PACKET_SIZE);
+		while (!find_ready(1)) {}
+		Recv(1, buffer.data(), PACKET_SIZE);
+		Send(1, 0, buffer.data(), PACKET_SIZE);
+		while (!find_ready(0)) {}
+		return Recv(0, buffer.data(), PACKET_SIZE) == PACKET_SIZE;
+	};
+
+	u32 linear_echoes = 0;
+	Common::Timer timer;
+	for (u32 i = 0; i < NUM_PACKETS; i++)
+	{
+		linear_echoes += echo([this](u32 wanted) {
+			bool found = false;
+			for (u32 s = 0; s < sockets.size(); s++)
+				found |= (IsReadable(s) && s == wanted);
+			return found;
+		});
+	}
+	const double linear_time = timer.GetTimeSeconds();
+
+	u32 poller_echoes = 0;
+	std::vector<ConnectionKey> ready;
+	timer.Reset();
+	for (u32 i = 0; i < NUM_PACKETS; i++)
+	{
+		poller_echoes += echo([&ready, &poller](u32 wanted) {
+			ready.clear();
+			poller.Wait(0, &ready);
+			return std::find(ready.begin(), ready.end(), MakeKey(wanted)) != ready.end();
+		});
+	}
+	const double poller_time = timer.GetTimeSeconds();
+
+	EXPECT_EQ(linear_echoes, NUM_PACKETS);
+	EXPECT_EQ(poller_echoes, NUM_PACKETS);
+	const double mb = static_cast<double>(NUM_PACKETS) * PACKET_SIZE * 2 / (1024.0 * 1024.0);
+	fmt::print("{} sockets, {} echoes: select each {:.1f} us/echo ({:.1f} MB/s), poller {:.1f} us/echo ({:.1f} MB/s)\n",
+		NUM_SOCKETS, NUM_PACKETS, linear_time * 1e6 / NUM_PACKETS, mb / linear_time, poller_time * 1e6 / NUM_PACKETS,
+		mb / poller_time);
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "socket_poller_tests.h"
+
+#include <algorithm>
+
+using namespace Sessions;
+
+TEST_F(SocketPollerTest, ReportsOnlyReadySockets)
+{
+	CreateSockets(64);
+	SocketPoller poller;
+	ASSERT_TRUE(poller.IsInitialised());
+	for (u32 i = 0; i < sockets.size(); i++)
+		poller.Add(sockets[i], MakeKey(i));
+	// Adding again for the same key is ignored.
+	poller.Add(sockets[5], MakeKey(5));
+	EXPECT_EQ(poller.GetCount(), sockets.size());
+
+	std::vector<ConnectionKey> ready;
+	poller.Wait(0, &ready);
+	EXPECT_TRUE(ready.empty());
+
+	const u8 data[4] = {1, 2, 3, 4};
+	Send(0, 5, data, sizeof(data));
+	Send(0, 40, data, sizeof(data));
+
+	// Loopback delivery isn't guaranteed to be instant.
+	for (u32 attempt = 0; attempt < 100 && ready.size() < 2; attempt++)
+	{
+		ready.clear();
+		poller.Wait(10, &ready);
+	}
+	ASSERT_EQ(ready.size(), 2u);
+	EXPECT_TRUE(std::find(ready.begin(), ready.end(), MakeKey(5)) != ready.end());
+	EXPECT_TRUE(std::find(ready.begin(), ready.end(), MakeKey(40)) != ready.end());
+
+	// Stays ready until read.
+	u8 buffer[16];
+	EXPECT_EQ(Recv(5, buffer, sizeof(buffer)), 4);
+	ready.clear();
+	poller.Wait(0, &ready);
+	ASSERT_EQ(ready.size(), 1u);
+	EXPECT_EQ(ready[0], MakeKey(40));
+
+	// Removed sockets aren't reported, even with data pending.
+	poller.Remove(MakeKey(40));
+	EXPECT_EQ(poller.GetCount(), sockets.size() - 1);
+	ready.clear();
+	poller.Wait(0, &ready);
+	EXPECT_TRUE(ready.empty());
+}
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "pcsx2/DEV9/SocketPoller.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+/// Loopback UDP sockets standing in for sessions, the first two are used as an echo pair.
+class SocketPollerTest : public ::testing::Test
+{
+protected:
+	std::vector<Sessions::SessionSocket> sockets;
+	std::vector<sockaddr_in> addresses;
+
+	static void SetUpTestSuite()
+	{
+#ifdef _WIN32
+		WSADATA wsa;
+		WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+	}
+
+	static void TearDownTestSuite()
+	{
+#ifdef _WIN32
+		WSACleanup();
+#endif
+	}
+
+	void TearDown() override
+	{
+		for (Sessions::SessionSocket s : sockets)
+			CloseSocket(s);
+	}
+
+	static void CloseSocket(Sessions::SessionSocket s)
+	{
+#ifdef _WIN32
+		closesocket(s);
+#else
+		close(s);
+#endif
+	}
+
+	void CreateSockets(u32 count)
+	{
+		for (u32 i = 0; i < count; i++)
+		{
+			const Sessions::SessionSocket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+			ASSERT_NE(s, INVALID_SOCKET);
+
+			sockaddr_in addr{};
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			addr.sin_port = 0;
+			ASSERT_EQ(bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+			socklen_t len = sizeof(addr);
+			ASSERT_EQ(getsockname(s, reinterpret_cast<sockaddr*>(&addr), &len), 0);
+
+			sockets.push_back(s);
+			addresses.push_back(addr);
+		}
+	}
+
+	static Sessions::ConnectionKey MakeKey(u32 index)
+	{
+		Sessions::ConnectionKey key;
+		key.protocol = 17;
+		key.ps2Port = static_cast<u16>(index >> 16);
+		key.srvPort = static_cast<u16>(index);
+		return key;
+	}
+
+	void Send(u32 from, u32 to, const u8* data, int size)
+	{
+		sendto(sockets[from], reinterpret_cast<const char*>(data), size, 0,
+			reinterpret_cast<const sockaddr*>(&addresses[to]), sizeof(sockaddr_in));
+	}
+
+	int Recv(u32 index, u8* data, int size)
+	{
+		return recv(sockets[index], reinterpret_cast<char*>(data), size, 0);
+	}
+
+	/// What each session used to do in Recv(), a zero timeout select() on its own socket.
+	bool IsReadable(u32 index)
+	{
+		fd_set set;
+		FD_ZERO(&set);
+		FD_SET(sockets[index], &set);
+		timeval timeout{};
+		return select(static_cast<int>(sockets[index] + 1), &set, nullptr, nullptr, &timeout) > 0;
+	}
+};
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "gif_packed_tests.h"
+
+#include <gtest/gtest.h>
+
+TEST_F(GIFPackedTest, SpecialisedLoopsMatchGeneric)
+{
+	const bool force_even_sprite_position = GSConfig.UserHacks_ForceEvenSpritePosition;
+	for (const bool hack : {false, true})
+	{
+		// The UV layouts have to set the hack's flag before any draw they flush.
+		GSConfig.UserHacks_ForceEvenSpritePosition = hack;
+		renderer->ResetHandlers();
+
+		for (size_t i = 0; i < s_layouts.size(); i++)
+		{
+			for (const bool reg_changes : {false, true})
+			{
+				const std::vector<GSVector4i> stream = MakeStream(s_layouts[i], 16, 30, static_cast<u32>(i), reg_changes);
+
+				renderer->hash = 0;
+				renderer->vertices = 0;
+				renderer->Transfer(stream, false);
+				const u64 whole_hash = renderer->hash;
+				const u64 whole_vertices = renderer->vertices;
+
+				renderer->hash = 0;
+				renderer->vertices = 0;
+				renderer->Transfer(stream, true);
+
+				EXPECT_GT(whole_vertices, 0u) << "layout " << i << " hack " << hack << " reg changes " << reg_changes;
+				EXPECT_EQ(whole_vertices, renderer->vertices) << "layout " << i << " hack " << hack << " reg changes " << reg_changes;
+				EXPECT_EQ(whole_hash, renderer->hash) << "layout " << i << " hack " << hack << " reg changes " << reg_changes;
+			}
+		}
+	}
+
+	GSConfig.UserHacks_ForceEvenSpritePosition = force_even_sprite_position;
+	renderer->ResetHandlers();
+}
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "pcsx2/GS/Renderers/Common/GSRenderer.h"
+#include "pcsx2/GS/Renderers/Null/GSDeviceHeadless.h"
+#include "pcsx2/MemoryTypes.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// Hashes every vertex which gets drawn, and the state the draw sees, so the specialised loops can be compared
+/// with the generic path.
+class GIFTestRenderer final : public GSRenderer
+{
+public:
+	u64 hash = 0;
+	u64 vertices = 0;
+
+	void Transfer(const std::vector<GSVector4i>& stream, bool split)
+	{
+		// Feeding one qword at a time always goes through the per-register handlers.
+		if (split)
+		{
+			for (const GSVector4i& qw : stream)
+				GSState::Transfer<3>(reinterpret_cast<const u8*>(&qw), 1);
+		}
+		else
+		{
+			GSState::Transfer<3>(reinterpret_cast<const u8*>(stream.data()), static_cast<u32>(stream.size()));
+		}
+		Flush(CONTEXTCHANGE);
+	}
+
+protected:
+	void Draw() override
+	{
+		for (u32 i = 0; i < m_index.tail; i++)
+		{
+			const u8* v = reinterpret_cast<const u8*>(&m_vertex.buff[m_index.buff[i]]);
+			for (size_t j = 0; j < sizeof(GSVertex); j++)
+				hash = (hash ^ v[j]) * 0x100000001b3ULL;
+		}
+		hash = (hash ^ static_cast<u64>(m_isPackedUV_HackFlag)) * 0x100000001b3ULL;
+		vertices += m_index.tail;
+	}
+
+	GSTexture* GetOutput(int i, float& scale, int& y_offset) override { return nullptr; }
+};
+
+class GIFPackedTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		g_gs_device = std::make_unique<GSDeviceHeadless>();
+		renderer = std::make_unique<GIFTestRenderer>();
+		renderer->SetRegsMem(regs);
+	}
+
+	void TearDown() override
+	{
+		renderer.reset();
+		g_gs_device.reset();
+	}
+
+	alignas(16) u8 regs[Ps2MemSize::GSregs] = {};
+	std::unique_ptr<GIFTestRenderer> renderer;
+};
+
+inline GSVector4i MakeTag(u32 nloop, u32 prim, u32 nreg, u64 regs, bool pre = true)
+{
+	const u64 lo = nloop | (1ULL << 15) | (static_cast<u64>(pre) << 46) | (static_cast<u64>(prim) << 47) |
+				   (static_cast<u64>(nreg & 0xf) << 60);
+	return GSVector4i(static_cast<int>(lo), static_cast<int>(lo >> 32), static_cast<int>(regs), static_cast<int>(regs >> 32));
+}
+
+inline GSVector4i MakeReg(u32 reg, std::mt19937& rng)
+{
+	// Small coordinates, so everything is inside the scissor and gets drawn.
+	const u32 x = (rng() % 640) << 4;
+	const u32 y = (rng() % 448) << 4;
+	switch (reg)
+	{
+		case GIF_REG_RGBA:
+			return GSVector4i(rng() & 0xff, rng() & 0xff, rng() & 0xff, rng() & 0x80);
+		case GIF_REG_STQ:
+		{
+			const float stq[3] = {static_cast<float>(rng() % 256) / 256.0f, static_cast<float>(rng() % 256) / 256.0f,
+				static_cast<float>(rng() % 4 + 1)};
+			u32 v[4] = {};
+			std::memcpy(v, stq, sizeof(stq));
+			return GSVector4i::load<false>(v);
+		}
+		case GIF_REG_UV:
+			return GSVector4i(rng() & 0x3fff, rng() & 0x3fff, 0, 0);
+		case GIF_REG_XYZF2:
+			return GSVector4i(x, y, (rng() & 0xffffff) << 4, (rng() & 0xff) << 4);
+		case GIF_REG_XYZ2:
+			return GSVector4i(x, y, rng(), 0);
+		default:
+			return GSVector4i::zero();
+	}
+}
+
+/// A scissor covering the whole screen, then packets of triangles using the given registers per vertex.
+/// With reg_changes, an A+D UV write and a TEST change go between packets. The UV write clears the
+/// ForceEvenSpritePosition flag, and the TEST change makes the next packet flush the previous one's draw.
+inline std::vector<GSVector4i> MakeStream(const std::vector<u32>& layout, u32 packets, u32 loops, u32 seed,
+	bool reg_changes = false)
+{
+	std::mt19937 rng(seed);
+	std::vector<GSVector4i> stream;
+	stream.push_back(MakeTag(1, 0, 1, GIF_REG_A_D));
+	stream.push_back(GSVector4i(639 << 16, 447 << 16, GIF_A_D_REG_SCISSOR_1, 0));
+
+	u64 regs = 0;
+	for (size_t i = 0; i < layout.size(); i++)
+		regs |= static_cast<u64>(layout[i]) << (i * 4);
+
+	const u32 prim = GS_TRIANGLELIST | (std::find(layout.begin(), layout.end(), GIF_REG_UV) != layout.end() ? (1u << 8) : 0u);
+	for (u32 p = 0; p < packets; p++)
+	{
+		if (reg_changes)
+		{
+			stream.push_back(MakeTag(2, 0, 1, GIF_REG_A_D, false));
+			stream.push_back(GSVector4i(0, 0, GIF_A_D_REG_UV, 0));
+			stream.push_back(GSVector4i((p & 1) ? 0x30000 : 0, 0, GIF_A_D_REG_TEST_1, 0));
+		}
+		stream.push_back(MakeTag(loops, prim, static_cast<u32>(layout.size()), regs));
+		for (u32 l = 0; l < loops; l++)
+		{
+			for (u32 reg : layout)
+				stream.push_back(MakeReg(reg, rng));
+		}
+	}
+	return stream;
+}
+
+/// Every layout with a specialised loop, see GIFPath::SetTag().
+inline const std::vector<std::vector<u32>> s_layouts = {
+	{GIF_REG_STQ, GIF_REG_RGBA, GIF_REG_XYZF2},
+	{GIF_REG_STQ, GIF_REG_RGBA, GIF_REG_XYZ2},
+	{GIF_REG_UV, GIF_REG_RGBA, GIF_REG_XYZF2},
+	{GIF_REG_UV, GIF_REG_RGBA, GIF_REG_XYZ2},
+	{GIF_REG_RGBA, GIF_REG_XYZF2},
+	{GIF_REG_RGBA, GIF_REG_XYZ2},
+	{GIF_REG_RGBA, GIF_REG_XYZF2, GIF_REG_RGBA, GIF_REG_XYZF2},
+	{GIF_REG_RGBA, GIF_REG_XYZ2, GIF_REG_RGBA, GIF_REG_XYZ2},
+};
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "page_index_tests.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
+#include <gtest/gtest.h>
+
+// Against walking every surface, like the texture cache lists used to.
+TEST(GSPageIndex, Lookup)
+{
+	static constexpr u32 NUM_SURFACES = 2000;
+	static constexpr u32 NUM_QUERIES = 200000;
+
+	std::vector<TestSurface> surfaces = GenerateSurfaces(NUM_SURFACES, 5678);
+	GSPageIndex<TestSurface> index;
+	for (TestSurface& s : surfaces)
+		index.Update(&s, s.range, s.start_bp, s.end_bp);
+
+	std::vector<std::pair<u32, u32>> queries(NUM_QUERIES);
+	std::mt19937 rng(8765);
+	for (auto& [bp, end_bp] : queries)
+	{
+		bp = rng() % MAX_BLOCKS;
+		end_bp = bp + rng() % (BLOCKS_PER_PAGE * 4);
+	}
+
+	u32 linear_hits = 0;
+	Common::Timer timer;
+	for (const auto& [bp, end_bp] : queries)
+	{
+		for (const TestSurface& s : surfaces)
+			linear_hits += s.Overlaps(bp, end_bp);
+	}
+	const double linear_time = timer.GetTimeSeconds();
+
+	u32 index_hits = 0;
+	timer.Reset();
+	for (const auto& [bp, end_bp] : queries)
+		index.ForEach(bp, end_bp, [&index_hits, bp, end_bp](TestSurface* s) { index_hits += s->Overlaps(bp, end_bp); });
+	const double index_time = timer.GetTimeSeconds();
+
+	EXPECT_EQ(index_hits, linear_hits);
+	fmt::print("{} surfaces, {} queries: linear {:.1f} ms, page index {:.1f} ms ({:.1f}x)\n", NUM_SURFACES, NUM_QUERIES,
+		linear_time * 1000.0, index_time * 1000.0, linear_time / index_time);
+}
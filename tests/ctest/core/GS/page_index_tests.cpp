@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "page_index_tests.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+TEST(GSPageIndex, MatchesLinearSearch)
+{
+	std::vector<TestSurface> surfaces = GenerateSurfaces(1000, 1234);
+	GSPageIndex<TestSurface> index;
+	for (TestSurface& s : surfaces)
+		index.Update(&s, s.range, s.start_bp, s.end_bp);
+	ASSERT_EQ(index.GetCount(), surfaces.size());
+
+	std::mt19937 rng(4321);
+	for (u32 query = 0; query < 2000; query++)
+	{
+		// Move and remove a few, so stale registrations would show up.
+		TestSurface& moved = surfaces[rng() % surfaces.size()];
+		if (rng() % 4 == 0)
+		{
+			index.Remove(&moved, moved.range);
+			moved.end_bp = moved.start_bp - 1;
+		}
+		else
+		{
+			moved.end_bp = moved.start_bp + (rng() % 64) * BLOCKS_PER_PAGE + (rng() % BLOCKS_PER_PAGE);
+			index.Update(&moved, moved.range, moved.start_bp, moved.end_bp);
+		}
+
+		const u32 bp = rng() % MAX_BLOCKS;
+		const u32 end_bp = bp + rng() % (BLOCKS_PER_PAGE * 16);
+
+		std::vector<const TestSurface*> expected;
+		for (const TestSurface& s : surfaces)
+		{
+			if (!s.range.Empty() && s.Overlaps(bp, end_bp))
+				expected.push_back(&s);
+		}
+
+		std::vector<const TestSurface*> found;
+		index.ForEach(bp, end_bp, [&found, bp, end_bp](TestSurface* s) {
+			if (s->Overlaps(bp, end_bp))
+				found.push_back(s);
+		});
+
+		std::sort(expected.begin(), expected.end());
+		std::sort(found.begin(), found.end());
+		ASSERT_EQ(found, expected) << "query " << query;
+		if (!expected.empty())
+			ASSERT_FALSE(index.Empty(bp, end_bp));
+	}
+}
+
+TEST(GSPageIndex, ReportsEachItemOnce)
+{
+	TestSurface big = {0, MAX_BLOCKS + 10 * BLOCKS_PER_PAGE};
+	GSPageIndex<TestSurface> index;
+	index.Update(&big, big.range, big.start_bp, big.end_bp);
+
+	u32 calls = 0;
+	index.ForEach(5 * BLOCKS_PER_PAGE + 3, MAX_BLOCKS * 2, [&calls](TestSurface*) { calls++; });
+	EXPECT_EQ(calls, 1u);
+
+	index.Remove(&big, big.range);
+	EXPECT_TRUE(big.range.Empty());
+	EXPECT_TRUE(index.Empty(0, MAX_BLOCKS * 2 - 1));
+}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "pcsx2/GS/Renderers/Common/GSPageIndex.h"
+
+#include <random>
+#include <vector>
+
+/// Stand-in for a texture cache target, with the range in unwrapped blocks.
+struct TestSurface
+{
+	u32 start_bp;
+	u32 end_bp;
+	GSPageIndex<TestSurface>::Range range;
+
+	bool Overlaps(u32 bp, u32 end) const { return (start_bp <= end && end_bp >= bp); }
+};
+
+/// Roughly what games keep around: frame sized targets plus lots of small page sized ones.
+inline std::vector<TestSurface> GenerateSurfaces(u32 count, u32 seed)
+{
+	std::vector<TestSurface> surfaces(count);
+	std::mt19937 rng(seed);
+	for (TestSurface& s : surfaces)
+	{
+		s.start_bp = rng() % MAX_BLOCKS;
+		const u32 pages = (rng() % 8 == 0) ? (rng() % 80 + 1) : (rng() % 4 + 1);
+		s.end_bp = s.start_bp + pages * BLOCKS_PER_PAGE - 1;
+	}
+	return surfaces;
+}
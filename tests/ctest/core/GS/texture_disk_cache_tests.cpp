@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/GS/Renderers/HW/GSTextureDiskCache.h"
+#include "pcsx2/GS/Renderers/Null/GSTextureHeadless.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	class TextureDiskCacheTest : public ::testing::Test
+	{
+	protected:
+		static constexpr int WIDTH = 64;
+		static constexpr int HEIGHT = 64;
+		static constexpr u32 ROW_SIZE = WIDTH * 4;
+
+		void SetUp() override
+		{
+			m_old_cache_folder = EmuFolders::Cache;
+			m_old_enabled = GSConfig.TextureDiskCache;
+			m_old_size = GSConfig.TextureDiskCacheSize;
+
+			EmuFolders::Cache = Path::Combine(std::filesystem::temp_directory_path().string(), "pcsx2_texture_disk_cache_test");
+			FileSystem::RecursiveDeleteDirectory(EmuFolders::Cache.c_str());
+			ASSERT_TRUE(FileSystem::EnsureDirectoryExists(EmuFolders::Cache.c_str(), false));
+
+			GSConfig.TextureDiskCache = true;
+			GSConfig.TextureDiskCacheSize = 1;
+		}
+
+		void TearDown() override
+		{
+			GSTextureDiskCache::Shutdown();
+			FileSystem::RecursiveDeleteDirectory(EmuFolders::Cache.c_str());
+
+			EmuFolders::Cache = std::move(m_old_cache_folder);
+			GSConfig.TextureDiskCache = m_old_enabled;
+			GSConfig.TextureDiskCacheSize = m_old_size;
+		}
+
+		static GSTextureCache::HashCacheKey MakeKey(u32 id)
+		{
+			GSTextureCache::HashCacheKey key;
+			key.TEX0Hash = 0x9e3779b97f4a7c15ULL * (id + 1);
+			key.TEX0.U64 = id;
+			key.region_width = WIDTH;
+			key.region_height = HEIGHT;
+			return key;
+		}
+
+		static std::vector<u8> MakeTexels(u32 id)
+		{
+			std::vector<u8> texels(ROW_SIZE * HEIGHT);
+			for (size_t i = 0; i < texels.size(); i++)
+				texels[i] = static_cast<u8>(i * 7 + id * 13);
+			return texels;
+		}
+
+		static std::unique_ptr<GSTextureHeadless> MakeTexture()
+		{
+			return std::make_unique<GSTextureHeadless>(GSTexture::Type::Texture, WIDTH, HEIGHT, 1, GSTexture::Format::Color);
+		}
+
+		static void Insert(u32 id)
+		{
+			const std::vector<u8> texels = MakeTexels(id);
+			std::vector<u8> data;
+			GSTextureDiskCache::AppendLevel(data, WIDTH, HEIGHT, texels.data(), ROW_SIZE, ROW_SIZE);
+
+			const std::unique_ptr<GSTextureHeadless> tex = MakeTexture();
+			GSTextureDiskCache::InsertTexture(MakeKey(id), tex.get(), 1, std::pair<u8, u8>(0x10, 0x80), data);
+		}
+
+		static bool Load(u32 id, bool check_texels)
+		{
+			const std::unique_ptr<GSTextureHeadless> tex = MakeTexture();
+			std::pair<u8, u8> alpha_minmax = {};
+			if (!GSTextureDiskCache::LoadTexture(MakeKey(id), tex.get(), 1, &alpha_minmax))
+				return false;
+
+			EXPECT_EQ(alpha_minmax.first, 0x10);
+			EXPECT_EQ(alpha_minmax.second, 0x80);
+			if (check_texels)
+			{
+				const std::vector<u8> texels = MakeTexels(id);
+				for (int y = 0; y < HEIGHT; y++)
+				{
+					EXPECT_EQ(std::memcmp(tex->GetTexelPointer(0, y), &texels[y * ROW_SIZE], ROW_SIZE), 0) << "row " << y;
+				}
+			}
+
+			return true;
+		}
+
+		static s64 GetBlobSize()
+		{
+			return FileSystem::GetPathFileSize(Path::Combine(EmuFolders::Cache, "gs_texture_cache.bin").c_str());
+		}
+
+		std::string m_old_cache_folder;
+		bool m_old_enabled = false;
+		u32 m_old_size = 0;
+	};
+} // namespace
+
+TEST_F(TextureDiskCacheTest, RoundTrip)
+{
+	GSTextureDiskCache::Initialize();
+	ASSERT_TRUE(GSTextureDiskCache::IsOpen());
+	EXPECT_FALSE(Load(1, false));
+	Insert(1);
+	Insert(2);
+
+	// Written this session, so past the end of the mapping made at open.
+	EXPECT_TRUE(Load(2, true));
+	GSTextureDiskCache::Shutdown();
+
+	GSTextureDiskCache::Initialize();
+	ASSERT_TRUE(GSTextureDiskCache::IsOpen());
+	EXPECT_TRUE(Load(1, true));
+	EXPECT_TRUE(Load(2, true));
+	EXPECT_FALSE(Load(3, false));
+}
+
+TEST_F(TextureDiskCacheTest, StaysWithinLimit)
+{
+	// 1MB limit, so about 60 textures fit.
+	static constexpr u32 COUNT = 200;
+
+	GSTextureDiskCache::Initialize();
+	ASSERT_TRUE(GSTextureDiskCache::IsOpen());
+	for (u32 i = 0; i < COUNT; i++)
+	{
+		Insert(i);
+
+		// Keep the first one in use, so it survives compaction.
+		EXPECT_TRUE(Load(0, false)) << "after inserting " << i;
+		ASSERT_LE(GetBlobSize(), static_cast<s64>(_1mb)) << "after inserting " << i;
+	}
+
+	// Once it's full, nothing else goes in until it's compacted.
+	EXPECT_TRUE(Load(1, true));
+	EXPECT_FALSE(Load(COUNT - 1, false));
+	GSTextureDiskCache::Shutdown();
+
+	// Opening it again makes room by dropping the least recently used textures.
+	GSTextureDiskCache::Initialize();
+	ASSERT_TRUE(GSTextureDiskCache::IsOpen());
+	EXPECT_LE(GetBlobSize(), static_cast<s64>(_1mb * 3 / 4));
+	EXPECT_TRUE(Load(0, true));
+	Insert(COUNT);
+	EXPECT_TRUE(Load(COUNT, true));
+	GSTextureDiskCache::Shutdown();
+
+	GSTextureDiskCache::Initialize();
+	EXPECT_TRUE(Load(0, true));
+	EXPECT_TRUE(Load(COUNT, true));
+}